@@ -5,77 +5,280 @@
  * 
  * Written by: Athul Subash Marottikkal - January 2023
  * 
- * Purpose: Generates 2 random die numbers for x trails which are added together and displays the resulting distribution on the terminal.
+ * Purpose: Generates N random die numbers with M faces each for x trails which are added together and displays the resulting
+ * 			distribution on the terminal. The default is 2 dice with 6 faces. The sums are checked against their exact
+ * 			distribution, computed by convolution, with a chi-square test. The dice are rolled one by one, many dice
+ * 			from each 64-bit word, unless drawing the sum directly from its exact distribution with an alias table is
+ * 			cheaper: a lookup takes the same time for any number of dice, about as long as rolling 2 or 3 dice while the
+ * 			table fits in the cache and about as long as rolling 16 once it does not. The sums drawn with the alias table
+ * 			can only be as right as the exact distribution they are drawn from, so a sample of up to CHECK_ROLLS sums of
+ * 			dice rolled one by one is then checked against the exact distribution too.
  * 
  * Usage: 
- * 	./Dice_Distribution_Generator
- * 	The program will prompt the user to enter the number of random numbers to be generated (x). The program will 
- * 	then generate and plot the distribution of the random die numbers.
+ * 	./Dice_Distribution_Generator [-n rolls] [-D NdM] [-b bins] [-r low,high] [-o output] [-q | -g] [seed] [threads]
+ * 	-n - Number of rolls (x). If it is not given, the program will prompt the user to enter it.
+ * 	-D - Number of dice (N) and number of faces (M), as in 10d20. Default = 2d6.
+ * 	-b, -r - Number of bins and their range. Default = every possible sum, from N to N * M, with each bin holding the same
+ * 	whole number of sums and at most 100 bins.
+ * 	-o - File the histogram is written to. Default = p2_data.txt.
+ * 	-q - Do not plot the histogram.
+ * 	-g - Plot the histogram with gnuplot instead of drawing it on the terminal. On a terminal, the drawing is updated
+ * 	     every half second while the numbers are generated.
+ * 	The seed is optional and defaults to the current time. The same seed always gives the same rolls, whatever the 
+ * 	number of threads. The number of threads is optional and defaults to the number of CPUs.
+ * 	The program will then generate and plot the distribution of the random die numbers. Sums outside the range are
+ * 	counted as underflow or overflow.
+ * 	(./Dice_Distribution_Generator -n 1000000 -o dice.txt -q 42 4)
+ * 	(./Dice_Distribution_Generator -n 10000000000 -D 10d20 -q 42 8)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
- * 	The program uses the rand() function from the stdlib.h library to generate random numbers, and 
- * 	also uses the time.h library to seed the random number generator with the current time.
+ * 	The program uses the batch samplers fill_dice_sums() and fill_alias(), and the exact distribution from dice_pmf(),
+ * 	from sampling.h to generate random numbers, and parallel_histogram() from parallel.h to generate them on several
+ * 	threads. The numbers are binned with histogram.h.
+ * 	Build the sampling library, libsampling.a, first (see sampling.h) and include the -lm and -pthread options at compile
+ * 	time.
+ * 	(gcc -O2 -pthread -o Dice_Distribution_Generator Dice_Distribution_Generator.c libsampling.a -lm)
  * 
 *******************************************************************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
-
-int main() {
-	int x = 0;				// Number of random numbers to be generated. 
-	int index = 0;			// Corresponds to the index of the bin.
-    int i = 0;				// Loop counter
-	int bin[13] = {0};		// Initializes an array with the value of all elements set to 0. Used for binning.
-	int bin_size = sizeof(bin) / sizeof(int);		// Stores the size of the array in integers.
-    int d1 = 0, d2 = 0;		// Stores the randomly generated values for each of the two dice seperately
-
-    srand(time(NULL));		// Seeds the rand() function with the current time.
-
-	printf("Enter the number of random numbers to be generated: ");
-	
-	// Validates x.
-	while(x <= 0) {
-		scanf("%d", &x); 		// Reads the number of random numbers to be generated and stores it in x.
-		if(x <= 0) {
-			printf("\nError! Enter a positive number: ");
+#include <math.h>
+#include <unistd.h>
+#include "sampling.h"
+#include "parallel.h"
+#include "histogram.h"
+
+#define BATCH_SIZE 4096		// Number of sums generated at a time.
+#define ALIAS_DICE 3		// Smallest number of dice whose sum is drawn with an alias table that fits in the cache.
+#define ALIAS_CACHE_SUMS 65536	// Largest number of possible sums whose alias table (12 bytes per sum) fits in the cache.
+#define ALIAS_MISS_DICE 16	// Smallest number of dice whose sum is drawn with an alias table that does not.
+#define CHECK_ROLLS 10000000	// Largest number of dice sums rolled one by one to check the exact distribution.
+
+// Structure contains the dice, the layout of the bins and the exact distribution used by the chi-square test.
+struct Dice_Bins {
+	int dice;		// Number of dice (N).
+	int faces;		// Number of faces of each die (M).
+	int width;		// Number of possible sums, N * (M - 1) + 1.
+	int alias;		// 1 if the sums are drawn with the alias table, else 0.
+	struct Alias_Table table;	// Alias table for the sums.
+	struct Histogram hist;
+};
+
+void roll_dice(struct Rng *rng, long long count, unsigned long long *bin, void *context);
+double chi_square_pmf(const unsigned long long *counts, const double *pmf, int width, long long x, int *df);
+
+int main(int argc, char *argv[]) {
+	long long x = 0;		// Number of random numbers to be generated. 
+	int dice = 2, faces = 6;		// Number of dice and number of faces of each die. Default = 2d6.
+	int bins = 0;			// Number of bins. 0 until it is given.
+	double low = 0, high = 0;		// Range of the bins. Empty until it is given.
+	const char *output = "p2_data.txt";		// File the histogram is written to.
+	int plot = PLOT_TERMINAL;		// Way the histogram is plotted: PLOT_NONE, PLOT_TERMINAL or PLOT_GNUPLOT.
+	struct Histogram_View view;		// Histogram drawn on the terminal while it is generated.
+	int option;
+	unsigned long long *bin;		/* Used for binning. Holds the underflow, the bins and the overflow, then the count of
+									   each sum for the chi-square test. */
+	unsigned long long *check;		// Same as bin, for the sums of dice rolled one by one that check the alias table.
+	long long check_rolls;
+	double *pmf;			// Exact probability of each sum.
+	struct Dice_Bins params;		// Passed to roll_dice().
+	int size, df = 0;
+	double chi_square;
+
+	// Reads the options.
+	while((option = getopt(argc, argv, "n:D:b:r:o:qg")) != -1) {
+		switch(option) {
+			case 'n': x = atoll(optarg); break;
+			case 'D':
+				if(sscanf(optarg, "%dd%d", &dice, &faces) != 2 || dice < 1 || faces < 1) {
+					fprintf(stderr, "Error! The dice must be given as NdM, with at least one die and one face.\n");
+					exit(-1);
+				}
+				break;
+			case 'b': bins = atoi(optarg); break;
+			case 'r': histogram_range_from_arg(optarg, &low, &high); break;
+			case 'o': output = optarg; break;
+			case 'q': plot = PLOT_NONE; break;
+			case 'g': plot = PLOT_GNUPLOT; break;
+			default:
+				fprintf(stderr, "Usage: %s [-n rolls] [-D NdM] [-b bins] [-r low,high] [-o output] [-q | -g] [seed] [threads]\n",
+				argv[0]);
+				exit(-1);
+		}
+	}
+
+	uint64_t seed = rng_seed_from_args(argc, argv, optind);		// Seed given on the command line or the current time.
+	int threads = parallel_threads_from_args(argc, argv, optind + 1);	// Number of threads used to generate the numbers.
+
+	// Prompts for the number of rolls if it was not given on the command line.
+	if(x == 0) {
+		printf("Enter the number of random numbers to be generated: ");
+		
+		// Validates x.
+		while(x <= 0) {
+			if(scanf("%lld", &x) != 1) {		// Reads the number of random numbers to be generated and stores it in x.
+				exit(-1);
+			}
+			if(x <= 0) {
+				printf("\nError! Enter a positive number: ");
+			}
 		}
 	}
+	else if(x < 0) {
+		fprintf(stderr, "Error! The number of rolls must be positive.\n");
+		exit(-1);
+	}
+
+	if((double)dice * (faces - 1) + 1 > 100000000) {
+		fprintf(stderr, "Error! There are too many possible sums.\n");
+		exit(-1);
+	}
+	params.dice = dice;
+	params.faces = faces;
+	params.width = dice * (faces - 1) + 1;
+	params.alias = (dice >= ((params.width <= ALIAS_CACHE_SUMS) ? ALIAS_DICE : ALIAS_MISS_DICE));
+
+	// Computes the exact distribution of the sum and the alias table drawn from it.
+	pmf = malloc(params.width * sizeof(double));
+	if(!pmf) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+	dice_pmf(dice, faces, pmf);
+	if(params.alias) {
+		alias_setup(&params.table, pmf, params.width);
+	}
+
+	// Plots every possible sum unless another range is given. Each bin holds the same whole number of sums, and there are
+	// at most 100 bins.
+	if(!(high > low)) {
+		low = dice;
+		high = dice + params.width;
+	}
+	if(bins == 0) {
+		long step = (long)ceil((high - low) / 100);
+		bins = (int)ceil((high - low) / step);
+		high = low + bins * step;
+	}
+	histogram_setup(&params.hist, bins, low, high);
+	size = histogram_size(&params.hist);
 
-	/* Loop to generate x random die values for two dice, d1 and d2. The values are then added and stored at
-	   the appropriate indices of the array, bin[].	*/
-	for (i = 0; i < x; i++) {
-		d1 = rand() % 6  + 1;		// Generates a random die value for the first die
-		d2 = rand() % 6  + 1;		// Generates a random die value for the second die
-		index = d1 + d2;			// Adds the values of the dice and stores it in the variable index
-		bin[index]++;				// The value at this index of the array, bin[], is incremented by 1.
+	bin = calloc(size + params.width, sizeof(unsigned long long));		// All elements are set to 0.
+	if(!bin) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
 	}
 
-	// Creates file for writing data from the array, bin[].
-	FILE *fp;
-	fp = fopen("p2_data.txt", "w");
+	// Generates x sums of the dice on the given number of threads and adds them to bin[].
+	histogram_view_setup(&view, &params.hist, "Die Number Distribution", x);
+	parallel_histogram_progress(x, threads, seed, bin, size + params.width, roll_dice, &params,
+	(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
 
-	// Loop to write values from bin[] to the file.
-	for (i = 0; i < bin_size; i++) {
-		fprintf(fp, "%d\n", bin[i]);
+	// Compares the sums with their exact distribution.
+	chi_square = chi_square_pmf(bin + size, pmf, params.width, x, &df);
+	printf("%dd%d, %s\n", dice, faces, params.alias ? "sums drawn from the alias table" : "dice rolled one by one");
+	printf("Chi-square against the exact distribution: %.2f with %d degrees of freedom (expected %d +/- %.1f)\n", chi_square,
+	df, df, sqrt(2.0 * df));
+
+	// The alias table is built from the exact distribution, so the test above cannot find a mistake in it. Rolls the dice
+	// one by one, from another seed, and checks the exact distribution against them.
+	if(params.alias) {
+		check_rolls = (x < CHECK_ROLLS) ? x : CHECK_ROLLS;
+		check = calloc(size + params.width, sizeof(unsigned long long));
+		if(!check) {
+			perror("Error! Cannot allocate memory!");
+			exit(-1);
+		}
+		params.alias = 0;
+		parallel_histogram(check_rolls, threads, seed + 1, check, size + params.width, roll_dice, &params);
+		params.alias = 1;
+		chi_square = chi_square_pmf(check + size, pmf, params.width, check_rolls, &df);
+		printf("Chi-square of %lld dice sums rolled one by one against the exact distribution: %.2f with %d degrees of "
+		"freedom (expected %d +/- %.1f)\n", check_rolls, chi_square, df, df, sqrt(2.0 * df));
+		free(check);
 	}
-	fclose(fp);		// Closes file
-
-	// Plots a random die number distribution graph on the terminal using gnuplot with the data from the generated file, p2_data.txt.
-	FILE *gnuplot = popen("gnuplot", "w");
-	fprintf(gnuplot, "set term dumb\n");
-	fprintf(gnuplot, "set xlabel 'Bins' \n");
-	fprintf(gnuplot, "set ylabel 'Frequency' \n");
-	fprintf(gnuplot, "set xrange [0:14] \n");
-	fprintf(gnuplot, "set yrange [0:*] \n");
-	fprintf(gnuplot, "set style data histogram \n");
-	fprintf(gnuplot, "set style histogram clustered \n");
-	fprintf(gnuplot, "set xtics 0,1,12 \n");
-	fprintf(gnuplot, "set key off \n");
-	fprintf(gnuplot, "set title 'Die Number Distribution' \n");
-	fprintf(gnuplot, "plot 'p2_data.txt' \n");
-	pclose(gnuplot);
+	printf("Outside the range: %llu below, %llu above\n", bin[0], bin[bins + 1]);
+
+	// Writes the histogram to the output file and plots a random die number distribution graph on the terminal, unless it was
+	// drawn while it was generated.
+	histogram_write(&params.hist, bin, output);
+	histogram_show(&view, bin, output, plot);
+	if(params.alias) {
+		alias_free(&params.table);
+	}
+	free(pmf);
+	free(bin);
 
 	return 0;
 }	//eod
 
+
+/**
+ * This function generates count sums of the dice in batches and adds them to the histogram at the start of the array, bin[].
+ * Each sum is also counted after the histogram, at bin[histogram_size() + sum - N]. The dice and the bins are described by
+ * context, which points to a structure Dice_Bins. Called by parallel_histogram() for each chunk of rolls.		*/
+void roll_dice(struct Rng *rng, long long count, unsigned long long *bin, void *context) {
+	const struct Dice_Bins *params = context;
+	unsigned long long *counts = bin + histogram_size(&params->hist);		// Counts for the chi-square test.
+	int sums[BATCH_SIZE];			// Stores a batch of sums.
+	long long i;
+	int j, batch;
+
+	for (i = 0; i < count; i += batch) {
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+
+		// The alias table gives the sum minus N.
+		if (params->alias) {
+			fill_alias(rng, &params->table, sums, batch);
+			for (j = 0; j < batch; j++) {
+				counts[sums[j]]++;
+				sums[j] += params->dice;
+			}
+		}
+		else {
+			fill_dice_sums(rng, sums, batch, params->dice, params->faces);
+			for (j = 0; j < batch; j++) {
+				counts[sums[j] - params->dice]++;
+			}
+		}
+		histogram_add_int(&params->hist, bin, sums, batch);		// Adds the sums to the bins described by the parameters.
+	}
+}
+
+
+/**
+ * This function computes the chi-square statistic of the counted sums against their exact probabilities, pmf[]. The
+ * function takes in the count of each of the width possible sums and the number of rolls (x). Neighbouring sums are
+ * pooled until each cell expects at least 5 rolls, and the rest of the last cell is added to the one before it. The
+ * degrees of freedom are returned in df.																		*/
+double chi_square_pmf(const unsigned long long *counts, const double *pmf, int width, long long x, int *df) {
+	double chi_square = 0, last = 0;		// last is the term of the last full cell, which may still be pooled.
+	double expected = 0, observed = 0;		// Expected and observed numbers in the cell being pooled.
+	double last_expected = 0, last_observed = 0;
+	int k;
+
+	*df = -1;
+	for(k = 0; k < width; k++) {
+		expected += x * pmf[k];
+		observed += counts[k];
+
+		if(expected >= 5) {
+			chi_square += last;
+			last_expected = expected;
+			last_observed = observed;
+			last = (observed - expected) * (observed - expected) / expected;
+			expected = 0;
+			observed = 0;
+			(*df)++;
+		}
+	}
+
+	// Sums left over at the top, which expect fewer than 5 rolls.
+	expected += last_expected;
+	observed += last_observed;
+	if(expected > 0) {
+		chi_square += (observed - expected) * (observed - expected) / expected;
+	}
+	return chi_square;
+}
@@ -5,132 +5,264 @@
  * 
  * Written by: Athul Subash Marottikkal - January 2023
  * 
- * Purpose: Generates X random numbers from a Normal distribution with a given mean and standard deviation using the Box-Muller
- * 			transform method, and displays the resulting distribution on the terminal.
+ * Purpose: Generates X random numbers from a Normal distribution with a given mean and standard deviation using the Ziggurat
+ * 			method, and displays the resulting distribution on the terminal. Optionally, the numbers are also fed to a
+ * 			quantile sketch, which reports their quantiles and tail masses, however far out, next to the exact ones.
+ * 			With -Q or -O, the numbers are made from the quasi-random Sobol sequence by the inverse normal distribution
+ * 			function instead, which fills the bins far more evenly than random numbers do.
  * 
  * Usage: 
- * 	./Normal_Distribution_Generator
- * 	The program will prompt the user to enter the number of random numbers to be generated (x), the mean and the standard deviation
- *  of the Normal distribution. The program will then generate and plot the Normal distribution.
+ * 	./Normal_Distribution_Generator [-n count] [-m mean] [-d sd] [-b bins] [-r low,high] [-s alpha] [-Q | -O]
+ * 	     [-o output] [-q | -g] [seed] [threads]
+ * 	-n - Number of random numbers to be generated (x). If it is not given, the program will prompt the user to enter it,
+ * 	     the mean and the standard deviation.
+ * 	-m, -d - Mean and standard deviation of the Normal distribution. Default = 12 and 2.
+ * 	-b, -r - Number of bins and their range. Default = 100 bins over 3 standard deviations either side of the mean.
+ * 	-s - Also feed the numbers to a quantile sketch whose quantiles are accurate to within alpha times their distance
+ * 	     from the mean (for example 0.005).
+ * 	-Q - Make the numbers from the Sobol sequence instead of the random number generator. The seed is then unused.
+ * 	-O - Make the numbers from the Sobol sequence with Owen scrambling, which is different for each seed.
+ * 	-o - File the histogram is written to. Default = p3_data.txt.
+ * 	-q - Do not plot the histogram.
+ * 	-g - Plot the histogram with gnuplot instead of drawing it on the terminal. On a terminal, the drawing is updated
+ * 	     every half second while the numbers are generated.
+ * 	The seed is optional and defaults to the current time. The same seed always gives the same numbers, whatever the 
+ * 	number of threads. The number of threads is optional and defaults to the number of CPUs.
+ * 	The program will then generate and plot the Normal distribution. Numbers outside the range are counted as underflow
+ * 	or overflow.
+ * 	(./Normal_Distribution_Generator -n 1000000 -m 0 -d 1 -r -5,5 -o normal.txt -q 42)
+ * 	(./Normal_Distribution_Generator -n 1000000000 -s 0.005 -q 42 8)
+ * 	(./Normal_Distribution_Generator -n 1000000 -O -q 42)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
- * 	The program uses the rand() function from the stdlib.h library to generate random numbers, and 
- * 	the roundl() function from the math.h library to round the numbers to the nearest bin index. 
- * 	The program also uses the time.h library to seed the random number generator with the current time.
- * 	The _USE_MATH_DEFINES macro is used to make M_PI available for use in the program and the float.h library
- *  is used to make DBL_EPSILON available.
- * 	Include the -lm option at compile time.
- * 	(gcc -o Normal_Distribution_Generator Normal_Distribution_Generator.c -lm)
+ * 	The program uses the batch normal sampler, fill_normal(), from sampling.h with the xoshiro256++ generator from rng.h to 
+ * 	generate random numbers and parallel_histogram() from parallel.h to generate them on several threads. The numbers are
+ * 	binned with histogram.h and sketched with sketch.h. Quasi-random numbers come from sobol.h and are generated with
+ * 	parallel_sequence_progress().
+ * 	Build the sampling library, libsampling.a, first (see sampling.h) and include the -lm and -pthread options at compile
+ * 	time.
+ * 	(gcc -O2 -pthread -o Normal_Distribution_Generator Normal_Distribution_Generator.c libsampling.a -lm)
  * 
 *******************************************************************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
-#include<float.h>
-#define _USE_MATH_DEFINES
 #include <math.h>
+#include <unistd.h>
+#include "sampling.h"
+#include "parallel.h"
+#include "histogram.h"
+#include "sketch.h"
+#include "sobol.h"
 
-double scale_factor = 1.0 / (double)RAND_MAX; 	// Used to scale the values returned by the rand() function to [0,1]. Global variable.
+#define BATCH_SIZE 4096		// Number of random numbers generated by each call to fill_normal().
 
-double rand_generator(double mean, double sd);
+// Structure contains the parameters of the distribution, the layout of the bins, the layout of the sketch and the Sobol
+// sequence of the quasi-random numbers.
+struct Normal_Bins
+{
+	double mean;
+	double sd;
+	struct Histogram hist;
+	int sketched;			// 1 if the numbers are also sketched, else 0.
+	struct Sketch sketch;
+	struct Sobol sobol;
+};
 
-int main() {
-	int x = 0;				// Number of random numbers to be generated. 
-	int index = 0;			// Corresponds to the index of the bin.
-    int i = 0;				// Loop counter
-	int bin[100] = {0};		// Initializes an array with the value of all elements set to 0. Used for binning.
-	int bin_size = sizeof(bin) / sizeof(int);		// Stores the size of the array in integers.
+void generate_normal(struct Rng *rng, long long count, unsigned long long *bin, void *context);
+void quasi_normal(long long first, long long count, unsigned long long *bin, void *context);
+void bin_normal(const struct Normal_Bins *params, unsigned long long *bin, const double *samples, int batch);
+void report_sketch(const struct Sketch *sketch, const unsigned long long *count, double mean, double sd);
+
+int main(int argc, char *argv[]) {
+	long long x = 0;		// Number of random numbers to be generated. 
+	int bins = 100;			// Number of bins. Default = 100.
+	double low = 0, high = 0;		// Range of the bins. Default = 3 standard deviations either side of the mean.
+	const char *output = "p3_data.txt";		// File the histogram is written to.
+	int plot = PLOT_TERMINAL;		// Way the histogram is plotted: PLOT_NONE, PLOT_TERMINAL or PLOT_GNUPLOT.
+	struct Histogram_View view;		// Histogram drawn on the terminal while it is generated.
+	int option;
+	unsigned long long *bin;		/* Used for binning. Holds the underflow, the bins and the overflow, followed by the
+									   counters of the sketch. */
+	int size;				// Number of counters in the histogram.
+	double alpha = 0;		// Accuracy of the sketch. 0 if the numbers are not sketched.
+	int sequence = SEQUENCE_RANDOM;		// Sequence the numbers are made from.
 
 	double mean = 12;	// Mean of the normal distribution. Default = 12.
 	double sd = 2;		// Standard deviation of the normal distribution. Default = 2.
+	struct Normal_Bins params;	// Passed to generate_normal().
 
-	srand(time(NULL));		// Seeds the rand() function with the current time.
+	// Reads the options.
+	while((option = getopt(argc, argv, "n:m:d:b:r:s:QOo:qg")) != -1) {
+		switch(option) {
+			case 'n': x = atoll(optarg); break;
+			case 'm': mean = atof(optarg); break;
+			case 'd': sd = atof(optarg); break;
+			case 'b': bins = atoi(optarg); break;
+			case 'r': histogram_range_from_arg(optarg, &low, &high); break;
+			case 's': alpha = atof(optarg); break;
+			case 'Q': sequence = (sequence == SEQUENCE_OWEN) ? SEQUENCE_OWEN : SEQUENCE_SOBOL; break;
+			case 'O': sequence = SEQUENCE_OWEN; break;
+			case 'o': output = optarg; break;
+			case 'q': plot = PLOT_NONE; break;
+			case 'g': plot = PLOT_GNUPLOT; break;
+			default:
+				fprintf(stderr, "Usage: %s [-n count] [-m mean] [-d sd] [-b bins] [-r low,high] [-s alpha] [-Q | -O] [-o output] "
+				"[-q | -g] [seed] [threads]\n",
+				argv[0]);
+				exit(-1);
+		}
+	}
 
-	printf("Enter the number of random numbers to be generated: ");
+	uint64_t seed = rng_seed_from_args(argc, argv, optind);		// Seed given on the command line or the current time.
+	int threads = parallel_threads_from_args(argc, argv, optind + 1);	// Number of threads used to generate the numbers.
 
-	// Validates x.
-	while(x <= 0) {
-		scanf("%d", &x); 		// Reads the number of random numbers to be generated and stores it in x.
-		if(x <= 0) {
-			printf("\nError! Enter a positive number: ");
+	// Prompts for the number of random numbers, the mean and the standard deviation if the number was not given on the
+	// command line.
+	if(x == 0) {
+		printf("Enter the number of random numbers to be generated: ");
+
+		// Validates x.
+		while(x <= 0) {
+			if(scanf("%lld", &x) != 1) {		// Reads the number of random numbers to be generated and stores it in x.
+				exit(-1);
+			}
+			if(x <= 0) {
+				printf("\nError! Enter a positive number: ");
+			}
 		}
-	}
 
-	printf("Enter the mean: ");
-	scanf("%lf", &mean);	// Reads the mean and stores it in the variable mean.
-	printf("Enter the standard deviation: ");
-	scanf("%lf", &sd);	// Reads the standard deviation and stores it in the variable sd.
+		printf("Enter the mean: ");
+		scanf("%lf", &mean);	// Reads the mean and stores it in the variable mean.
+		printf("Enter the standard deviation: ");
+		scanf("%lf", &sd);	// Reads the standard deviation and stores it in the variable sd.
+	}
+	else if(x < 0 || sd <= 0) {
+		fprintf(stderr, "Error! The number of random numbers and the standard deviation must be positive.\n");
+		exit(-1);
+	}
 
 	// Empirical rule. Source: https://en.wikipedia.org/wiki/68%E2%80%9395%E2%80%9399.7_rule
-	double min = mean - 3 * sd;		// Generates an estimated minimum value for the distribution.
-	double max = mean + 3 * sd;		// Generates an estimated maximum value for the distribution.
+	if(!(high > low)) {
+		low = mean - 3 * sd;		// Generates an estimated minimum value for the distribution.
+		high = mean + 3 * sd;		// Generates an estimated maximum value for the distribution.
+	}
 
-	double bin_width = 100 / (max - min);	// Calculates the width of each bin
+	params.mean = mean;
+	params.sd = sd;
+	histogram_setup(&params.hist, bins, low, high);
+	size = histogram_size(&params.hist);
+	params.sketched = alpha != 0;
+	if(params.sketched) {
+		sketch_setup(&params.sketch, alpha, mean);
+	}
 
-	// Loop to generate x random numbers and store them, at the appropriate indices of the array, bin[].
-	for(i = 0; i < x; i++)
-	{
-		index = roundl(bin_width * (rand_generator(mean,sd) - min));	/* Calls the rand_generator() function with the
-		parameters, mean and sd. The returned normally random value is subtracted by the min value and multiplied by bin_width
-		 to get the appropriate index */
-
-		/* The if and else if statements stops the index from being out of the array's bounds. Accounts for around 0.3% of 
-		   the values that are outside the Emirical rule */  
-		if(index > 99)
-			index = 99;
-		else if(index < 0)
-			index = 0;
-
-		bin[index]++;	// The value at this index of the array, bin[], is incremented by 1.
+	bin = calloc(size + (params.sketched ? sketch_size(&params.sketch) : 0), sizeof(unsigned long long));	// All elements are set to 0.
+	if(!bin) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
 	}
 
-	// Creates file for writing data from the array, bin[].
-	FILE *fp;
-	fp = fopen("p3_data.txt", "w");
+	// Generates x random numbers on the given number of threads and adds them to bin[].
+	histogram_view_setup(&view, &params.hist, "Normal Distribution", x);
+	if(sequence != SEQUENCE_RANDOM) {
+		sobol_setup(&params.sobol, 1, sequence == SEQUENCE_OWEN, seed);
+		parallel_sequence_progress(x, threads, bin, size + (params.sketched ? sketch_size(&params.sketch) : 0),
+		quasi_normal, &params,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
+	}
+	else {
+		parallel_histogram_progress(x, threads, seed, bin, size + (params.sketched ? sketch_size(&params.sketch) : 0),
+		generate_normal, &params,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
+	}
 
-	// Loop to write values from bin[] to the file.
-	for (i = 0; i < bin_size; i++) {
-		fprintf(fp, "%d\n", bin[i]);
+	// Values outside the range are counted instead of being clamped into the first and last bins.
+	printf("Outside the range: %llu below, %llu above\n", bin[0], bin[bins + 1]);
+	if(params.sketched) {
+		report_sketch(&params.sketch, bin + size, mean, sd);
 	}
-	fclose(fp);		// Closes file
-
-	// Plots a random normal distribution graph on the terminal using gnuplot with the data from the generated file, p3_data.txt.
-	FILE *gnuplot = popen("gnuplot", "w");
-	fprintf(gnuplot, "set term dumb\n");
-	fprintf(gnuplot, "set xlabel 'Bins' \n");
-	fprintf(gnuplot, "set ylabel 'Frequency' \n");
-	fprintf(gnuplot, "set xrange [0:101] \n");
-	fprintf(gnuplot, "set yrange [0:*] \n");
-	fprintf(gnuplot, "set style data histogram \n");
-	fprintf(gnuplot, "set style histogram clustered \n");
-	fprintf(gnuplot, "set key off \n");
-	fprintf(gnuplot, "set title 'Normal Distribution' \n");
-	fprintf(gnuplot, "plot 'p3_data.txt'\n");
-	pclose(gnuplot);
+
+	// Writes the histogram to the output file and plots a random normal distribution graph on the terminal, unless it was
+	// drawn while it was generated.
+	histogram_write(&params.hist, bin, output);
+	histogram_show(&view, bin, output, plot);
+	free(bin);
 		
 	return 0;
 }	// eod
 
 
 /**
- * This function generates normally distributed random numbers using the Box-Muller transform method. The function takes in 
- * two arguments, mean and standard deviation (sd) and outputs a random number from the normal distribution.
- * Source: https://en.wikipedia.org/wiki/Box%E2%80%93Muller_transform 														*/ 
-double rand_generator(double mean, double sd) {
-	double u1 = 0, u2 = 0;		// Stores the uniformly distributed random numbers
-	double z = 0;				// Stores the randomly generated number after transformation
-	
-	// The value returned by the rand() function is multiplied by the scale_factor and stored in u1 and u2.
-	u1 = rand() * scale_factor;
-	u2 = rand() * scale_factor;
-
-	// This if statement gets rid of infinities caused by the log function when u1 is less than zero.
-	if (u1 < DBL_EPSILON) {
-        u1 = DBL_EPSILON;
-    }
-
-	z = sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);	// Applies the Box-Muller transform formula and stores the value in z
-
-	return mean + sd * z;		// returns the normally distributed random number.
+ * This function generates count normally distributed random numbers in batches and stores them, at the appropriate 
+ * indices of the array, bin[]. The distribution and the bins are described by context, which points to a structure
+ * Normal_Bins. Called by parallel_histogram() for each chunk of numbers.											*/
+void generate_normal(struct Rng *rng, long long count, unsigned long long *bin, void *context) {
+	const struct Normal_Bins *params = context;
+	double samples[BATCH_SIZE];		// Stores a batch of normally distributed random numbers.
+	long long i;
+	int batch;
+
+	for(i = 0; i < count; i += batch)
+	{
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		fill_normal(rng, samples, batch, params->mean, params->sd);		// Fills samples[] with normally distributed random numbers.
+		bin_normal(params, bin, samples, batch);
+	}
 }
+
+
+/**
+ * This function makes normally distributed numbers from the numbers first to first + count - 1 of the Sobol sequence and
+ * stores them at the appropriate indices of the array, bin[]. The distribution, the bins and the sequence are described
+ * by context, which points to a structure Normal_Bins. Called by parallel_sequence_progress() for each chunk of numbers.
+ * 																												*/
+void quasi_normal(long long first, long long count, unsigned long long *bin, void *context) {
+	const struct Normal_Bins *params = context;
+	struct Sobol_Stream stream;
+	double samples[BATCH_SIZE];		// Stores a batch of normally distributed quasi-random numbers.
+	long long i;
+	int batch;
+
+	sobol_start(&stream, &params->sobol, first);
+	for(i = 0; i < count; i += batch)
+	{
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		sobol_fill_normal(&stream, samples, batch, params->mean, params->sd);
+		bin_normal(params, bin, samples, batch);
+	}
+}
+
+
+/**
+ * This function adds a batch of numbers to the histogram at the start of bin[] and, if they are sketched, to the sketch
+ * after it. 																									*/
+void bin_normal(const struct Normal_Bins *params, unsigned long long *bin, const double *samples, int batch) {
+	histogram_add(&params->hist, bin, samples, batch);
+	if(params->sketched) {
+		sketch_add(&params->sketch, bin + histogram_size(&params->hist), samples, batch);
+	}
+}
+
+
+/**
+ * This function prints the quantiles and tail masses estimated by the sketch, whose counters are count[], next to the
+ * exact ones of the Normal distribution with the given mean and standard deviation (sd).						*/
+void report_sketch(const struct Sketch *sketch, const unsigned long long *count, double mean, double sd) {
+	static const double q[] = {1e-6, 1e-4, 1e-3, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999, 1 - 1e-4, 1 - 1e-6};
+	int i, k;
+
+	printf("Quantiles from the sketch, to within %g of the distance from the mean:\n", sketch->alpha);
+	printf("%10s %16s %16s\n", "q", "sketch", "exact");
+	for(i = 0; i < (int)(sizeof(q) / sizeof(q[0])); i++) {
+		printf("%10.6f %16.8g %16.8g\n", q[i], sketch_quantile(sketch, count, q[i]), mean + sd * normal_inverse(q[i]));
+	}
+
+	printf("Tail mass beyond k standard deviations:\n");
+	printf("%4s %14s %14s %14s\n", "k", "below", "above", "exact");
+	for(k = 1; k <= 6; k++) {
+		printf("%4d %14.6g %14.6g %14.6g\n", k, 1 - sketch_tail(sketch, count, mean - k * sd),
+		sketch_tail(sketch, count, mean + k * sd), 0.5 * erfc(k / sqrt(2.0)));
+	}
+}
+
@@ -5,116 +5,379 @@
  * 
  * Written by: Athul Subash Marottikkal - January 2023
  * 
- * Purpose: Generates X random numbers from a Poisson distribution with a given  expected value (lamda) using the Knuth method,
- * 			and displays the resulting distribution on the terminal.
+ * Purpose: Generates X random numbers from a Poisson distribution with a given  expected value (lamda) using inversion for
+ * 			small lamda and the PTRS transformed rejection method for large lamda, and displays the resulting distribution on 
+ * 			the terminal. The generated numbers are checked against the exact Poisson probabilities with a chi-square test.
+ * 			Optionally, they are also fed to a quantile sketch, which reports their quantiles and tail masses, however far
+ * 			out, next to the exact ones. With -Q or -O, the numbers are made from the quasi-random Sobol sequence by
+ * 			inversion of the cumulative distribution instead, which fills the bins far more evenly than random numbers do.
  * 
  * Usage: 
- * 	./p4_pois_Poisson_Distributiondist
- * 	The program will prompt the user to enter the number of random numbers to be generated (x), expected value (lambda) of the
- *  Poisson distribution. The program will then generate and plot the Poisson distribution.
+ * 	./Poisson_Distribution [-n count] [-l lambda] [-b bins] [-r low,high] [-s alpha] [-Q | -O] [-o output]
+ * 	     [-q | -g] [seed] [threads]
+ * 	-n - Number of random numbers to be generated (x). If it is not given, the program will prompt the user to enter it
+ * 	     and the expected value.
+ * 	-l - Expected value (lambda) of the Poisson distribution. Default = 5, at most 1e9 (POISSON_LAMBDA_MAX).
+ * 	-b, -r - Number of bins and their range. Default = 8 standard deviations either side of lambda, with the same whole
+ * 	     number of values in each bin and at most 100 bins.
+ * 	-s - Also feed the numbers to a quantile sketch whose quantiles are accurate to within alpha times their distance
+ * 	     from lambda (for example 0.005).
+ * 	-Q - Make the numbers from the Sobol sequence instead of the random number generator. The seed is then unused.
+ * 	-O - Make the numbers from the Sobol sequence with Owen scrambling, which is different for each seed. The chi-square
+ * 	     test then comes out far below its expected value, since the numbers are spread more evenly than random ones.
+ * 	-o - File the histogram is written to. Default = p4_data.txt.
+ * 	-q - Do not plot the histogram.
+ * 	-g - Plot the histogram with gnuplot instead of drawing it on the terminal. On a terminal, the drawing is updated
+ * 	     every half second while the numbers are generated.
+ * 	The seed is optional and defaults to the current time. The same seed always gives the same numbers, whatever the 
+ * 	number of threads. The number of threads is optional and defaults to the number of CPUs.
+ * 	The program will then generate and plot the Poisson distribution. Numbers outside the range are counted as underflow
+ * 	or overflow.
+ * 	(./Poisson_Distribution -n 1000000 -l 800 -o poisson.txt -q 42)
+ * 	(./Poisson_Distribution -n 1000000000 -l 800 -s 0.005 -q 42 8)
+ * 	(./Poisson_Distribution -n 1000000 -l 800 -O -q 42)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
- * 	The program uses the rand() function from the stdlib.h library to generate random numbers, and 
- * 	the roundl() function from the math.h library to round the numbers to the nearest bin index. 
- * 	The program also uses the time.h library to seed the random number generator with the current time.
- * 	Include the -lm option at compile time.
- * 	(gcc -o Poisson_Distribution Poisson_Distribution.c -lm)
+ * 	The program uses the batch Poisson sampler, fill_poisson(), from sampling.h with the xoshiro256++ generator from rng.h
+ * 	to generate random numbers, and parallel_histogram() from parallel.h to generate them on several threads. The numbers
+ * 	are binned with histogram.h and sketched with sketch.h. Quasi-random numbers come from sobol.h and are generated with
+ * 	parallel_sequence_progress().
+ * 	Build the sampling library, libsampling.a, first (see sampling.h) and include the -lm and -pthread options at compile
+ * 	time.
+ * 	(gcc -O2 -pthread -o Poisson_Distribution Poisson_Distribution.c libsampling.a -lm)
  * 
 *******************************************************************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <unistd.h>
+#include "sampling.h"
+#include "parallel.h"
+#include "histogram.h"
+#include "sketch.h"
+#include "sobol.h"
 
-double scale_factor = 1.0 / (double)RAND_MAX; 	// Used to scale the values returned by the rand() function to [0,1]. Global variable.
+#define BATCH_SIZE 4096		// Number of random numbers generated by each call to fill_poisson().
 
-int poisson_generator(double lamda);
+// Structure contains the parameters of the distribution, the layout of the bins, the counts used by the chi-square test, the
+// layout of the sketch and the Sobol sequence and inversion table of the quasi-random numbers.
+struct Poisson_Bins
+{
+	double lambda;
+	struct Histogram hist;
+	long low;		// Smallest value counted for the chi-square test.
+	long width;		// Number of values counted for the chi-square test.
+	int sketched;	// 1 if the numbers are also sketched, else 0.
+	struct Sketch sketch;
+	struct Sobol sobol;
+	struct Cdf_Table table;
+};
 
-int main() {
-	int x = 0;				// Number of random numbers to be generated. 
-	int index = 0;			// Corresponds to the index of the bin.
-    int i = 0;				// Loop counter
-	int bin[100] = {0};		// Initializes an array with the value of all elements set to 0. Used for binning.
-	int bin_size = sizeof(bin) / sizeof(int);		// Stores the size of the array in integers.
+void generate_poisson(struct Rng *rng, long long count, unsigned long long *bin, void *context);
+void quasi_poisson(long long first, long long count, unsigned long long *bin, void *context);
+void bin_poisson(const struct Poisson_Bins *params, unsigned long long *bin, const int *samples, int batch);
+void poisson_table(struct Cdf_Table *table, double lambda);
+double chi_square_pmf(const unsigned long long *counts, long low, long width, long long x, double lambda, int *df);
+void report_sketch(const struct Sketch *sketch, const unsigned long long *count, double lambda);
+
+int main(int argc, char *argv[]) {
+	long long x = 0;		// Number of random numbers to be generated. 
+	int bins = 0;			// Number of bins. Default = one for each value in the range, at most 100.
+	double low = 0, high = 0;		// Range of the bins. Default = 8 standard deviations either side of lambda.
+	const char *output = "p4_data.txt";		// File the histogram is written to.
+	int plot = PLOT_TERMINAL;		// Way the histogram is plotted: PLOT_NONE, PLOT_TERMINAL or PLOT_GNUPLOT.
+	struct Histogram_View view;		// Histogram drawn on the terminal while it is generated.
+	int option;
+	unsigned long long *bin;		/* Used for binning. Holds the underflow, the bins and the overflow, followed by the
+									   count of each value for the chi-square test and the counters of the sketch. */
+	int size;				// Number of counters in the histogram.
+	double alpha = 0;		// Accuracy of the sketch. 0 if the numbers are not sketched.
+	int sequence = SEQUENCE_RANDOM;		// Sequence the numbers are made from.
 
 	double lambda = 5;		// Expected value of the Poisson distribution. Default = 5.
+	struct Poisson_Bins params;		// Passed to generate_poisson().
 
-	srand(time(NULL));		// Seeds the rand() function with the current time.
+	// Reads the options.
+	while((option = getopt(argc, argv, "n:l:b:r:s:QOo:qg")) != -1) {
+		switch(option) {
+			case 'n': x = atoll(optarg); break;
+			case 'l': lambda = atof(optarg); break;
+			case 'b': bins = atoi(optarg); break;
+			case 'r': histogram_range_from_arg(optarg, &low, &high); break;
+			case 's': alpha = atof(optarg); break;
+			case 'Q': sequence = (sequence == SEQUENCE_OWEN) ? SEQUENCE_OWEN : SEQUENCE_SOBOL; break;
+			case 'O': sequence = SEQUENCE_OWEN; break;
+			case 'o': output = optarg; break;
+			case 'q': plot = PLOT_NONE; break;
+			case 'g': plot = PLOT_GNUPLOT; break;
+			default:
+				fprintf(stderr, "Usage: %s [-n count] [-l lambda] [-b bins] [-r low,high] [-s alpha] [-Q | -O] [-o output] "
+				"[-q | -g] [seed] [threads]\n",
+				argv[0]);
+				exit(-1);
+		}
+	}
 
-	printf("Enter the number of random numbers to be generated: ");
+	uint64_t seed = rng_seed_from_args(argc, argv, optind);		// Seed given on the command line or the current time.
+	int threads = parallel_threads_from_args(argc, argv, optind + 1);	// Number of threads used to generate the numbers.
 
-	// Validates x.
-	do {
-		scanf("%d", &x); 		// Reads the number of random numbers to be generated and stores it in x.
-		if(x <= 0) {
-			printf("\nError! Enter a positive number: ");
-		}
-	} while(x <= 0);
+	// Prompts for the number of random numbers and the expected value if the number was not given on the command line.
+	if(x == 0) {
+		printf("Enter the number of random numbers to be generated: ");
 
-	printf("Enter the expected value: ");
+		// Validates x.
+		do {
+			if(scanf("%lld", &x) != 1) {		// Reads the number of random numbers to be generated and stores it in x.
+				exit(-1);
+			}
+			if(x <= 0) {
+				printf("\nError! Enter a positive number: ");
+			}
+		} while(x <= 0);
 
-	// Validates lambda.
-	do {
-		scanf("%lf", &lambda);	// Reads expected value and stores it in lambda.
-		if(lambda <= 0) {
-			printf("\nError! Enter a positive number: ");
-		}
-	} while(lambda <= 0);
+		printf("Enter the expected value: ");
 
-	// Loop to generate x random numbers and store them, at the appropriate indices of the array, bin[].
-	for(i = 0; i < x; i++) {
-		index = poisson_generator(lambda) % bin_size;	/* Calls the poisson_generator() function with the
-		parameter, lambda. A random value from a Poisson distribution with an expected value of lambda is returned and
-		its remainder when divided by the bin_size is taken as the index */
-		bin[index]++;	// The value at this index of the array, bin[], is incremented by 1.
+		// Validates lambda.
+		do {
+			if(scanf("%lf", &lambda) != 1) {	// Reads expected value and stores it in lambda.
+				exit(-1);
+			}
+			if(lambda <= 0 || lambda > POISSON_LAMBDA_MAX) {
+				printf("\nError! Enter a positive number of at most %g: ", POISSON_LAMBDA_MAX);
+			}
+		} while(lambda <= 0 || lambda > POISSON_LAMBDA_MAX);
+	}
+	else if(x < 0 || lambda <= 0) {
+		fprintf(stderr, "Error! The number of random numbers and the expected value must be positive.\n");
+		exit(-1);
+	}
+	else if(lambda > POISSON_LAMBDA_MAX) {
+		fprintf(stderr, "Error! The expected value must be at most %g.\n", POISSON_LAMBDA_MAX);
+		exit(-1);
 	}
 
-	// Creates file for writing data from the array, bin[].
-	FILE *fp;
-	fp = fopen("p4_data.txt", "w");
+	// Counts every value within 8 standard deviations of lambda for the chi-square test.
+	params.lambda = lambda;
+	params.low = (long)fmax(0, lambda - 8 * sqrt(lambda) - 5);
+	params.width = (long)(lambda + 8 * sqrt(lambda) + 10) - params.low + 1;
+	int df = 0;
+	double chi_square = 0;
 
-	// Loop to write values from bin[] to the file.
-	for (i = 0; i < bin_size; i++) {
-		if(bin[i] > 0) {
-			fprintf(fp, "%d\n", bin[i]);
-		}
+	// Plots the same values unless another range is given. Each bin holds the same whole number of values, and there are at
+	// most 100 bins.
+	if(!(high > low)) {
+		low = params.low;
+		high = params.low + params.width;
+	}
+	if(bins == 0) {
+		long step = (long)ceil((high - low) / 100);
+		bins = (int)ceil((high - low) / step);
+		high = low + bins * step;
+	}
+	histogram_setup(&params.hist, bins, low, high);
+	size = histogram_size(&params.hist);
+	params.sketched = alpha != 0;
+	if(params.sketched) {
+		sketch_setup(&params.sketch, alpha, lambda);
+	}
+
+	bin = calloc(size + params.width + (params.sketched ? sketch_size(&params.sketch) : 0), sizeof(unsigned long long));
+	if(!bin) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+
+	// Generates x random numbers on the given number of threads and adds them to bin[].
+	histogram_view_setup(&view, &params.hist, "Poisson Distribution", x);
+	if(sequence != SEQUENCE_RANDOM) {
+		sobol_setup(&params.sobol, 1, sequence == SEQUENCE_OWEN, seed);
+		poisson_table(&params.table, lambda);
+		parallel_sequence_progress(x, threads, bin, size + params.width + (params.sketched ? sketch_size(&params.sketch) : 0),
+		quasi_poisson, &params,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
+		cdf_free(&params.table);
+	}
+	else {
+		parallel_histogram_progress(x, threads, seed, bin, size + params.width + (params.sketched ? sketch_size(&params.sketch) : 0),
+		generate_poisson, &params,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
 	}
-	fclose(fp);		// Closes file
-
-	// Plots a random normal distribution graph on the terminal using gnuplot with the data from the generated file, p4_data.txt.
-	FILE *gnuplot = popen("gnuplot", "w");
-	fprintf(gnuplot, "set term dumb\n");
-	fprintf(gnuplot, "set xlabel 'Bins' \n");
-	fprintf(gnuplot, "set ylabel 'Frequency' \n");
-	fprintf(gnuplot, "set xrange [0:*] \n");
-	fprintf(gnuplot, "set yrange [0:*] \n");
-	fprintf(gnuplot, "set style data histogram \n");
-	fprintf(gnuplot, "set style histogram clustered \n");
-	fprintf(gnuplot, "set key off \n");
-	fprintf(gnuplot, "set title 'Poisson Distribution' \n");
-	fprintf(gnuplot, "plot 'p4_data.txt'\n");
-	pclose(gnuplot);
+
+	// Compares the generated numbers with the exact Poisson probabilities.
+	chi_square = chi_square_pmf(bin + size, params.low, params.width, x, lambda, &df);
+	printf("Chi-square against the exact pmf: %.2f with %d degrees of freedom (expected %d +/- %.1f)\n", chi_square, df, df,
+	sqrt(2.0 * df));
+	printf("Outside the range: %llu below, %llu above\n", bin[0], bin[bins + 1]);
+	if(params.sketched) {
+		report_sketch(&params.sketch, bin + size + params.width, lambda);
+	}
+
+	// Writes the histogram to the output file and plots a random Poisson distribution graph on the terminal, unless it was
+	// drawn while it was generated.
+	histogram_write(&params.hist, bin, output);
+	histogram_show(&view, bin, output, plot);
+	free(bin);
 		
 	return 0;
 }	// eod
 
 
 /**
- * This function generates random numbers from a Poisson distribution with an expected value of lambda using Knuth method. 
- * The function takes in one argument, lambda and outputs a random number from the Poisson distribution.
- * Source: https://en.wikipedia.org/wiki/Poisson_distribution#Computational_methods													*/ 
-int poisson_generator(double lamda) {
-	double L = exp(-lamda);
-	int k = 0;
-	double p = 1.0;
-
-	do {
-		k++;
-		double u = (double)rand() * scale_factor ;
-		p *= u;
-	} while(p > L);
-
-	return k-1;
-}
\ No newline at end of file
+ * This function generates count Poisson distributed random numbers in batches and stores them, at the appropriate 
+ * indices of the array, bin[]. The values are added to the histogram at the start of bin[], and values within the
+ * counted range are also counted after it, at bin[histogram_size() + value - low]. The parameters are described by 
+ * context, which points to a structure Poisson_Bins. Called by parallel_histogram() for each chunk of numbers.		*/
+void generate_poisson(struct Rng *rng, long long count, unsigned long long *bin, void *context) {
+	const struct Poisson_Bins *params = context;
+	int samples[BATCH_SIZE];		// Stores a batch of Poisson distributed random numbers.
+	long long i;
+	int batch;
+
+	for(i = 0; i < count; i += batch) {
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		fill_poisson(rng, samples, batch, params->lambda);		// Fills samples[] with Poisson distributed random numbers.
+		bin_poisson(params, bin, samples, batch);
+	}
+}
+
+
+/**
+ * This function makes Poisson distributed numbers from the numbers first to first + count - 1 of the Sobol sequence by
+ * inversion and stores them in the array, bin[], like generate_poisson(). The parameters, the sequence and the inversion
+ * table are described by context, which points to a structure Poisson_Bins. Called by parallel_sequence_progress() for
+ * each chunk of numbers. 																						*/
+void quasi_poisson(long long first, long long count, unsigned long long *bin, void *context) {
+	const struct Poisson_Bins *params = context;
+	struct Sobol_Stream stream;
+	int samples[BATCH_SIZE];		// Stores a batch of Poisson distributed quasi-random numbers.
+	long long i;
+	int batch;
+
+	sobol_start(&stream, &params->sobol, first);
+	for(i = 0; i < count; i += batch) {
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		sobol_fill_cdf(&stream, &params->table, samples, batch);
+		bin_poisson(params, bin, samples, batch);
+	}
+}
+
+
+/**
+ * This function adds a batch of numbers to the histogram at the start of bin[], to the counts for the chi-square test
+ * after it and, if they are sketched, to the sketch after those. 												*/
+void bin_poisson(const struct Poisson_Bins *params, unsigned long long *bin, const int *samples, int batch) {
+	unsigned long long *counts = bin + histogram_size(&params->hist);		// Counts for the chi-square test.
+	int j;
+
+	histogram_add_int(&params->hist, bin, samples, batch);
+	if(params->sketched) {
+		sketch_add_int(&params->sketch, counts + params->width, samples, batch);
+	}
+
+	for(j = 0; j < batch; j++) {
+		if(samples[j] >= params->low && samples[j] - params->low < params->width) {
+			counts[samples[j] - params->low]++;
+		}
+	}
+}
+
+
+/**
+ * This function sets up the inversion table of the Poisson distribution with an expected value of lambda. It holds the
+ * values from 40 standard deviations below lambda to 40 above it, outside which the probabilities are too small to be
+ * reached by a number in (0, 1) with 53 bits. 																	*/
+void poisson_table(struct Cdf_Table *table, double lambda) {
+	long first = (long)fmax(0, lambda - 40 * sqrt(lambda) - 50), last = (long)(lambda + 40 * sqrt(lambda) + 50);
+	double *pmf = malloc((last - first + 1) * sizeof(double));
+	long k;
+
+	if(!pmf) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+	for(k = first; k <= last; k++) {
+		pmf[k - first] = poisson_pmf(k, lambda);
+	}
+	cdf_setup(table, pmf, first, (int)(last - first + 1));
+	free(pmf);
+}
+
+
+/**
+ * This function computes the chi-square statistic of the counted values against the exact Poisson probabilities. The 
+ * function takes in the counts of the values from low to low + width - 1, the number of random numbers generated (x) and
+ * lambda. Neighbouring values are pooled until each cell expects at least 5 numbers, and the values outside the counted
+ * range form one more cell. The degrees of freedom are returned in df.											*/ 
+double chi_square_pmf(const unsigned long long *counts, long low, long width, long long x, double lambda, int *df) {
+	double chi_square = 0;
+	double expected = 0, observed = 0;		// Expected and observed numbers in the cell being pooled.
+	double expected_inside = 0, observed_inside = 0;
+	long k;
+
+	*df = -1;
+	for(k = 0; k < width; k++) {
+		expected += x * poisson_pmf(low + k, lambda);
+		observed += counts[k];
+
+		if(expected >= 5) {
+			chi_square += (observed - expected) * (observed - expected) / expected;
+			expected_inside += expected;
+			observed_inside += observed;
+			expected = 0;
+			observed = 0;
+			(*df)++;
+		}
+	}
+
+	// Values outside the pooled cells.
+	expected = x - expected_inside;
+	observed = x - observed_inside;
+	if(expected >= 5) {
+		chi_square += (observed - expected) * (observed - expected) / expected;
+		(*df)++;
+	}
+	return chi_square;
+}
+
+
+/**
+ * This function prints the quantiles and tail masses estimated by the sketch, whose counters are count[], next to the
+ * exact ones of the Poisson distribution with an expected value of lambda. The exact ones are found by adding up the
+ * probabilities of the values from 40 standard deviations below lambda to 40 above it. 						*/
+void report_sketch(const struct Sketch *sketch, const unsigned long long *count, double lambda) {
+	static const double q[] = {1e-6, 1e-4, 1e-3, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999, 1 - 1e-4, 1 - 1e-6};
+	int n = sizeof(q) / sizeof(q[0]);
+	long first = (long)fmax(0, lambda - 40 * sqrt(lambda) - 50), last = (long)(lambda + 40 * sqrt(lambda) + 50);
+	double cdf = 0;
+	long k = first;
+	int i;
+
+	printf("Quantiles from the sketch, to within %g of the distance from lambda:\n", sketch->alpha);
+	printf("%10s %16s %16s\n", "q", "sketch", "exact");
+	for(i = 0; i < n; i++) {
+		// The exact quantile is the smallest value whose cumulative probability reaches q.
+		while(k < last && cdf + poisson_pmf(k, lambda) < q[i]) {
+			cdf += poisson_pmf(k++, lambda);
+		}
+		printf("%10.6f %16.8g %16ld\n", q[i], sketch_quantile(sketch, count, q[i]), k);
+	}
+
+	printf("Tail mass beyond k standard deviations:\n");
+	printf("%4s %14s %14s %14s %14s\n", "k", "below", "exact", "above", "exact");
+	for(i = 1; i <= 6; i++) {
+		double below = 0, above = 0;		// Exact probabilities of the values below lambda - i sd and above lambda + i sd.
+
+		for(k = first; k <= last; k++) {
+			if(k < lambda - i * sqrt(lambda)) {
+				below += poisson_pmf(k, lambda);
+			}
+			else if(k > lambda + i * sqrt(lambda)) {
+				above += poisson_pmf(k, lambda);
+			}
+		}
+		printf("%4d %14.6g %14.6g %14.6g %14.6g\n", i, 1 - sketch_tail(sketch, count, lambda - i * sqrt(lambda)),
+		below, sketch_tail(sketch, count, lambda + i * sqrt(lambda)), above);
+	}
+}
@@ -5,79 +5,191 @@
  * 
  * Written by: Athul Subash Marottikkal - January 2023
  * 
- * Purpose: Generates X random numbers between 0 and 1, and displays the resulting distribution on the terminal.
+ * Purpose: Generates X random numbers between 0 and 1, and displays the resulting distribution on the terminal. Over the
+ * 			default range, [0, 1), the numbers are binned straight from the 64-bit words of the generator with a multiply
+ * 			and a shift, which uses no floating point. With -f, or any other range, they are generated as doubles in
+ * 			[0, 1) with the full precision of a double and then binned. With -Q or -O, the numbers are taken from the
+ * 			quasi-random Sobol sequence instead, which fills the bins far more evenly than random numbers do.
  * 
  * Usage: 
- * 	./Random_Distribution_Generator
- * 	The program will prompt the user to enter the number of random numbers to be generated (x). The program will 
- * 	then generate and plot the distribution of the random numbers.
+ * 	./Random_Distribution_Generator [-n count] [-b bins] [-r low,high] [-f] [-Q | -O] [-o output] [-q | -g]
+ * 	     [seed] [threads]
+ * 	-n - Number of random numbers to be generated (x). If it is not given, the program will prompt the user to enter it.
+ * 	-f - Generate the numbers as doubles before binning them.
+ * 	-b, -r - Number of bins and their range. Default = 100 bins over [0, 1).
+ * 	-Q - Take the numbers from the Sobol sequence instead of the random number generator. The seed is then unused.
+ * 	-O - Take the numbers from the Sobol sequence with Owen scrambling, which is different for each seed.
+ * 	-o - File the histogram is written to. Default = p1_data.txt.
+ * 	-q - Do not plot the histogram.
+ * 	-g - Plot the histogram with gnuplot instead of drawing it on the terminal. On a terminal, the drawing is updated
+ * 	     every half second while the numbers are generated.
+ * 	The seed is optional and defaults to the current time. The same seed always gives the same numbers, whatever the 
+ * 	number of threads. The number of threads is optional and defaults to the number of CPUs.
+ * 	The program will then generate and plot the distribution of the random numbers.
+ * 	(./Random_Distribution_Generator -n 1000000 -b 10 -o uniform.txt -q 42)
+ * 	(./Random_Distribution_Generator -n 1000000 -b 10 -O -q 42)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
- * 	The program uses the rand() function from the stdlib.h library to generate random numbers, and 
- * 	the roundl() function from the math.h library to round the numbers to the nearest bin index. 
- * 	The program also uses the time.h library to seed the random number generator with the current time.
- * 	Include the -lm option at compile time.
- * 	(gcc -o Random_Distribution_Generator Random_Distribution_Generator.c -lm)
+ * 	The program uses histogram_add_uniform() from histogram.h to bin the words of the generator, or the batch uniform
+ * 	sampler, fill_unit(), from sampling.h to generate random numbers, and parallel_histogram() from parallel.h to generate
+ * 	them on several threads. Quasi-random numbers come from sobol.h and are generated with parallel_sequence_progress().
+ * 	Build the sampling library, libsampling.a, first (see sampling.h) and include the -lm and -pthread options at compile
+ * 	time.
+ * 	(gcc -O2 -pthread -o Random_Distribution_Generator Random_Distribution_Generator.c libsampling.a -lm)
  * 
 *******************************************************************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
-#include <math.h>
+#include <unistd.h>
+#include "sampling.h"
+#include "parallel.h"
+#include "histogram.h"
+#include "sobol.h"
 
-int main() {
-	int x = 0;				// Number of random numbers to be generated. 
-	int index = 0;			// Corresponds to the index of the bin.
-    int i = 0;				// Loop counter
-	int bin[100] = {0};		// Initializes an array with the value of all elements set to 0. Used for binning.
-	int bin_size = sizeof(bin) / sizeof(int);		// Stores the size of the array in integers.
+#define BATCH_SIZE 4096		// Number of random numbers generated by each call to fill_unit().
 
-    double scale_factor = 1.0 / (double) RAND_MAX;		// Used to scale the values returned by the rand() function to [0,1].
+// Structure contains the layout of the bins and the Sobol sequence of the quasi-random numbers.
+struct Quasi_Bins
+{
+	struct Histogram hist;
+	struct Sobol sobol;
+};
 
-    srand(time(NULL));		// Seeds the rand() function with the current time.
+void generate_uniform(struct Rng *rng, long long count, unsigned long long *bin, void *context);
+void bin_uniform(struct Rng *rng, long long count, unsigned long long *bin, void *context);
+void quasi_uniform(long long first, long long count, unsigned long long *bin, void *context);
 
-	printf("Enter the number of random numbers to be generated: ");
+int main(int argc, char *argv[]) {
+	long long x = 0;		// Number of random numbers to be generated. 
+	int bins = 100;			// Number of bins. Default = 100.
+	double low = 0, high = 1;		// Range of the bins. Default = [0, 1).
+	const char *output = "p1_data.txt";		// File the histogram is written to.
+	int plot = PLOT_TERMINAL;		// Way the histogram is plotted: PLOT_NONE, PLOT_TERMINAL or PLOT_GNUPLOT.
+	struct Histogram_View view;		// Histogram drawn on the terminal while it is generated.
+	int doubles = 0;		// 1 if the numbers are generated as doubles, else 0.
+	int sequence = SEQUENCE_RANDOM;		// Sequence the numbers are taken from.
+	struct Quasi_Bins quasi;		// Layout of the bins and Sobol sequence. Passed to quasi_uniform().
+	Chunk_Function generate;		// Generates the numbers of a chunk.
+	int option;
+	unsigned long long *bin;		// Used for binning. Holds the underflow, the bins and the overflow.
+	struct Histogram hist;			// Layout of the bins. Passed to generate_uniform().
 
-	// Validates x.
-	while(x <= 0) {
-		scanf("%d", &x); 		// Reads the number of random numbers to be generated and stores it in x.
-		if(x <= 0) {
-			printf("\nError! Enter a positive number: ");
+	// Reads the options.
+	while((option = getopt(argc, argv, "n:b:r:fQOo:qg")) != -1) {
+		switch(option) {
+			case 'n': x = atoll(optarg); break;
+			case 'b': bins = atoi(optarg); break;
+			case 'r': histogram_range_from_arg(optarg, &low, &high); break;
+			case 'f': doubles = 1; break;
+			case 'Q': sequence = (sequence == SEQUENCE_OWEN) ? SEQUENCE_OWEN : SEQUENCE_SOBOL; break;
+			case 'O': sequence = SEQUENCE_OWEN; break;
+			case 'o': output = optarg; break;
+			case 'q': plot = PLOT_NONE; break;
+			case 'g': plot = PLOT_GNUPLOT; break;
+			default:
+				fprintf(stderr, "Usage: %s [-n count] [-b bins] [-r low,high] [-f] [-Q | -O] [-o output] [-q | -g] [seed] "
+				"[threads]\n",
+				argv[0]);
+				exit(-1);
 		}
 	}
 
-	// Loop to generate x random numbers and store them, at the appropriate indices of the array, bin[].
-	for (i = 0; i < x; i++) {
-		index = roundl((rand() * scale_factor) * bin_size); 	/* The value returned by the rand() function is multiplied by the
-																   scale_factor and bin_size, and then rounded and stored in the index */ 
-		bin[index]++;		// The value at this index of the array, bin[], is incremented by 1.
+	uint64_t seed = rng_seed_from_args(argc, argv, optind);		// Seed given on the command line or the current time.
+	int threads = parallel_threads_from_args(argc, argv, optind + 1);	// Number of threads used to generate the numbers.
+
+	// Prompts for the number of random numbers if it was not given on the command line.
+	if(x == 0) {
+		printf("Enter the number of random numbers to be generated: ");
+
+		// Validates x.
+		while(x <= 0) {
+			if(scanf("%lld", &x) != 1) {		// Reads the number of random numbers to be generated and stores it in x.
+				exit(-1);
+			}
+			if(x <= 0) {
+				printf("\nError! Enter a positive number: ");
+			}
+		}
+	}
+	else if(x < 0) {
+		fprintf(stderr, "Error! The number of random numbers must be positive.\n");
+		exit(-1);
 	}
 
-	// Creates file for writing data from the array, bin[].
-	FILE *fp;
-	fp = fopen("p1_data.txt", "w");
+	histogram_setup(&hist, bins, low, high);
+	bin = calloc(histogram_size(&hist), sizeof(unsigned long long));		// All elements are set to 0.
+	if(!bin) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
 
-	// Loop to write values from bin[] to the file.
-	for (i = 0; i < bin_size; i++) {
-		fprintf(fp, "%d\n", bin[i]);
+	// Generates x random numbers on the given number of threads and adds them to bin[]. The words of the generator can only
+	// be binned straight away if the bins cover [0, 1).
+	generate = (doubles || low != 0 || high != 1) ? generate_uniform : bin_uniform;
+	histogram_view_setup(&view, &hist, "Random Number Distribution", x);
+	if(sequence != SEQUENCE_RANDOM) {
+		quasi.hist = hist;
+		sobol_setup(&quasi.sobol, 1, sequence == SEQUENCE_OWEN, seed);
+		parallel_sequence_progress(x, threads, bin, histogram_size(&hist), quasi_uniform, &quasi,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
+	}
+	else {
+		parallel_histogram_progress(x, threads, seed, bin, histogram_size(&hist), generate, &hist,
+		(plot == PLOT_TERMINAL && isatty(STDOUT_FILENO)) ? histogram_redraw : NULL, &view, HISTOGRAM_REDRAW);
 	}
-	fclose(fp);		// Closes file
-
-	// Plots a random number distribution graph on the terminal using gnuplot with the data from the generated file, p1_data.txt.
-	FILE *gnuplot = popen("gnuplot", "w");
-	fprintf(gnuplot, "set term dumb\n");
-	fprintf(gnuplot, "set xlabel 'Bins' \n");
-	fprintf(gnuplot, "set ylabel 'Frequency' \n");
-	fprintf(gnuplot, "set xrange [0:101] \n");
-	fprintf(gnuplot, "set yrange [0:*] \n");
-	fprintf(gnuplot, "set style data histogram \n");
-	fprintf(gnuplot, "set style histogram clustered \n");
-	fprintf(gnuplot, "set key off \n");
-	fprintf(gnuplot, "set title 'Random Number Distribution' \n");
-	fprintf(gnuplot, "plot 'p1_data.txt' \n");
-	pclose(gnuplot);
+
+	// Writes the histogram to the output file and plots a random number distribution graph on the terminal, unless it was
+	// drawn while it was generated.
+	histogram_write(&hist, bin, output);
+	histogram_show(&view, bin, output, plot);
+	free(bin);
 
 	return 0;
 } 	// eod
 
+
+/**
+ * This function generates count random numbers between 0 and 1 and stores them at the appropriate indices of the array,
+ * bin[], whose layout is described by context, which points to a structure Histogram. Called by parallel_histogram()
+ * for each chunk of numbers.																				*/
+void generate_uniform(struct Rng *rng, long long count, unsigned long long *bin, void *context) {
+	double samples[BATCH_SIZE];		// Stores a batch of random numbers.
+	long long i;
+	int batch;
+
+	for (i = 0; i < count; i += batch) {
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		fill_unit(rng, samples, batch);
+		histogram_add(context, bin, samples, batch);		// Adds the numbers to the bins described by context.
+	}
+}
+
+
+/**
+ * This function bins count random numbers between 0 and 1 straight from the words of the generator, in the array, bin[],
+ * whose layout is described by context, which points to a structure Histogram covering [0, 1). Called by
+ * parallel_histogram() for each chunk of numbers.																*/
+void bin_uniform(struct Rng *rng, long long count, unsigned long long *bin, void *context) {
+	histogram_add_uniform(rng, context, bin, count);
+}
+
+
+/**
+ * This function takes the numbers first to first + count - 1 of the Sobol sequence and stores them at the appropriate
+ * indices of the array, bin[]. The layout of the bins and the sequence are described by context, which points to a
+ * structure Quasi_Bins. Called by parallel_sequence_progress() for each chunk of numbers.						*/
+void quasi_uniform(long long first, long long count, unsigned long long *bin, void *context) {
+	struct Quasi_Bins *quasi = context;
+	struct Sobol_Stream stream;
+	double samples[BATCH_SIZE];		// Stores a batch of quasi-random numbers.
+	long long i;
+	int batch;
+
+	sobol_start(&stream, &quasi->sobol, first);
+	for (i = 0; i < count; i += batch) {
+		batch = (count - i < BATCH_SIZE) ? (int)(count - i) : BATCH_SIZE;
+		sobol_fill_unit(&stream, samples, batch);
+		histogram_add(&quasi->hist, bin, samples, batch);
+	}
+}
@@ -0,0 +1,620 @@
+/*******************************************************************************************************************************
+ * Sampler Tests
+ *
+ * Name: Sampler_Tests.c
+ *
+ * Purpose: Checks the samplers of the sampling library, and the job size mixtures of the job generator, against their
+ * 			theoretical distributions, and measures how fast each one generates samples. Each test draws the given number
+ * 			of samples from its own generator stream and runs:
+ * 				1) A chi-square test. Discrete samples are counted by value, and neighbouring values are pooled until each
+ * 				   cell expects at least 5 samples. Continuous samples are counted in CHI_CELLS cells of equal probability,
+ * 				   found with the distribution function.
+ * 				2) A Kolmogorov-Smirnov test. Continuous samples use the first KS_SAMPLES samples, sorted. Discrete samples
+ * 				   use the counts by value, for which the test is conservative.
+ * 				3) Moment tests, which compare the mean and variance with the theoretical ones in units of their standard
+ * 				   errors.
+ * 			A test fails if a p-value is below P_MIN or a moment is more than Z_MAX standard errors off. The tests run in
+ * 			parallel, one test per thread at a time. The speed is the number of samples per second of CPU time spent in
+ * 			the sampler by the test's thread, so it does not depend on the other tests running alongside.
+ *
+ * Usage:
+ * 	./Sampler_Tests [-n samples] [seed] [threads]
+ * 	-n - Number of samples drawn by each test. Default = 10000000.
+ * 	The seed is optional and defaults to the current time. The number of threads is optional and defaults to the number of
+ * 	CPUs. The program prints one line per test and exits with -1 if any test fails.
+ * 	(./Sampler_Tests -n 100000000 42 8)
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Build the sampling library, libsampling.a, first (see sampling.h). Compile workload.c from the scheduling simulator
+ * 	with the program and include the -lm and -pthread options at compile time.
+ * 	(gcc -O2 -pthread -o Sampler_Tests Sampler_Tests.c "../Scheduling Simulator/workload.c" libsampling.a -lm)
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "sampling.h"
+#include "parallel.h"
+#include "../Scheduling Simulator/workload.h"
+
+#define BATCH_SIZE 65536		// Number of samples generated at a time.
+#define CHI_CELLS 1000			// Number of cells of equal probability for continuous samples.
+#define KS_SAMPLES 1000000		// Number of continuous samples used by the Kolmogorov-Smirnov test.
+#define P_MIN 1e-5				// Smallest p-value that passes.
+#define Z_MAX 5.0				// Largest number of standard errors that passes.
+#define MAX_TESTS 16
+
+struct Test;
+
+// Function that fills out[] with n samples for a test.
+typedef void (*Fill_Function)(struct Rng *rng, struct Test *test, double *out, int n);
+
+// Structure contains a test, its theoretical distribution and its results.
+struct Test {
+	const char *name;
+	Fill_Function fill;
+	double a, b;				// Parameters of the distribution.
+	int dice, faces;			// Dice of the dice tests.
+	struct Alias_Table table;	// Alias table of the alias test.
+	struct Workload workload;	// Mixture of the mixture tests.
+	double (*cdf)(const struct Test *test, double x);	// Distribution function of continuous samples, else NULL.
+	double *pmf;				// Probabilities of the values 0 to values - 1 of discrete samples.
+	int values;
+	double mean, variance;		// Theoretical mean and variance.
+
+	// Results.
+	double rate;				// Samples per second of CPU time.
+	double chi_square, chi_p;
+	int df;
+	double ks_d, ks_p;
+	double z_mean, z_variance;
+	int failed;
+};
+
+// Structure contains the tests shared by the threads.
+struct Test_Pool {
+	struct Test *tests;
+	int count;
+	int next;					// Index of the next test to run.
+	long long samples;
+	uint64_t seed;
+	pthread_mutex_t lock;
+};
+
+int Setup_Tests(struct Test *tests);
+void *Run_Tests(void *arg);
+void Run_Test(struct Test *test, long long samples, struct Rng *rng);
+double chi_square_p(double chi_square, int df);
+double ks_p(double d, double n);
+double thread_seconds(void);
+int compare_doubles(const void *a, const void *b);
+
+void Fill_Uniform(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Unit(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Die(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Dice_Sums(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Alias(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Normal(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Normal_Scalar(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Exponential(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Poisson(struct Rng *rng, struct Test *test, double *out, int n);
+void Fill_Mixture(struct Rng *rng, struct Test *test, double *out, int n);
+double Uniform_Cdf(const struct Test *test, double x);
+double Normal_Cdf(const struct Test *test, double x);
+double Exponential_Cdf(const struct Test *test, double x);
+double Mixture_Cdf(const struct Test *test, double x);
+
+int main(int argc, char *argv[]) {
+	long long samples = 10000000;		// Number of samples drawn by each test.
+	struct Test tests[MAX_TESTS];
+	struct Test_Pool pool;
+	pthread_t *workers;
+	int option, count, threads, t, failed = 0;
+
+	// Reads the options.
+	while((option = getopt(argc, argv, "n:")) != -1) {
+		switch(option) {
+			case 'n': samples = atoll(optarg); break;
+			default:
+				fprintf(stderr, "Usage: %s [-n samples] [seed] [threads]\n", argv[0]);
+				exit(-1);
+		}
+	}
+	if(samples < 100) {
+		fprintf(stderr, "Error! Each test needs at least 100 samples.\n");
+		exit(-1);
+	}
+
+	pool.seed = rng_seed_from_args(argc, argv, optind);		// Seed given on the command line or the current time.
+	threads = parallel_threads_from_args(argc, argv, optind + 1);	// Number of tests run at the same time.
+
+	count = Setup_Tests(tests);
+	pool.tests = tests;
+	pool.count = count;
+	pool.next = 0;
+	pool.samples = samples;
+	pthread_mutex_init(&pool.lock, NULL);
+
+	// Runs the tests on the given number of threads.
+	if(threads > count) {
+		threads = count;
+	}
+	workers = malloc(threads * sizeof(pthread_t));
+	if(!workers) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+	for(t = 0; t < threads; t++) {
+		if(pthread_create(&workers[t], NULL, Run_Tests, &pool) != 0) {
+			perror("Error! Cannot create thread!");
+			exit(-1);
+		}
+	}
+	for(t = 0; t < threads; t++) {
+		pthread_join(workers[t], NULL);
+	}
+	free(workers);
+
+	// Prints the results.
+	printf("%-30s %10s %23s %19s %8s %8s  %s\n", "Sampler", "M/s", "Chi-square (df) p", "KS D p", "z mean", "z var",
+	"Result");
+	for(t = 0; t < count; t++) {
+		struct Test *test = &tests[t];
+
+		printf("%-30s %10.1f %10.1f (%4d) %5.3f %11.2e %7.3f %8.2f %8.2f  %s\n", test->name, test->rate / 1e6,
+		test->chi_square, test->df, test->chi_p, test->ks_d, test->ks_p, test->z_mean, test->z_variance,
+		test->failed ? "FAIL" : "pass");
+		failed += test->failed;
+		if(test->fill == Fill_Alias) {
+			alias_free(&test->table);
+		}
+		free(test->pmf);
+	}
+	printf("%d of %d tests failed\n", failed, count);
+
+	return failed ? -1 : 0;
+}	// eod
+
+
+/**
+ * This function sets up the tests in tests[] and returns their number. 									*/
+int Setup_Tests(struct Test *tests) {
+	struct Test *test;
+	int count = 0, k, m;
+
+	// Every field starts at 0 or NULL.
+	for(k = 0; k < MAX_TESTS; k++) {
+		struct Test empty = {0};
+		tests[k] = empty;
+	}
+
+	test = &tests[count++];
+	test->name = "uniform fill_uniform";
+	test->fill = Fill_Uniform;
+	test->cdf = Uniform_Cdf;
+	test->mean = 0.5;
+	test->variance = 1.0 / 12;
+
+	test = &tests[count++];
+	test->name = "uniform fill_unit";
+	test->fill = Fill_Unit;
+	test->cdf = Uniform_Cdf;
+	test->mean = 0.5;
+	test->variance = 1.0 / 12;
+
+	// Dice. The values are the sums themselves, so the table starts at 0. The alias table is built from dice_pmf(), so
+	// 10d20 is also rolled one by one to test dice_pmf() itself.
+	for(k = 0; k < 4; k++) {
+		static const char *names[] = {"dice 1d6 fill_dice", "dice 2d6 fill_dice_sums", "dice 10d20 fill_dice_sums",
+		                              "dice 10d20 fill_alias"};
+		static const int dice[] = {1, 2, 10, 10}, faces[] = {6, 6, 20, 20};
+		static const Fill_Function fill[] = {Fill_Die, Fill_Dice_Sums, Fill_Dice_Sums, Fill_Alias};
+
+		test = &tests[count++];
+		test->name = names[k];
+		test->fill = fill[k];
+		test->dice = dice[k];
+		test->faces = faces[k];
+		test->values = dice[k] * faces[k] + 1;
+		test->pmf = calloc(test->values, sizeof(double));
+		if(!test->pmf) {
+			perror("Error! Cannot allocate memory!");
+			exit(-1);
+		}
+		dice_pmf(dice[k], faces[k], test->pmf + dice[k]);
+		if(fill[k] == Fill_Alias) {
+			alias_setup(&test->table, test->pmf + dice[k], dice[k] * (faces[k] - 1) + 1);
+		}
+	}
+
+	test = &tests[count++];
+	test->name = "normal fill_normal";
+	test->fill = Fill_Normal;
+	test->cdf = Normal_Cdf;
+	test->a = 0;
+	test->b = 1;
+
+	test = &tests[count++];
+	test->name = "normal fill_normal_scalar";
+	test->fill = Fill_Normal_Scalar;
+	test->cdf = Normal_Cdf;
+	test->a = 0;
+	test->b = 1;
+
+	test = &tests[count++];
+	test->name = "exponential fill_exponential";
+	test->fill = Fill_Exponential;
+	test->cdf = Exponential_Cdf;
+	test->a = 1;
+
+	// Poisson with the inversion table, and with PTRS for a moderate and a large lambda.
+	for(k = 0; k < 3; k++) {
+		static const char *names[] = {"Poisson 3 fill_poisson", "Poisson 100 fill_poisson", "Poisson 10000 fill_poisson"};
+		static const double lambda[] = {3, 100, 10000};
+
+		test = &tests[count++];
+		test->name = names[k];
+		test->fill = Fill_Poisson;
+		test->a = lambda[k];
+		test->values = (int)(lambda[k] + 12 * sqrt(lambda[k]) + 30);
+		test->pmf = malloc(test->values * sizeof(double));
+		if(!test->pmf) {
+			perror("Error! Cannot allocate memory!");
+			exit(-1);
+		}
+		for(m = 0; m < test->values; m++) {
+			test->pmf[m] = poisson_pmf(m, lambda[k]);
+		}
+	}
+
+	// The three built-in mixtures of the job generator.
+	for(k = 0; k < NO_OF_MIXTURES; k++) {
+		static const char *names[] = {"job sizes mixture 1", "job sizes mixture 2", "job sizes mixture 3"};
+
+		test = &tests[count++];
+		test->name = names[k];
+		test->fill = Fill_Mixture;
+		test->cdf = Mixture_Cdf;
+		Default_Workload(k, &test->workload);
+	}
+
+	// Moments of the distributions that were not given above.
+	for(k = 0; k < count; k++) {
+		test = &tests[k];
+
+		if(test->pmf) {
+			for(m = 0; m < test->values; m++) {
+				test->mean += m * test->pmf[m];
+			}
+			for(m = 0; m < test->values; m++) {
+				test->variance += (m - test->mean) * (m - test->mean) * test->pmf[m];
+			}
+		}
+		else if(test->cdf == Normal_Cdf) {
+			test->mean = test->a;
+			test->variance = test->b * test->b;
+		}
+		else if(test->cdf == Exponential_Cdf) {
+			test->mean = test->a;
+			test->variance = test->a * test->a;
+		}
+		else if(test->cdf == Mixture_Cdf) {
+			double total = 0, second = 0;		// Total weight and second moment about 0.
+
+			for(m = 0; m < test->workload.components; m++) {
+				const struct Component *component = &test->workload.component[m];
+
+				total += component->weight;
+				test->mean += component->weight * component->size.a;
+				second += component->weight * (component->size.b * component->size.b + component->size.a * component->size.a);
+			}
+			test->mean /= total;
+			test->variance = second / total - test->mean * test->mean;
+		}
+	}
+	return count;
+}
+
+
+/**
+ * This function runs tests from the pool until none are left. Test t uses stream t of the generator, so each test gives
+ * the same results whichever thread runs it. Runs on each thread. 											*/
+void *Run_Tests(void *arg) {
+	struct Test_Pool *pool = arg;
+	struct Rng rng;
+	int t;
+
+	for(;;) {
+		pthread_mutex_lock(&pool->lock);
+		t = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+
+		if(t >= pool->count) {
+			return NULL;
+		}
+		rng_stream(&rng, pool->seed, t);
+		Run_Test(&pool->tests[t], pool->samples, &rng);
+	}
+}
+
+
+/**
+ * This function draws the given number of samples for the test and computes its results. 					*/
+void Run_Test(struct Test *test, long long samples, struct Rng *rng) {
+	double *batch = malloc(BATCH_SIZE * sizeof(double));
+	int ks_count = (samples < KS_SAMPLES) ? (int)samples : KS_SAMPLES;
+	double *ks = malloc(ks_count * sizeof(double));		// First samples, for the Kolmogorov-Smirnov test.
+	int cells = test->pmf ? test->values : CHI_CELLS;
+	unsigned long long *counts = calloc(cells + 1, sizeof(unsigned long long));		// The last cell counts values past the table.
+	long double sum = 0, sum2 = 0, sum4 = 0;		// Powers of the differences from the theoretical mean.
+	double seconds = 0, n = (double)samples;
+	double mean, variance, expected, observed, expected_left, observed_left;
+	long long i;
+	int j, k, size;
+
+	if(!batch || !ks || !counts) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+
+	for(i = 0; i < samples; i += size) {
+		double start, s1 = 0, s2 = 0, s4 = 0;
+
+		size = (samples - i < BATCH_SIZE) ? (int)(samples - i) : BATCH_SIZE;
+		start = thread_seconds();
+		test->fill(rng, test, batch, size);
+		seconds += thread_seconds() - start;
+
+		for(j = 0; j < size; j++) {
+			double d = batch[j] - test->mean;
+
+			s1 += d;
+			s2 += d * d;
+			s4 += d * d * d * d;
+
+			// Discrete samples are counted by value, continuous ones by the cell of equal probability they fall in.
+			if(test->pmf) {
+				k = (batch[j] >= 0 && batch[j] < test->values) ? (int)batch[j] : test->values;
+			}
+			else {
+				k = (int)(test->cdf(test, batch[j]) * CHI_CELLS);
+				k = (k < 0) ? 0 : (k >= CHI_CELLS) ? CHI_CELLS - 1 : k;
+			}
+			counts[k]++;
+		}
+		sum += s1;
+		sum2 += s2;
+		sum4 += s4;
+
+		for(j = 0; i + j < ks_count && j < size; j++) {
+			ks[i + j] = batch[j];
+		}
+	}
+	test->rate = (seconds > 0) ? n / seconds : 0;
+
+	// Moment tests. The variance of the sample variance is estimated from the fourth moment.
+	mean = (double)(sum / n);
+	variance = (double)(sum2 / n) - mean * mean;
+	test->z_mean = mean / sqrt(test->variance / n);
+	test->z_variance = (variance - test->variance) / sqrt(((double)(sum4 / n) - test->variance * test->variance) / n);
+
+	// Chi-square test. Cells that expect fewer than 5 samples are pooled with the next ones, and what is left at the end with
+	// the last full cell.
+	test->chi_square = 0;
+	test->df = -1;
+	expected = observed = expected_left = observed_left = 0;
+	for(k = 0; k <= cells; k++) {
+		double p = (!test->pmf) ? ((k < cells) ? 1.0 / CHI_CELLS : 0) : (k < cells) ? test->pmf[k] : 0;
+
+		expected += n * p;
+		observed += counts[k];
+		if(expected >= 5) {
+			expected_left = expected;
+			observed_left = observed;
+			test->chi_square += (observed - expected) * (observed - expected) / expected;
+			test->df++;
+			expected = observed = 0;
+		}
+	}
+	if(observed > 0 || expected > 0) {
+		test->chi_square -= (observed_left - expected_left) * (observed_left - expected_left) / expected_left;
+		expected += expected_left;
+		observed += observed_left;
+		test->chi_square += (observed - expected) * (observed - expected) / expected;
+	}
+	test->chi_p = chi_square_p(test->chi_square, test->df);
+
+	// Kolmogorov-Smirnov test.
+	test->ks_d = 0;
+	if(test->pmf) {
+		double cdf = 0, empirical = 0;
+
+		for(k = 0; k < test->values; k++) {
+			cdf += test->pmf[k];
+			empirical += counts[k] / n;
+			test->ks_d = fmax(test->ks_d, fabs(empirical - cdf));
+		}
+		test->ks_p = ks_p(test->ks_d, n);
+	}
+	else {
+		qsort(ks, ks_count, sizeof(double), compare_doubles);
+		for(j = 0; j < ks_count; j++) {
+			double cdf = test->cdf(test, ks[j]);
+
+			test->ks_d = fmax(test->ks_d, fmax((j + 1.0) / ks_count - cdf, cdf - (double)j / ks_count));
+		}
+		test->ks_p = ks_p(test->ks_d, ks_count);
+	}
+
+	test->failed = test->chi_p < P_MIN || test->ks_p < P_MIN || fabs(test->z_mean) > Z_MAX || fabs(test->z_variance) > Z_MAX;
+
+	free(batch);
+	free(ks);
+	free(counts);
+}
+
+
+/**
+ * This function returns the probability that a chi-square statistic with df degrees of freedom is at least chi_square,
+ * using the Wilson-Hilferty approximation, which is accurate to a few per cent of the p-value from about 10 degrees of
+ * freedom. 																									*/
+double chi_square_p(double chi_square, int df) {
+	double z;
+
+	if(df < 1) {
+		return 1;
+	}
+	z = (cbrt(chi_square / df) - (1 - 2.0 / (9 * df))) / sqrt(2.0 / (9 * df));
+	return 0.5 * erfc(z / sqrt(2.0));
+}
+
+
+/**
+ * This function returns the probability that the Kolmogorov-Smirnov distance of n samples is at least d, from the
+ * asymptotic Kolmogorov distribution with Stephens' correction for finite n. 								*/
+double ks_p(double d, double n) {
+	double lambda = (sqrt(n) + 0.12 + 0.11 / sqrt(n)) * d;
+	double p = 0, sign = 2;
+	int j;
+
+	if(lambda < 0.2) {
+		return 1;
+	}
+	for(j = 1; j <= 100; j++) {
+		double term = sign * exp(-2 * j * j * lambda * lambda);
+
+		p += term;
+		if(fabs(term) < 1e-12) {
+			break;
+		}
+		sign = -sign;
+	}
+	return (p < 0) ? 0 : (p > 1) ? 1 : p;
+}
+
+
+/**
+ * This function returns the CPU time used by the calling thread, in seconds. 								*/
+double thread_seconds(void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+/**
+ * This function compares two doubles for qsort(). 															*/
+int compare_doubles(const void *a, const void *b) {
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+
+/**
+ * The functions below fill out[] with n samples for a test. Integer samples are stored as doubles. 			*/
+void Fill_Uniform(struct Rng *rng, struct Test *test, double *out, int n) {
+	(void)test;		// Every fill function takes the test; the uniform ones have no parameters.
+	fill_uniform(rng, out, n, 0, 1);
+}
+
+void Fill_Unit(struct Rng *rng, struct Test *test, double *out, int n) {
+	(void)test;
+	fill_unit(rng, out, n);
+}
+
+void Fill_Die(struct Rng *rng, struct Test *test, double *out, int n) {
+	int *rolls = (int *)out;		// The rolls fill the first half of out[] and are widened from the end.
+
+	fill_dice(rng, rolls, n, test->faces);
+	while(n-- > 0) {
+		out[n] = rolls[n];
+	}
+}
+
+void Fill_Dice_Sums(struct Rng *rng, struct Test *test, double *out, int n) {
+	int *sums = (int *)out;
+
+	fill_dice_sums(rng, sums, n, test->dice, test->faces);
+	while(n-- > 0) {
+		out[n] = sums[n];
+	}
+}
+
+void Fill_Alias(struct Rng *rng, struct Test *test, double *out, int n) {
+	int *sums = (int *)out;
+
+	fill_alias(rng, &test->table, sums, n);
+	while(n-- > 0) {
+		out[n] = sums[n] + test->dice;
+	}
+}
+
+void Fill_Normal(struct Rng *rng, struct Test *test, double *out, int n) {
+	fill_normal(rng, out, n, test->a, test->b);
+}
+
+void Fill_Normal_Scalar(struct Rng *rng, struct Test *test, double *out, int n) {
+	fill_normal_scalar(rng, out, n, test->a, test->b);
+}
+
+void Fill_Exponential(struct Rng *rng, struct Test *test, double *out, int n) {
+	fill_exponential(rng, out, n, test->a);
+}
+
+void Fill_Poisson(struct Rng *rng, struct Test *test, double *out, int n) {
+	int *values = (int *)out;
+
+	fill_poisson(rng, values, n, test->a);
+	while(n-- > 0) {
+		out[n] = values[n];
+	}
+}
+
+// The job sizes come from Generate_Jobs(), so the arrival times are generated and timed too.
+void Fill_Mixture(struct Rng *rng, struct Test *test, double *out, int n) {
+	double *arrival = malloc(n * sizeof(double));
+
+	if(!arrival) {
+		perror("Error! Cannot allocate memory!");
+		exit(-1);
+	}
+	test->workload.jobs = n;
+	Generate_Jobs(rng, &test->workload, out, arrival);
+	free(arrival);
+}
+
+
+/**
+ * The functions below return the theoretical distribution function of a test at x. 							*/
+double Uniform_Cdf(const struct Test *test, double x) {
+	(void)test;
+	return (x < 0) ? 0 : (x > 1) ? 1 : x;
+}
+
+double Normal_Cdf(const struct Test *test, double x) {
+	return 0.5 * erfc((test->a - x) / (test->b * sqrt(2.0)));
+}
+
+double Exponential_Cdf(const struct Test *test, double x) {
+	return (x < 0) ? 0 : -expm1(-x / test->a);
+}
+
+// Only the normal components of the built-in mixtures are needed.
+double Mixture_Cdf(const struct Test *test, double x) {
+	double total = 0, cdf = 0;
+	int k;
+
+	for(k = 0; k < test->workload.components; k++) {
+		const struct Component *component = &test->workload.component[k];
+
+		total += component->weight;
+		cdf += component->weight * 0.5 * erfc((component->size.a - x) / (component->size.b * sqrt(2.0)));
+	}
+	return cdf / total;
+}
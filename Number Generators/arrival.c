@@ -0,0 +1,147 @@
+/*******************************************************************************************************************************
+ * Arrival Processes
+ *
+ * Name: arrival.c
+ *
+ * Purpose: Batch generators for the arrival processes declared in arrival.h. The exponential gaps are drawn ARRIVAL_BATCH at a
+ *          time with fill_exponential() from sampling.h and then added up. The MMPP
+ *          relies on the gaps being memoryless: a gap that runs past the end of a state is dropped, and the next state
+ *          starts afresh at the time the old one ended.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include "arrival.h"
+#include "sampling.h"
+
+#define ARRIVAL_BATCH 1024      // Number of gaps drawn at a time.
+
+static double mmpp_sojourn(struct Rng *rng, const struct Mmpp *mmpp, int state);
+
+
+/**
+ * This function fills out[] with the first n arrival times of a Poisson process with the given rate. 		*/
+void fill_poisson_arrivals(struct Rng *rng, double *out, size_t n, double rate)
+{
+    double t = 0;
+    size_t i;
+
+    fill_exponential(rng, out, n, 1 / rate);      // Time between arrivals.
+    for(i = 0; i < n; i++)
+    {
+        t += out[i];
+        out[i] = t;
+    }
+}
+
+
+/**
+ * This function fills out[] with the first n arrival times of the Markov-modulated Poisson process, mmpp. The first state
+ * is chosen with the probability of finding the process in it, which is proportional to its mean duration. 	*/
+void fill_mmpp_arrivals(struct Rng *rng, double *out, size_t n, const struct Mmpp *mmpp)
+{
+    double gaps[ARRIVAL_BATCH];     // Gaps of a Poisson process with rate 1, scaled by the rate of the state.
+    double total = 0;
+    double u, t = 0, end;
+    int state;
+    size_t i = 0;
+    int j;
+
+    for(state = 0; state < mmpp->states; state++) {
+        total += mmpp->duration[state];
+    }
+    u = rng_uniform(rng) * total;
+    for(state = 0; state < mmpp->states - 1 && u >= mmpp->duration[state]; state++) {
+        u -= mmpp->duration[state];
+    }
+    end = mmpp_sojourn(rng, mmpp, state);
+
+    while(i < n)
+    {
+        fill_exponential(rng, gaps, ARRIVAL_BATCH, 1.0);
+
+        for(j = 0; j < ARRIVAL_BATCH && i < n; j++)
+        {
+            double rate = mmpp->rate[state];
+
+            if(rate > 0 && t + gaps[j] / rate < end)
+            {
+                t += gaps[j] / rate;
+                out[i++] = t;
+            }
+
+            // The state ends before the next arrival. Moves to one of the other states.
+            else
+            {
+                t = end;
+                if(mmpp->states > 1)
+                {
+                    int next = (int)rng_bounded(rng, mmpp->states - 1);
+                    state = (next >= state) ? next + 1 : next;
+                }
+                end = t + mmpp_sojourn(rng, mmpp, state);
+            }
+        }
+    }
+}
+
+
+/**
+ * This function fills out[] with the first n arrival times of a Poisson process whose rate follows a daily cycle,
+ * rate * (1 + amplitude * sin(2 pi t / period)), with amplitude between 0 and 1. Arrivals of a Poisson process at the peak
+ * rate are kept with probability equal to the current rate divided by the peak rate. 						*/
+void fill_diurnal_arrivals(struct Rng *rng, double *out, size_t n, double rate, double amplitude, double period)
+{
+    double gaps[ARRIVAL_BATCH];     // Gaps of a Poisson process at the peak rate.
+    double peak = rate * (1 + amplitude);
+    double omega = 2 * M_PI / period;
+    double t = 0;
+    size_t i = 0;
+    int j;
+
+    while(i < n)
+    {
+        fill_exponential(rng, gaps, ARRIVAL_BATCH, 1 / peak);
+
+        for(j = 0; j < ARRIVAL_BATCH && i < n; j++)
+        {
+            double u = rng_uniform(rng) * (1 + amplitude);
+
+            // Arrivals below the lowest rate are always kept, which saves computing the sine for many of them.
+            t += gaps[j];
+            if(u < 1 - amplitude || u < 1 + amplitude * sin(omega * t)) {
+                out[i++] = t;
+            }
+        }
+    }
+}
+
+
+/**
+ * This function returns the long-run arrival rate of the MMPP. Every state is visited equally often, so the share of time
+ * spent in each state is proportional to its mean duration. 												*/
+double mmpp_mean_rate(const struct Mmpp *mmpp)
+{
+    double arrivals = 0, time = 0;
+    int state;
+
+    for(state = 0; state < mmpp->states; state++)
+    {
+        arrivals += mmpp->rate[state] * mmpp->duration[state];
+        time += mmpp->duration[state];
+    }
+    return arrivals / time;
+}
+
+
+/**
+ * This function returns the length of one visit to the state, which is exponentially distributed. 		*/
+static double mmpp_sojourn(struct Rng *rng, const struct Mmpp *mmpp, int state)
+{
+    double length;
+
+    fill_exponential(rng, &length, 1, mmpp->duration[state]);
+    return length;
+}
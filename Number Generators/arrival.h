@@ -0,0 +1,42 @@
+/*******************************************************************************************************************************
+ * Arrival Processes
+ *
+ * Name: arrival.h
+ *
+ * Purpose: Batch generators that fill a caller-provided array with increasing arrival times from a point process:
+ *              1) A homogeneous Poisson process with a fixed rate.
+ *              2) A Markov-modulated Poisson process (MMPP), which stays in each state for an exponentially distributed time
+ *                 with the state's mean duration and generates arrivals at the state's rate meanwhile. On leaving a state
+ *                 it moves to one of the other states with equal probability, so two states with a high and a low rate
+ *                 give bursts of arrivals separated by quiet periods.
+ *              3) A non-homogeneous Poisson process with a daily cycle, whose rate is rate * (1 + amplitude * sin(2 pi t /
+ *                 period)), generated by thinning a Poisson process at the peak rate.
+ *          Rates are in arrivals per unit of time. The first arrival time is measured from 0.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Part of the sampling library, libsampling.a (see sampling.h).
+ *
+*******************************************************************************************************************************/
+#ifndef ARRIVAL_H
+#define ARRIVAL_H
+
+#include <stddef.h>
+#include "rng.h"
+
+#define MAX_STATES 8        // Largest number of states of an MMPP.
+
+// Structure contains the states of a Markov-modulated Poisson process.
+struct Mmpp
+{
+    int states;
+    double rate[MAX_STATES];        // Arrival rate in each state.
+    double duration[MAX_STATES];    // Mean time spent in each state on each visit.
+};
+
+void fill_poisson_arrivals(struct Rng *rng, double *out, size_t n, double rate);
+void fill_mmpp_arrivals(struct Rng *rng, double *out, size_t n, const struct Mmpp *mmpp);
+void fill_diurnal_arrivals(struct Rng *rng, double *out, size_t n, double rate, double amplitude, double period);
+double mmpp_mean_rate(const struct Mmpp *mmpp);
+
+#endif
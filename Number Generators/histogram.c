@@ -0,0 +1,270 @@
+/*******************************************************************************************************************************
+ * Histogram Engine
+ *
+ * Name: histogram.c
+ *
+ * Purpose: Binning, output and plotting functions for the histograms declared in histogram.h. The terminal drawing shows
+ *          up to HISTOGRAM_COLUMNS bars; with more bins than that, neighbouring bins are grouped and each bar shows their
+ *          mean count. A redraw moves the cursor back up over the last drawing with ANSI escape codes, so it should only be
+ *          used on a terminal.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include "histogram.h"
+
+
+/**
+ * This function sets up a histogram with the given number of bins over [low, high). The program exits with an error
+ * message if the layout is invalid. 																		*/
+void histogram_setup(struct Histogram *hist, int bins, double low, double high)
+{
+    if(bins < 1 || !(high > low))
+    {
+        fprintf(stderr, "Error! A histogram needs at least one bin and a range with high above low.\n");
+        exit(-1);
+    }
+    hist->bins = bins;
+    hist->low = low;
+    hist->high = high;
+    hist->scale = bins / (high - low);
+}
+
+
+/**
+ * This function adds the n samples in x[] to the counters, count[]. The scaled sample is clamped to [-1, bins] before it
+ * is converted, so samples below low land in count[0], samples at or above high in count[bins + 1], and NaN counts as an
+ * underflow. 																								*/
+void histogram_add(const struct Histogram *hist, unsigned long long *count, const double *x, size_t n)
+{
+    const double top = hist->bins;
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        double t = (x[i] - hist->low) * hist->scale;
+
+        t = (t > -1.0) ? t : -1.0;      // Compiled to max and min instructions, with NaN taken as -1.
+        t = (t < top) ? t : top;
+        count[(int)(t + 1.0)]++;
+    }
+}
+
+
+/**
+ * This function adds the n integer samples in x[] to the counters, count[]. 									*/
+void histogram_add_int(const struct Histogram *hist, unsigned long long *count, const int *x, size_t n)
+{
+    const double top = hist->bins;
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        double t = (x[i] - hist->low) * hist->scale;
+
+        t = (t > -1.0) ? t : -1.0;      // Compiled to max and min instructions, with NaN taken as -1.
+        t = (t < top) ? t : top;
+        count[(int)(t + 1.0)]++;
+    }
+}
+
+
+/**
+ * This function adds n samples that are uniform over the range of the histogram to the counters, count[], without
+ * generating them. Each word from the generator is taken as the fraction word / 2^64 of the range, and its bin is the
+ * top half of word * bins, a multiply and a shift, so no floating point is used and the index is always in range. The
+ * bins are equally likely to within bins / 2^64. 																*/
+void histogram_add_uniform(struct Rng *rng, const struct Histogram *hist, unsigned long long *count, long long n)
+{
+    unsigned long long *bin = count + 1;        // Skips the underflow counter, which is never used.
+    uint64_t bins = hist->bins;
+    long long i;
+
+    for(i = 0; i < n; i++) {
+        bin[((__uint128_t)rng_next(rng) * bins) >> 64]++;
+    }
+}
+
+
+/**
+ * This function writes the histogram to the file at path. The range, underflow and overflow are written as comment lines,
+ * followed by one line per bin with the start of the bin and its count. 										*/
+void histogram_write(const struct Histogram *hist, const unsigned long long *count, const char *path)
+{
+    FILE *fout = fopen(path, "w");
+    int i;
+
+    // Prints an error message and exits the program if the output file cannot be opened.
+    if(!fout)
+    {
+        perror("Error! Cannot open output file!");
+        exit(-1);
+    }
+
+    fprintf(fout, "# bins %d low %.17g high %.17g\n", hist->bins, hist->low, hist->high);
+    fprintf(fout, "# underflow %llu\n", count[0]);
+    fprintf(fout, "# overflow %llu\n", count[hist->bins + 1]);
+    for(i = 1; i <= hist->bins; i++) {
+        fprintf(fout, "%.10g %llu\n", hist->low + (i - 1) / hist->scale, count[i]);
+    }
+    fclose(fout);
+}
+
+
+/**
+ * This function plots the histogram written to the file at path on the terminal using gnuplot. It returns 0 if gnuplot ran,
+ * or -1 if it could not be started or failed. 																*/
+int histogram_plot(const struct Histogram *hist, const char *path, const char *title)
+{
+    void (*old_handler)(int) = signal(SIGPIPE, SIG_IGN);       // A missing gnuplot must not stop the program.
+    FILE *gnuplot = popen("gnuplot 2>/dev/null", "w");
+    int status;
+
+    if(!gnuplot)
+    {
+        signal(SIGPIPE, old_handler);
+        return -1;
+    }
+    fprintf(gnuplot, "set term dumb\n");
+    fprintf(gnuplot, "set xlabel 'Bins' \n");
+    fprintf(gnuplot, "set ylabel 'Frequency' \n");
+    fprintf(gnuplot, "set xrange [%g:%g] \n", hist->low, hist->high);
+    fprintf(gnuplot, "set yrange [0:*] \n");
+    fprintf(gnuplot, "set boxwidth %g \n", 1 / hist->scale);
+    fprintf(gnuplot, "set key off \n");
+    fprintf(gnuplot, "set title '%s' \n", title);
+    fprintf(gnuplot, "plot '%s' using ($1 + %g):2 with boxes\n", path, 0.5 / hist->scale);
+    status = pclose(gnuplot);
+    signal(SIGPIPE, old_handler);
+
+    return (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+
+/**
+ * This function draws the histogram from its counters, count[], on out, with the title above it and the underflow and
+ * overflow below it. If redraw is not 0, the drawing replaces the last one, which must have been drawn just before. 	*/
+void histogram_draw(FILE *out, const struct Histogram *hist, const unsigned long long *count, const char *title, int redraw)
+{
+    int group = (hist->bins + HISTOGRAM_COLUMNS - 1) / HISTOGRAM_COLUMNS;      // Number of bins in each bar.
+    int bars = (hist->bins + group - 1) / group;
+    int width = HISTOGRAM_COLUMNS / bars;           // Width of each bar, in characters.
+    const char *end = redraw ? "\033[K\n" : "\n";   // Clears what is left of the last drawing on each line.
+    double height[HISTOGRAM_COLUMNS];               // Mean count of the bins in each bar.
+    double top = 0;
+    char low[32], high[32];
+    int bar, row, i, pad;
+
+    for(bar = 0; bar < bars; bar++)
+    {
+        int first = bar * group;
+        int last = (first + group < hist->bins) ? first + group : hist->bins;
+        double total = 0;
+
+        for(i = first; i < last; i++) {
+            total += count[i + 1];
+        }
+        height[bar] = total / (last - first);
+        top = (height[bar] > top) ? height[bar] : top;
+    }
+
+    if(redraw) {
+        fprintf(out, "\033[%dA\r", HISTOGRAM_ROWS + 4);
+    }
+    pad = 14 + (bars * width - (int)strlen(title)) / 2;
+    fprintf(out, "%*s%s%s", (pad > 0) ? pad : 0, "", title, end);
+
+    // Each line holds the bars that reach at least half way into it. The count is shown at the top, middle and bottom.
+    for(row = HISTOGRAM_ROWS; row >= 1; row--)
+    {
+        if(row == HISTOGRAM_ROWS || row == HISTOGRAM_ROWS / 2) {
+            fprintf(out, "%12.0f |", top * row / HISTOGRAM_ROWS);
+        }
+        else {
+            fprintf(out, "%12s |", "");
+        }
+        for(bar = 0; bar < bars; bar++)
+        {
+            int filled = top > 0 && height[bar] * HISTOGRAM_ROWS / top >= row - 0.5;
+
+            for(i = 0; i < width; i++) {
+                fputc(filled ? '#' : ' ', out);
+            }
+        }
+        fputs(end, out);
+    }
+
+    fprintf(out, "%12d +", 0);
+    for(i = 0; i < bars * width; i++) {
+        fputc('-', out);
+    }
+    fputs(end, out);
+
+    snprintf(low, sizeof(low), "%g", hist->low);
+    snprintf(high, sizeof(high), "%g", hist->high);
+    fprintf(out, "%14s%-*s%s%s", "", bars * width - (int)strlen(high), low, high, end);
+    fprintf(out, "%14s%llu below %s, %llu above %s%s", "", count[0], low, count[hist->bins + 1], high, end);
+}
+
+
+/**
+ * This function sets up a view for drawing the histogram on the terminal while the given total number of samples is
+ * generated. 																								*/
+void histogram_view_setup(struct Histogram_View *view, const struct Histogram *hist, const char *title, long long total)
+{
+    view->hist = hist;
+    view->title = title;
+    view->total = total;
+    view->drawn = 0;
+}
+
+
+/**
+ * This function draws the histogram from the first done samples on the terminal, in place of the last drawing. It is a
+ * Progress_Function (see parallel.h), with a structure Histogram_View as its context. 							*/
+void histogram_redraw(const unsigned long long *count, long long done, void *context)
+{
+    struct Histogram_View *view = context;
+    char title[256];
+
+    snprintf(title, sizeof(title), "%s (%lld of %lld)", view->title, done, view->total);
+    histogram_draw(stdout, view->hist, count, title, view->drawn);
+    fflush(stdout);
+    view->drawn = 1;
+}
+
+
+/**
+ * This function plots the finished histogram in the given way (PLOT_NONE, PLOT_TERMINAL or PLOT_GNUPLOT). gnuplot plots
+ * the file at path, which must already hold the histogram. If gnuplot cannot be run, the histogram is drawn on the
+ * terminal instead. A histogram already drawn while it was generated is not drawn again. 							*/
+void histogram_show(struct Histogram_View *view, const unsigned long long *count, const char *path, int plot)
+{
+    if(plot == PLOT_GNUPLOT && histogram_plot(view->hist, path, view->title) != 0)
+    {
+        fprintf(stderr, "gnuplot could not be run. The histogram is drawn without it.\n");
+        plot = PLOT_TERMINAL;
+    }
+    if(plot == PLOT_TERMINAL && !view->drawn) {
+        histogram_draw(stdout, view->hist, count, view->title, 0);
+    }
+}
+
+
+/**
+ * This function reads a range given as "low,high" from a command-line argument. The program exits with an error message if
+ * it cannot be read. 																						*/
+void histogram_range_from_arg(const char *arg, double *low, double *high)
+{
+    if(sscanf(arg, "%lf,%lf", low, high) != 2 || !(*high > *low))
+    {
+        fprintf(stderr, "Error! The range must be given as low,high with high above low.\n");
+        exit(-1);
+    }
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************************************************************
+ * Histogram Engine
+ *
+ * Name: histogram.h
+ *
+ * Purpose: Bins batches of samples into a histogram with a configurable number of equal bins over the range [low, high).
+ *          The counters are 64-bit and are kept in a caller-provided array of histogram_size() elements: element 0 counts
+ *          the samples below low, elements 1 to bins count the bins, and element bins + 1 counts the samples at or above
+ *          high, so no sample is ever clamped into the first or last bin. The bin index is computed without branches, by
+ *          clamping the scaled sample with min and max instructions. Samples that are uniform over the range of the
+ *          histogram can also be binned straight from the words of the generator, with integer arithmetic only.
+ *          The histogram can be written to a file, one line per bin with the start of the bin and its count, after
+ *          comment lines with the range, underflow and overflow. It is drawn on the terminal straight from the counters,
+ *          and can be redrawn in place while the samples are generated (see parallel_histogram_progress()). Plotting the
+ *          file with gnuplot is optional, and falls back to the built-in drawing if gnuplot cannot be run.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Part of the sampling library, libsampling.a (see sampling.h).
+ *
+*******************************************************************************************************************************/
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "rng.h"
+
+#define HISTOGRAM_ROWS 20           // Height of the bars of a drawn histogram, in lines.
+#define HISTOGRAM_COLUMNS 64        // Width of a drawn histogram, in characters.
+#define HISTOGRAM_REDRAW 0.5        // Time between redraws while the samples are generated, in seconds.
+
+// Ways of plotting a histogram.
+#define PLOT_NONE 0
+#define PLOT_TERMINAL 1             // Drawn on the terminal by histogram_draw().
+#define PLOT_GNUPLOT 2              // Plotted from the output file with gnuplot.
+
+// Structure contains the layout of a histogram.
+struct Histogram
+{
+    int bins;           // Number of bins between low and high.
+    double low;         // Start of the first bin.
+    double high;        // End of the last bin.
+    double scale;       // Number of bins per unit, bins / (high - low).
+};
+
+// Structure contains a histogram being drawn on the terminal while its samples are generated.
+struct Histogram_View
+{
+    const struct Histogram *hist;
+    const char *title;
+    long long total;    // Number of samples that will be generated.
+    int drawn;          // 1 once the histogram is on the terminal, so the next drawing replaces it.
+};
+
+void histogram_setup(struct Histogram *hist, int bins, double low, double high);
+void histogram_add(const struct Histogram *hist, unsigned long long *count, const double *x, size_t n);
+void histogram_add_int(const struct Histogram *hist, unsigned long long *count, const int *x, size_t n);
+void histogram_add_uniform(struct Rng *rng, const struct Histogram *hist, unsigned long long *count, long long n);
+void histogram_write(const struct Histogram *hist, const unsigned long long *count, const char *path);
+int histogram_plot(const struct Histogram *hist, const char *path, const char *title);
+void histogram_draw(FILE *out, const struct Histogram *hist, const unsigned long long *count, const char *title, int redraw);
+void histogram_view_setup(struct Histogram_View *view, const struct Histogram *hist, const char *title, long long total);
+void histogram_redraw(const unsigned long long *count, long long done, void *view);
+void histogram_show(struct Histogram_View *view, const unsigned long long *count, const char *path, int plot);
+void histogram_range_from_arg(const char *arg, double *low, double *high);
+
+// Returns the number of counters used by the histogram, including the underflow and overflow counters.
+static inline int histogram_size(const struct Histogram *hist)
+{
+    return hist->bins + 2;
+}
+
+#endif
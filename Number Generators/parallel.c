@@ -0,0 +1,271 @@
+/*******************************************************************************************************************************
+ * Parallel Histogram Generation
+ *
+ * Name: parallel.c
+ *
+ * Purpose: Thread pool for parallel_histogram() declared in parallel.h. Thread t runs chunks t, t + threads, t + 2 * threads
+ *          and so on. It keeps the start of its next stream and moves it forward by jumping the generator once per thread,
+ *          so no stream is ever computed from scratch. After each chunk, the thread adds its private histogram to the
+ *          caller's under a lock and clears it, so the main thread can show the histogram while it is being generated.
+ *          Quasi-random chunks are run by the same pool and are only passed the index of their first sample.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "parallel.h"
+
+// Structure contains the histogram shared by the threads and the progress made on it.
+struct Shared
+{
+    pthread_mutex_t lock;
+    pthread_cond_t finished_cond;   // Signalled when a thread finishes.
+    unsigned long long *bins;       // Caller's histogram, which the private histograms are added to.
+    int bin_count;
+    long long done;                 // Number of samples added to bins[] so far.
+    int finished;                   // Number of threads that have finished.
+};
+
+// Structure contains the work and private histogram of one thread.
+struct Worker
+{
+    pthread_t thread;
+    int index;                      // Index of the thread, which is also its first chunk.
+    int threads;                    // Number of threads.
+    long long x;                    // Total number of samples.
+    uint64_t seed;
+    unsigned long long *bins;       // Private histogram of the thread.
+    Chunk_Function generate;
+    Sequence_Function sequence;     // Used instead of generate() if it is not NULL.
+    void *context;
+    struct Shared *shared;
+};
+
+static void *worker_main(void *arg);
+static void run_chunks(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                       Chunk_Function generate, Sequence_Function sequence, void *context, Progress_Function progress,
+                       void *progress_context, double interval);
+
+
+/**
+ * This function returns the number of CPUs online, which is used as the default number of threads. 			*/
+int parallel_default_threads(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+
+/**
+ * This function reads the number of threads from argv[index]. If it is not given, the number of CPUs online is used. 	*/
+int parallel_threads_from_args(int argc, char *argv[], int index)
+{
+    int threads = (index < argc) ? atoi(argv[index]) : parallel_default_threads();
+
+    if(threads < 1)
+    {
+        fprintf(stderr, "Error! The number of threads must be positive.\n");
+        exit(-1);
+    }
+    return threads;
+}
+
+
+/**
+ * This function runs the chunks assigned to one thread. 													*/
+static void *worker_main(void *arg)
+{
+    struct Worker *worker = arg;
+    struct Shared *shared = worker->shared;
+    long long chunks = (worker->x + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    long long chunk;
+    struct Rng stream;      // Start of the stream of the thread's next chunk.
+    struct Rng rng;
+    int i;
+
+    rng_stream(&stream, worker->seed, worker->index);
+
+    for(chunk = worker->index; chunk < chunks; chunk += worker->threads)
+    {
+        long long count = worker->x - chunk * PARALLEL_CHUNK;
+
+        if(count > PARALLEL_CHUNK) {
+            count = PARALLEL_CHUNK;
+        }
+
+        if(worker->sequence) {
+            worker->sequence(chunk * PARALLEL_CHUNK, count, worker->bins, worker->context);
+        }
+        else
+        {
+            rng = stream;
+            worker->generate(&rng, count, worker->bins, worker->context);
+        }
+
+        // Adds the chunk to the shared histogram.
+        pthread_mutex_lock(&shared->lock);
+        for(i = 0; i < shared->bin_count; i++) {
+            shared->bins[i] += worker->bins[i];
+        }
+        shared->done += count;
+        pthread_mutex_unlock(&shared->lock);
+        memset(worker->bins, 0, shared->bin_count * sizeof(unsigned long long));
+
+        // Moves on to the stream of the next chunk of this thread.
+        for(i = 0; i < worker->threads; i++) {
+            rng_jump(&stream);
+        }
+    }
+
+    pthread_mutex_lock(&shared->lock);
+    shared->finished++;
+    pthread_cond_signal(&shared->finished_cond);
+    pthread_mutex_unlock(&shared->lock);
+    return NULL;
+}
+
+
+/**
+ * This function generates x samples on the given number of threads and adds them to bins[], which holds bin_count
+ * counters. generate() is called once per chunk with the chunk's generator and the thread's private histogram. 	*/
+void parallel_histogram(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                        Chunk_Function generate, void *context)
+{
+    parallel_histogram_progress(x, threads, seed, bins, bin_count, generate, context, NULL, NULL, 0);
+}
+
+
+/**
+ * This function works like parallel_histogram(), and also calls progress() every interval seconds with a copy of the
+ * histogram so far and the number of samples in it, and once more at the end with bins[] itself. progress may be NULL.
+ * 																											*/
+void parallel_histogram_progress(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                                 Chunk_Function generate, void *context, Progress_Function progress,
+                                 void *progress_context, double interval)
+{
+    run_chunks(x, threads, seed, bins, bin_count, generate, NULL, context, progress, progress_context, interval);
+}
+
+
+/**
+ * This function works like parallel_histogram_progress(), but sequence() is called once per chunk with the index of the
+ * chunk's first sample instead of a generator. 																*/
+void parallel_sequence_progress(long long x, int threads, unsigned long long *bins, int bin_count,
+                                Sequence_Function sequence, void *context, Progress_Function progress,
+                                void *progress_context, double interval)
+{
+    run_chunks(x, threads, 0, bins, bin_count, NULL, sequence, context, progress, progress_context, interval);
+}
+
+
+/**
+ * This function runs the chunks of parallel_histogram_progress() and parallel_sequence_progress() on the thread pool.
+ * Each chunk is generated by sequence() if it is not NULL, else by generate(). 									*/
+static void run_chunks(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                       Chunk_Function generate, Sequence_Function sequence, void *context, Progress_Function progress,
+                       void *progress_context, double interval)
+{
+    struct Worker *workers;
+    struct Shared shared;
+    unsigned long long *snapshot = NULL;        // Copy of the histogram passed to progress().
+    long long chunks = (x + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    struct timespec deadline;
+    int t;
+
+    // There is no point in having more threads than chunks.
+    if(threads > chunks) {
+        threads = (int)chunks;
+    }
+    if(threads < 1) {
+        threads = 1;
+    }
+
+    workers = calloc(threads, sizeof(struct Worker));
+    if(progress) {
+        snapshot = malloc(bin_count * sizeof(unsigned long long));
+    }
+    if(!workers || (progress && !snapshot))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    pthread_mutex_init(&shared.lock, NULL);
+    pthread_cond_init(&shared.finished_cond, NULL);
+    shared.bins = bins;
+    shared.bin_count = bin_count;
+    shared.done = 0;
+    shared.finished = 0;
+
+    for(t = 0; t < threads; t++)
+    {
+        workers[t].index = t;
+        workers[t].threads = threads;
+        workers[t].x = x;
+        workers[t].seed = seed;
+        workers[t].generate = generate;
+        workers[t].sequence = sequence;
+        workers[t].context = context;
+        workers[t].shared = &shared;
+        workers[t].bins = calloc(bin_count, sizeof(unsigned long long));
+
+        if(!workers[t].bins)
+        {
+            perror("Error! Cannot allocate memory!");
+            exit(-1);
+        }
+        if(pthread_create(&workers[t].thread, NULL, worker_main, &workers[t]) != 0)
+        {
+            perror("Error! Cannot create thread!");
+            exit(-1);
+        }
+    }
+
+    // Shows the histogram every interval seconds until every thread has finished. It is copied under the lock and shown
+    // after the lock is released, so the threads are not held up by the output.
+    if(progress)
+    {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        pthread_mutex_lock(&shared.lock);
+        while(shared.finished < threads)
+        {
+            long long done;
+
+            deadline.tv_nsec += (long)(interval * 1e9);
+            deadline.tv_sec += deadline.tv_nsec / 1000000000;
+            deadline.tv_nsec %= 1000000000;
+            while(shared.finished < threads &&
+                  pthread_cond_timedwait(&shared.finished_cond, &shared.lock, &deadline) == 0);
+
+            if(shared.finished < threads)
+            {
+                memcpy(snapshot, bins, bin_count * sizeof(unsigned long long));
+                done = shared.done;
+                pthread_mutex_unlock(&shared.lock);
+                progress(snapshot, done, progress_context);
+                pthread_mutex_lock(&shared.lock);
+            }
+        }
+        pthread_mutex_unlock(&shared.lock);
+    }
+
+    // Waits for every thread, whose chunks are already in bins[].
+    for(t = 0; t < threads; t++)
+    {
+        pthread_join(workers[t].thread, NULL);
+        free(workers[t].bins);
+    }
+    if(progress) {
+        progress(bins, x, progress_context);
+    }
+    pthread_mutex_destroy(&shared.lock);
+    pthread_cond_destroy(&shared.finished_cond);
+    free(snapshot);
+    free(workers);
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************************************************************
+ * Parallel Histogram Generation
+ *
+ * Name: parallel.h
+ *
+ * Purpose: Generates a 64-bit number of random samples on several threads and bins them into a histogram. The samples are
+ *          split into chunks of PARALLEL_CHUNK samples and chunk c always uses stream c of the generator (see rng_stream()),
+ *          whichever thread runs it. Each thread bins into its own private histogram and the histograms are added together
+ *          after each chunk, so the result for a given seed is the same for any number of threads. While the samples are
+ *          generated, the histogram so far can be shown at regular intervals.
+ *          Quasi-random samples are generated the same way with parallel_sequence_progress(), which passes each chunk the
+ *          index of its first sample instead of a generator, so chunk c takes samples c * PARALLEL_CHUNK onwards of one
+ *          sequence (see sobol.h).
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Part of the sampling library, libsampling.a (see sampling.h). Include the -pthread option at compile time.
+ *
+*******************************************************************************************************************************/
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdint.h>
+#include "rng.h"
+
+#define PARALLEL_CHUNK (1LL << 20)      // Number of samples generated with each generator stream.
+
+// Function that generates count samples with rng and adds them to the histogram, bins[]. context is passed through unchanged.
+typedef void (*Chunk_Function)(struct Rng *rng, long long count, unsigned long long *bins, void *context);
+
+// Function that generates samples first to first + count - 1 of a sequence and adds them to the histogram, bins[].
+typedef void (*Sequence_Function)(long long first, long long count, unsigned long long *bins, void *context);
+
+// Function that is shown the histogram, bins[], made from the first done samples while it is being generated.
+typedef void (*Progress_Function)(const unsigned long long *bins, long long done, void *context);
+
+int parallel_default_threads(void);
+int parallel_threads_from_args(int argc, char *argv[], int index);
+void parallel_histogram(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                        Chunk_Function generate, void *context);
+void parallel_histogram_progress(long long x, int threads, uint64_t seed, unsigned long long *bins, int bin_count,
+                                 Chunk_Function generate, void *context, Progress_Function progress,
+                                 void *progress_context, double interval);
+void parallel_sequence_progress(long long x, int threads, unsigned long long *bins, int bin_count,
+                                Sequence_Function sequence, void *context, Progress_Function progress,
+                                void *progress_context, double interval);
+
+#endif
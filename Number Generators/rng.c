@@ -0,0 +1,111 @@
+/*******************************************************************************************************************************
+ * Pseudo-Random Number Generator
+ *
+ * Name: rng.c
+ *
+ * Purpose: Seeding and jump-ahead functions for the xoshiro256++ generator declared in rng.h.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "rng.h"
+
+void rng_jump_by(struct Rng *rng, const uint64_t *poly);
+
+
+/**
+ * This function seeds the generator. The seed is expanded into the four state words with the splitmix64 generator, so
+ * similar seeds still give unrelated streams and the state is never all zero.
+ * Source: https://prng.di.unimi.it/splitmix64.c 															*/
+void rng_seed(struct Rng *rng, uint64_t seed)
+{
+    int i;
+
+    for(i = 0; i < 4; i++)
+    {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+
+/**
+ * This function seeds the generator and moves it to the start of the given stream. Stream k begins k * 2^128 draws after
+ * stream 0, so streams from the same seed never overlap. Used to give each thread its own generator. 		*/
+void rng_stream(struct Rng *rng, uint64_t seed, unsigned stream)
+{
+    rng_seed(rng, seed);
+    while(stream--) {
+        rng_jump(rng);
+    }
+}
+
+
+/**
+ * This function advances the generator by 2^128 draws. 													*/
+void rng_jump(struct Rng *rng)
+{
+    static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    rng_jump_by(rng, JUMP);
+}
+
+
+/**
+ * This function advances the generator by 2^192 draws. 													*/
+void rng_long_jump(struct Rng *rng)
+{
+    static const uint64_t LONG_JUMP[] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+    rng_jump_by(rng, LONG_JUMP);
+}
+
+
+/**
+ * This function advances the generator by the number of draws encoded in the jump polynomial, poly. 		*/
+void rng_jump_by(struct Rng *rng, const uint64_t *poly)
+{
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i, b;
+
+    for(i = 0; i < 4; i++)
+    {
+        for(b = 0; b < 64; b++)
+        {
+            if(poly[i] & (1ULL << b))
+            {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+
+/**
+ * This function reads the seed from argv[index]. If it is not given, the current time is used instead. The seed is
+ * printed so that the run can be reproduced. 																*/
+uint64_t rng_seed_from_args(int argc, char *argv[], int index)
+{
+    uint64_t seed;
+
+    if(index < argc) {
+        seed = strtoull(argv[index], NULL, 0);
+    }
+    else {
+        seed = (uint64_t)time(NULL);
+    }
+    printf("Seed: %llu\n", (unsigned long long)seed);
+    return seed;
+}
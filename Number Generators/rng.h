@@ -0,0 +1,92 @@
+/*******************************************************************************************************************************
+ * Pseudo-Random Number Generator
+ *
+ * Name: rng.h
+ *
+ * Purpose: Seedable pseudo-random number generator shared by the number generators and the job generator. It uses the
+ *          xoshiro256++ generator, which has a period of 2^256 - 1, returns 64-bit words and keeps all of its state in an
+ *          explicit structure, so each caller (or thread) owns its own generator. rng_jump() advances a generator by 2^128
+ *          draws and rng_long_jump() by 2^192 draws, giving non-overlapping streams for parallel use.
+ *          Source: https://prng.di.unimi.it/
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile rng.c together with the program using the generator.
+ * 	(gcc -o program program.c rng.c)
+ *
+*******************************************************************************************************************************/
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Structure contains the state of a generator.
+struct Rng
+{
+    uint64_t s[4];
+};
+
+void rng_seed(struct Rng *rng, uint64_t seed);
+void rng_stream(struct Rng *rng, uint64_t seed, unsigned stream);
+void rng_jump(struct Rng *rng);
+void rng_long_jump(struct Rng *rng);
+uint64_t rng_seed_from_args(int argc, char *argv[], int index);
+
+
+// Rotates x to the left by k bits.
+static inline uint64_t rng_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+
+/**
+ * This function returns the next 64-bit word from the generator using the xoshiro256++ algorithm. 			*/
+static inline uint64_t rng_next(struct Rng *rng)
+{
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+
+    return result;
+}
+
+
+/**
+ * This function returns a uniformly distributed double in [0,1). The top 53 bits of the next word are used so every
+ * value is a multiple of 2^-53. 																			*/
+static inline double rng_uniform(struct Rng *rng)
+{
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+
+/**
+ * This function returns a uniformly distributed integer in [0,n) without modulo bias using Lemire's multiply-shift
+ * method. Source: https://arxiv.org/abs/1805.10941 														*/
+static inline uint64_t rng_bounded(struct Rng *rng, uint64_t n)
+{
+    __uint128_t m = (__uint128_t)rng_next(rng) * n;
+    uint64_t low = (uint64_t)m;
+
+    // Rejects the few words that would make some values more likely than others.
+    if(low < n)
+    {
+        uint64_t threshold = -n % n;
+        while(low < threshold)
+        {
+            m = (__uint128_t)rng_next(rng) * n;
+            low = (uint64_t)m;
+        }
+    }
+    return (uint64_t)(m >> 64);
+}
+
+#endif
@@ -0,0 +1,894 @@
+/*******************************************************************************************************************************
+ * Sampling Library
+ *
+ * Name: sampling.c
+ *
+ * Purpose: Batch samplers declared in sampling.h.
+ *          Uniform samples take the top 53 bits of a word, or for fill_unit() every bit of precision a double has in
+ *          [0, 1). Die rolls use Lemire's multiply-and-shift method, which is unbiased for any number of sides, on as many
+ *          dice as fit in one word (14 d20 or 24 d6), and read the rolls off one at a time by multiplying the low bits
+ *          again.
+ *          Source: D. Lemire, "Fast Random Integer Generation in an Interval", ACM Transactions on Modeling and Computer
+ *          Simulation 29(1), 2019, and N. Brackett-Rozinsky and D. Lemire, "Batched Ranged Random Integer Generation",
+ *          2024.
+ *          Discrete distributions with a table of probabilities, such as the sum of many dice, are sampled in O(1) time
+ *          with an alias table, or by inversion of a cumulative distribution table where the order of the values must be
+ *          kept, as for quasi-random numbers (see sobol.h).
+ *          Normal samples are generated with the Ziggurat method of Marsaglia and Tsang, using 128 layers. Each sample takes
+ *          one 64-bit word: the low 7 bits choose the layer, bit 7 is the sign and the top 31 bits are the magnitude. About
+ *          99% of the words are accepted by a table lookup and a multiply, and the rest fall back to the exact wedge and tail
+ *          tests. Words are drawn a block at a time, the fast path is run over the whole block (4 words at a time with AVX2
+ *          when the CPU supports it) and the rejected words are then finished in order, so the AVX2 and scalar versions give
+ *          the same samples for the same generator state.
+ *          Source: G. Marsaglia and W. W. Tsang, "The Ziggurat Method for Generating Random Variables", Journal of
+ *          Statistical Software 5(8), 2000.
+ *          Exponential samples are generated with the 256-layer exponential Ziggurat from the same paper.
+ *          Poisson samples take O(1) expected time for any lambda. Below POISSON_PTRS_MIN they are found by inversion of a
+ *          cumulative distribution table built once per call, with a guide table pointing at the first candidate. From
+ *          POISSON_PTRS_MIN up, Hormann's transformed rejection with squeeze (PTRS) is used, which needs about 1.1 pairs of
+ *          uniforms per sample and no table.
+ *          Source: W. Hormann, "The Transformed Rejection Method for Generating Poisson Random Variables", Insurance:
+ *          Mathematics and Economics 12(1), 1993.
+ *          The inverse normal distribution function uses Wichura's rational approximations, which are accurate to about
+ *          1e-15 without any call to erf() or exp().
+ *          Source: M. J. Wichura, "Algorithm AS 241: The Percentage Points of the Normal Distribution", Journal of the
+ *          Royal Statistical Society, Series C (Applied Statistics) 37(3), 1988.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	The AVX2 version is compiled with the target attribute and chosen at run time, so no extra compiler options are needed.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <immintrin.h>
+#include "sampling.h"
+
+#define ZIG_LAYERS 128                  // Number of layers in the Ziggurat.
+#define ZIG_R 3.442619855899            // Start of the tail of the normal distribution.
+#define ZIG_V 9.91256303526217e-3       // Area of each layer.
+#define ZIG_BLOCK 256                   // Number of words drawn at a time.
+#define EXP_LAYERS 256                  // Number of layers in the exponential Ziggurat.
+#define EXP_R 7.69711747013104972       // Start of the tail of the exponential distribution.
+#define EXP_V 3.949659822581572e-3      // Area of each layer.
+
+#define DICE_GROUP_MAX 64               // Largest number of dice rolled from one word.
+
+#define POISSON_PTRS_MIN 10             // Smallest lambda sampled with PTRS instead of the inversion table.
+#define POISSON_TABLE 64                // Size of the inversion table. P(X >= 64) < 1e-30 for lambda below 10.
+
+// Ziggurat tables. A word is accepted straight away if its magnitude is below kn[layer], and the sample is then the
+// magnitude times wn[layer]. fn[layer] is the density at the layer's edge.
+static uint32_t kn[ZIG_LAYERS];
+static double wn[ZIG_LAYERS];
+static double fn[ZIG_LAYERS];
+
+// Exponential Ziggurat tables, used in the same way.
+static uint32_t ke[EXP_LAYERS];
+static double we[EXP_LAYERS];
+static double fe[EXP_LAYERS];
+
+// Rolls of a die, taken a group at a time from one word.
+struct Dice
+{
+    uint64_t sides;
+    uint64_t product;       // sides^group.
+    uint64_t threshold;     // 2^64 mod product. Words whose product with it falls below it are rejected.
+    uint64_t word;          // Low bits of the current word, which hold the rolls left in it.
+    int group;              // Number of rolls taken from each word.
+    int left;               // Number of rolls left in the current word.
+};
+
+static int use_avx2 = 0;        // 1 if the CPU supports AVX2, else 0.
+
+static double zig_slow(struct Rng *rng, uint32_t u, int negative, int layer);
+static void zig_finish(struct Rng *rng, const uint64_t *words, double *out, const int *rejected, int count, double mean, double sd);
+
+
+/**
+ * This function builds the normal and exponential Ziggurat tables and checks for AVX2. It runs once when the program starts, before any threads
+ * are created. 																							*/
+__attribute__((constructor)) static void zig_setup(void)
+{
+    const double m1 = 2147483648.0;        // 2^31, the range of the magnitude.
+    double dn = ZIG_R, tn = ZIG_R;
+    double q = ZIG_V / exp(-0.5 * dn * dn);
+    int i;
+
+    __builtin_cpu_init();
+    use_avx2 = __builtin_cpu_supports("avx2");
+
+    kn[0] = (uint32_t)((dn / q) * m1);
+    kn[1] = 0;
+    wn[0] = q / m1;
+    wn[ZIG_LAYERS - 1] = dn / m1;
+    fn[0] = 1.0;
+    fn[ZIG_LAYERS - 1] = exp(-0.5 * dn * dn);
+
+    for(i = ZIG_LAYERS - 2; i >= 1; i--)
+    {
+        dn = sqrt(-2.0 * log(ZIG_V / dn + exp(-0.5 * dn * dn)));
+        kn[i + 1] = (uint32_t)((dn / tn) * m1);
+        tn = dn;
+        fn[i] = exp(-0.5 * dn * dn);
+        wn[i] = dn / m1;
+    }
+
+    // Builds the exponential tables. The magnitude has 32 bits.
+    dn = tn = EXP_R;
+    q = EXP_V / exp(-dn);
+    ke[0] = (uint32_t)((dn / q) * (2 * m1));
+    ke[1] = 0;
+    we[0] = q / (2 * m1);
+    we[EXP_LAYERS - 1] = dn / (2 * m1);
+    fe[0] = 1.0;
+    fe[EXP_LAYERS - 1] = exp(-dn);
+
+    for(i = EXP_LAYERS - 2; i >= 1; i--)
+    {
+        dn = -log(EXP_V / dn + exp(-dn));
+        ke[i + 1] = (uint32_t)((dn / tn) * (2 * m1));
+        tn = dn;
+        fe[i] = exp(-dn);
+        we[i] = dn / (2 * m1);
+    }
+}
+
+
+/**
+ * This function returns a uniformly distributed double in (0,1), which is safe to pass to log(). 			*/
+static inline double uniform_open(struct Rng *rng)
+{
+    return ((rng_next(rng) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+
+/**
+ * This function finishes a word rejected by the fast path. It samples the tail for the base layer, runs the wedge test
+ * for the other layers and, if that fails too, draws new words until one is accepted. 						*/
+static double zig_slow(struct Rng *rng, uint32_t u, int negative, int layer)
+{
+    double x, y;
+    uint64_t word;
+
+    for(;;)
+    {
+        x = u * wn[layer];
+
+        // Samples the tail beyond ZIG_R.
+        if(layer == 0)
+        {
+            do {
+                x = -log(uniform_open(rng)) / ZIG_R;
+                y = -log(uniform_open(rng));
+            } while(y + y < x * x);
+            return negative ? -(ZIG_R + x) : ZIG_R + x;
+        }
+
+        // Accepts the sample if it lies under the density in the wedge of the layer.
+        if(fn[layer] + rng_uniform(rng) * (fn[layer - 1] - fn[layer]) < exp(-0.5 * x * x)) {
+            return negative ? -x : x;
+        }
+
+        // Draws a new word and tries the fast path again.
+        word = rng_next(rng);
+        layer = word & (ZIG_LAYERS - 1);
+        negative = (word >> 7) & 1;
+        u = (uint32_t)(word >> 33);
+        if(u < kn[layer]) {
+            return negative ? -(u * wn[layer]) : u * wn[layer];
+        }
+    }
+}
+
+
+/**
+ * This function finishes the words of a block that were rejected by the fast path, in order. 				*/
+static void zig_finish(struct Rng *rng, const uint64_t *words, double *out, const int *rejected, int count, double mean, double sd)
+{
+    int i;
+
+    for(i = 0; i < count; i++)
+    {
+        uint64_t word = words[rejected[i]];
+        double z = zig_slow(rng, (uint32_t)(word >> 33), (word >> 7) & 1, word & (ZIG_LAYERS - 1));
+        out[rejected[i]] = mean + sd * z;
+    }
+}
+
+
+/**
+ * This function fills out[] with n normally distributed random numbers with the given mean and standard deviation (sd)
+ * using only scalar instructions. 																			*/
+void fill_normal_scalar(struct Rng *rng, double *out, size_t n, double mean, double sd)
+{
+    uint64_t words[ZIG_BLOCK];
+    int rejected[ZIG_BLOCK];
+
+    while(n > 0)
+    {
+        int block = n < ZIG_BLOCK ? (int)n : ZIG_BLOCK;
+        int count = 0;
+        int i;
+
+        for(i = 0; i < block; i++) {
+            words[i] = rng_next(rng);
+        }
+
+        // Fast path: accepts the word if its magnitude is inside the rectangle of its layer.
+        for(i = 0; i < block; i++)
+        {
+            uint64_t word = words[i];
+            int layer = word & (ZIG_LAYERS - 1);
+            uint32_t u = (uint32_t)(word >> 33);
+            double x = u * wn[layer];
+
+            if(word & 0x80) {
+                x = -x;
+            }
+            out[i] = mean + sd * x;
+            if(u >= kn[layer]) {
+                rejected[count++] = i;
+            }
+        }
+
+        zig_finish(rng, words, out, rejected, count, mean, sd);
+        out += block;
+        n -= block;
+    }
+}
+
+
+/**
+ * This function is the AVX2 version of fill_normal_scalar(). The fast path handles 4 words at a time with gathers from
+ * the tables, and gives exactly the same samples as the scalar version. 										*/
+__attribute__((target("avx2"))) static void fill_normal_avx2(struct Rng *rng, double *out, size_t n, double mean, double sd)
+{
+    uint64_t words[ZIG_BLOCK];
+    int rejected[ZIG_BLOCK];
+    const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);     // Moves the low half of each 64-bit lane to the bottom.
+    const __m256i layer_mask = _mm256_set1_epi64x(ZIG_LAYERS - 1);
+    const __m256i sign_mask = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256d mean_v = _mm256_set1_pd(mean);
+    const __m256d sd_v = _mm256_set1_pd(sd);
+
+    while(n > 0)
+    {
+        int block = n < ZIG_BLOCK ? (int)n : ZIG_BLOCK;
+        int vector_end = block & ~3;
+        int count = 0;
+        int i;
+
+        for(i = 0; i < block; i++) {
+            words[i] = rng_next(rng);
+        }
+
+        for(i = 0; i < vector_end; i += 4)
+        {
+            __m256i word = _mm256_loadu_si256((const __m256i *)(words + i));
+            __m128i layer = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_and_si256(word, layer_mask), pack));
+            __m128i u = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_srli_epi64(word, 33), pack));
+            __m128i k = _mm_i32gather_epi32((const int *)kn, layer, 4);
+            __m256d x = _mm256_mul_pd(_mm256_cvtepi32_pd(u), _mm256_i32gather_pd(wn, layer, 8));
+            __m256i sign = _mm256_and_si256(_mm256_slli_epi64(word, 56), sign_mask);
+            int accepted;
+
+            x = _mm256_xor_pd(x, _mm256_castsi256_pd(sign));
+            _mm256_storeu_pd(out + i, _mm256_add_pd(mean_v, _mm256_mul_pd(sd_v, x)));
+
+            // Records the lanes whose magnitude is not below kn[layer].
+            accepted = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(k, u)));
+            if(accepted != 0xF)
+            {
+                int lane;
+                for(lane = 0; lane < 4; lane++)
+                {
+                    if(!(accepted & (1 << lane))) {
+                        rejected[count++] = i + lane;
+                    }
+                }
+            }
+        }
+
+        // Scalar fast path for the last few words of the block.
+        for(; i < block; i++)
+        {
+            uint64_t word = words[i];
+            int layer = word & (ZIG_LAYERS - 1);
+            uint32_t u = (uint32_t)(word >> 33);
+            double x = u * wn[layer];
+
+            if(word & 0x80) {
+                x = -x;
+            }
+            out[i] = mean + sd * x;
+            if(u >= kn[layer]) {
+                rejected[count++] = i;
+            }
+        }
+
+        zig_finish(rng, words, out, rejected, count, mean, sd);
+        out += block;
+        n -= block;
+    }
+}
+
+
+/**
+ * This function fills out[] with n normally distributed random numbers with the given mean and standard deviation (sd).
+ * The AVX2 version is used when the CPU supports it. 														*/
+void fill_normal(struct Rng *rng, double *out, size_t n, double mean, double sd)
+{
+    if(use_avx2) {
+        fill_normal_avx2(rng, out, n, mean, sd);
+    }
+    else {
+        fill_normal_scalar(rng, out, n, mean, sd);
+    }
+}
+
+
+/**
+ * This function fills out[] with n uniformly distributed random numbers in [low, high). 					*/
+void fill_uniform(struct Rng *rng, double *out, size_t n, double low, double high)
+{
+    double width = high - low;
+    size_t i;
+
+    for(i = 0; i < n; i++) {
+        out[i] = low + width * rng_uniform(rng);
+    }
+}
+
+
+/**
+ * This function fills out[] with n uniformly distributed random numbers in [0, 1) that use the full precision of a double,
+ * down to 2^-1022, rather than a grid of multiples of 2^-53. Each number is a uniform real number in [0, 1) rounded down to
+ * the next double: the leading zeros of a word give the binade [2^-(e + 1), 2^-e) with probability 2^-(e + 1), and the low
+ * 52 bits the position within it. One word is enough unless its top 12 bits are all 0, once in 4096 words.	*/
+void fill_unit(struct Rng *rng, double *out, size_t n)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        uint64_t word = rng_next(rng);
+        uint64_t top = word >> 52;
+        uint64_t bits;
+        int e;
+
+        if(top != 0) {
+            e = __builtin_clzll(top) - 52;
+        }
+
+        // Counts the leading zeros of further words until a 1 is found.
+        else
+        {
+            uint64_t more;
+
+            e = 12;
+            while((more = rng_next(rng)) == 0 && e < 1022) {
+                e += 64;
+            }
+            e += (more != 0) ? __builtin_clzll(more) : 0;
+        }
+
+        bits = (e < 1022) ? ((uint64_t)(1022 - e) << 52) | (word & 0xFFFFFFFFFFFFFULL) : 0;
+        memcpy(&out[i], &bits, sizeof(double));
+    }
+}
+
+
+/**
+ * This function sets up the rolling of a die with the given number of sides a group at a time: the group is the largest
+ * number of rolls, k, for which sides^k fits in 64 bits. 														*/
+static void dice_setup(struct Dice *dice, int sides)
+{
+    dice->sides = sides;
+    dice->group = 1;
+    dice->product = sides;
+    while(dice->group < DICE_GROUP_MAX && dice->product <= UINT64_MAX / dice->sides)
+    {
+        dice->product *= dice->sides;
+        dice->group++;
+    }
+    dice->threshold = -dice->product % dice->product;
+    dice->left = 0;
+}
+
+
+/**
+ * This function returns the next roll, from 0 to sides - 1. Multiplying a word by sides gives the first roll of its group in
+ * the high bits, and multiplying the low bits by sides again gives the next, so the rolls are the digits of Lemire's bounded
+ * sample of sides^group. The low bits left after the last roll are those of word * sides^group, so a word is rejected under
+ * the same condition as in Lemire's method, before any of its rolls are used, which makes every group of rolls equally
+ * likely. 																									*/
+static inline int dice_roll(struct Rng *rng, struct Dice *dice)
+{
+    __uint128_t m;
+
+    if(dice->left == 0)
+    {
+        do {
+            dice->word = rng_next(rng);
+        } while(dice->word * dice->product < dice->threshold);
+        dice->left = dice->group;
+    }
+    m = (__uint128_t)dice->word * dice->sides;
+    dice->word = (uint64_t)m;
+    dice->left--;
+    return (int)(m >> 64);
+}
+
+
+/**
+ * This function fills out[] with n rolls of a die with the given number of sides, from 1 to sides. 		*/
+void fill_dice(struct Rng *rng, int *out, size_t n, int sides)
+{
+    struct Dice dice;
+    size_t i;
+
+    dice_setup(&dice, sides);
+    for(i = 0; i < n; i++) {
+        out[i] = dice_roll(rng, &dice) + 1;
+    }
+}
+
+
+/**
+ * This function fills out[] with n sums of the rolls of the given number of dice, each with the given number of sides. Use
+ * fill_alias() with the table of dice_pmf() instead when there are more than a few dice. 						*/
+void fill_dice_sums(struct Rng *rng, int *out, size_t n, int count, int sides)
+{
+    struct Dice dice;
+    size_t i;
+    int j;
+
+    dice_setup(&dice, sides);
+    for(i = 0; i < n; i++)
+    {
+        int sum = count;        // The rolls run from 0, so each die adds one more.
+
+        for(j = 0; j < count; j++) {
+            sum += dice_roll(rng, &dice);
+        }
+        out[i] = sum;
+    }
+}
+
+
+/**
+ * This function fills pmf[] with the exact distribution of the sum of the given number of dice, each with the given number of
+ * sides. pmf[k] is the probability of the sum dice + k, for k from 0 to dice * (sides - 1). The distribution of one die is
+ * convolved with itself one die at a time, each new term being the sum of a window of sides terms of the last, kept as a
+ * running sum, so each die costs O(width). Only the rising half is summed and the other half mirrored, the distribution
+ * being symmetric: there every term dropped from the window is at most the terms left in it, so the small probabilities in
+ * the tails keep their relative accuracy. 																		*/
+void dice_pmf(int dice, int sides, double *pmf)
+{
+    int width = sides - 1;      // Largest k for the dice added so far.
+    double *next = malloc((dice * (size_t)(sides - 1) + 1) * sizeof(double));
+    double window;              // Sum of pmf[k - sides + 1] to pmf[k].
+    int d, k;
+
+    if(!next)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    for(k = 0; k <= width; k++) {
+        pmf[k] = 1.0 / sides;
+    }
+    for(d = 1; d < dice; d++)
+    {
+        window = 0;
+        for(k = 0; k <= (width + sides - 1) / 2; k++)
+        {
+            window += pmf[k];
+            if(k >= sides) {
+                window -= pmf[k - sides];
+            }
+            next[k] = window / sides;
+        }
+        width += sides - 1;
+        for(; k <= width; k++) {
+            next[k] = next[width - k];
+        }
+        memcpy(pmf, next, (width + 1) * sizeof(double));
+    }
+    free(next);
+}
+
+
+/**
+ * This function sets up an alias table for the discrete distribution p[0] to p[size - 1] with Vose's method. The
+ * probabilities need not add up to exactly 1. The table must be released with alias_free().
+ * Source: M. D. Vose, "A Linear Algorithm for Generating Random Numbers with a Given Distribution", IEEE Transactions on
+ * Software Engineering 17(9), 1991. 																			*/
+void alias_setup(struct Alias_Table *table, const double *p, int size)
+{
+    double *scaled = malloc(size * sizeof(double));     // Probabilities times size, so a full column holds 1.
+    int *small = malloc(size * sizeof(int));            // Columns below 1 and at or above 1, waiting to be paired.
+    int *large = malloc(size * sizeof(int));
+    double total = 0, range;
+    int n_small = 0, n_large = 0;
+    int i;
+
+    table->size = size;
+    table->threshold = -(uint64_t)size % size;
+    table->cut = malloc(size * sizeof(uint64_t));
+    table->alias = malloc(size * sizeof(int));
+    if(!scaled || !small || !large || !table->cut || !table->alias)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    for(i = 0; i < size; i++) {
+        total += p[i];
+    }
+    for(i = 0; i < size; i++)
+    {
+        scaled[i] = p[i] * size / total;
+        if(scaled[i] < 1) {
+            small[n_small++] = i;
+        }
+        else {
+            large[n_large++] = i;
+        }
+    }
+
+    // Fills each column below 1 with the rest of a column at or above 1.
+    range = 0x1.0p64 - table->threshold;
+    while(n_small > 0 && n_large > 0)
+    {
+        int s = small[--n_small];
+        int l = large[n_large - 1];
+
+        table->cut[s] = table->threshold + (uint64_t)(scaled[s] * range);
+        table->alias[s] = l;
+        scaled[l] -= 1 - scaled[s];
+        if(scaled[l] < 1)
+        {
+            n_large--;
+            small[n_small++] = l;
+        }
+    }
+
+    // The columns left over are full, up to rounding errors.
+    while(n_large > 0)
+    {
+        int l = large[--n_large];
+        table->cut[l] = UINT64_MAX;
+        table->alias[l] = l;
+    }
+    while(n_small > 0)
+    {
+        int s = small[--n_small];
+        table->cut[s] = UINT64_MAX;
+        table->alias[s] = s;
+    }
+    free(scaled);
+    free(small);
+    free(large);
+}
+
+
+/**
+ * This function releases the memory held by an alias table. 												*/
+void alias_free(struct Alias_Table *table)
+{
+    free(table->cut);
+    free(table->alias);
+}
+
+
+/**
+ * This function fills out[] with n random numbers from the distribution of the alias table, from 0 to size - 1. Each sample
+ * takes one word: the column is Lemire's bounded sample of size, and the low bits left over, which are uniform over the
+ * words accepted for that column, decide between the column and its alias. The probabilities are therefore resolved to
+ * within size / 2^64. 																						*/
+void fill_alias(struct Rng *rng, const struct Alias_Table *table, int *out, size_t n)
+{
+    uint64_t size = table->size;
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        __uint128_t m = (__uint128_t)rng_next(rng) * size;
+        uint64_t low = (uint64_t)m;
+        uint32_t keep;
+        int column;
+
+        while(low < table->threshold)
+        {
+            m = (__uint128_t)rng_next(rng) * size;
+            low = (uint64_t)m;
+        }
+        column = (int)(m >> 64);
+        keep = -(uint32_t)(low < table->cut[column]);      // All ones to keep the column, without a branch.
+        out[i] = (column & keep) | (table->alias[column] & ~keep);
+    }
+}
+
+
+/**
+ * This function sets up a cumulative distribution table from the probabilities p[] of the values low to low + size - 1.
+ * The probabilities need not add up to exactly 1. The table must be released with cdf_free().					*/
+void cdf_setup(struct Cdf_Table *table, const double *p, long low, int size)
+{
+    double total = 0;
+    int k, j;
+
+    table->low = low;
+    table->size = size;
+    table->cdf = malloc(size * sizeof(double));
+    table->guide = malloc(size * sizeof(int));
+    if(!(table->cdf && table->guide))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    for(k = 0; k < size; k++)
+    {
+        total += p[k];
+        table->cdf[k] = total;
+    }
+    for(k = 0; k < size; k++) {
+        table->cdf[k] /= total;
+    }
+    table->cdf[size - 1] = 1;
+
+    for(j = 0, k = 0; j < size; j++)
+    {
+        while(table->cdf[k] <= (double)j / size) {
+            k++;
+        }
+        table->guide[j] = k;
+    }
+}
+
+
+/**
+ * This function releases the memory held by a cumulative distribution table. 									*/
+void cdf_free(struct Cdf_Table *table)
+{
+    free(table->cdf);
+    free(table->guide);
+}
+
+
+/**
+ * This function returns the smallest value of the table whose cumulative probability is above u, for u in [0, 1). The
+ * guide table points at the first candidate, so the search takes O(1) expected steps. 							*/
+long cdf_inverse(const struct Cdf_Table *table, double u)
+{
+    int k = table->guide[(int)(u * table->size)];
+
+    while(table->cdf[k] <= u) {
+        k++;
+    }
+    return table->low + k;
+}
+
+
+/**
+ * This function fills out[] with n exponentially distributed random numbers with the given mean, using the exponential
+ * Ziggurat. The low 8 bits of each word choose the layer and the top 32 bits are the magnitude. 				*/
+void fill_exponential(struct Rng *rng, double *out, size_t n, double mean)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        uint64_t word = rng_next(rng);
+        int layer = word & (EXP_LAYERS - 1);
+        uint32_t u = word >> 32;
+        double x;
+
+        // Fast path: the point lies inside the rectangle of the layer.
+        if(u < ke[layer])
+        {
+            out[i] = mean * (u * we[layer]);
+            continue;
+        }
+
+        for(;;)
+        {
+            // The base layer samples the tail, which is exponential again beyond EXP_R.
+            if(layer == 0)
+            {
+                x = EXP_R - log(uniform_open(rng));
+                break;
+            }
+
+            // Wedge test against the density.
+            x = u * we[layer];
+            if(fe[layer] + rng_uniform(rng) * (fe[layer - 1] - fe[layer]) < exp(-x)) {
+                break;
+            }
+
+            word = rng_next(rng);
+            layer = word & (EXP_LAYERS - 1);
+            u = word >> 32;
+            if(u < ke[layer])
+            {
+                x = u * we[layer];
+                break;
+            }
+        }
+        out[i] = mean * x;
+    }
+}
+
+
+/**
+ * This function returns the probability of k under the Poisson distribution with an expected value of lambda. It works in
+ * logarithms so that it does not underflow or overflow for large lambda. 										*/
+double poisson_pmf(long k, double lambda)
+{
+    if(k < 0) {
+        return 0;
+    }
+    return exp(k * log(lambda) - lambda - lgamma(k + 1.0));
+}
+
+
+/**
+ * This function fills out[] with n random numbers from a Poisson distribution with an expected value of lambda using
+ * inversion of a cumulative distribution table. Used for lambda below POISSON_PTRS_MIN. 						*/
+static void fill_poisson_table(struct Rng *rng, int *out, size_t n, double lambda)
+{
+    double cdf[POISSON_TABLE];
+    int guide[POISSON_TABLE];       // guide[j] is the first k whose cdf is above j / POISSON_TABLE.
+    double p = exp(-lambda);
+    int k, j;
+    size_t i;
+
+    // Builds the cumulative distribution table. The last entry is 1 so the search always stops.
+    cdf[0] = p;
+    for(k = 1; k < POISSON_TABLE - 1; k++)
+    {
+        p *= lambda / k;
+        cdf[k] = cdf[k - 1] + p;
+    }
+    cdf[POISSON_TABLE - 1] = 1.0;
+
+    for(j = 0, k = 0; j < POISSON_TABLE; j++)
+    {
+        while(cdf[k] <= (double)j / POISSON_TABLE) {
+            k++;
+        }
+        guide[j] = k;
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        double u = rng_uniform(rng);
+
+        k = guide[(int)(u * POISSON_TABLE)];
+        while(cdf[k] <= u) {
+            k++;
+        }
+        out[i] = k;
+    }
+}
+
+
+/**
+ * This function fills out[] with n random numbers from a Poisson distribution with an expected value of lambda using the
+ * PTRS method. Used for lambda of POISSON_PTRS_MIN or more. 													*/
+static void fill_poisson_ptrs(struct Rng *rng, int *out, size_t n, double lambda)
+{
+    // Constants of the hat function. They only depend on lambda, so they are computed once per call.
+    double slam = sqrt(lambda);
+    double loglam = log(lambda);
+    double b = 0.931 + 2.53 * slam;
+    double a = -0.059 + 0.02483 * b;
+    double log_invalpha = log(1.1239 + 1.1328 / (b - 3.4));
+    double vr = 0.9277 - 3.6224 / (b - 2);
+    size_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        for(;;)
+        {
+            double u = rng_uniform(rng) - 0.5;
+            double v = rng_uniform(rng);
+            double us = 0.5 - fabs(u);
+            double k = floor((2 * a / us + b) * u + lambda + 0.43);
+
+            // Accepts most samples straight away inside the squeeze.
+            if(us >= 0.07 && v <= vr)
+            {
+                out[i] = (int)k;
+                break;
+            }
+            if(k < 0 || (us < 0.013 && v > us)) {
+                continue;
+            }
+
+            // Exact acceptance test against the Poisson probability.
+            if(log(v) + log_invalpha - log(a / (us * us) + b) <= -lambda + k * loglam - lgamma(k + 1))
+            {
+                out[i] = (int)k;
+                break;
+            }
+        }
+    }
+}
+
+
+/**
+ * This function fills out[] with n random numbers from a Poisson distribution with an expected value of lambda. The program
+ * exits with an error message if lambda is above POISSON_LAMBDA_MAX, as the samples would not fit in an int. 			*/
+void fill_poisson(struct Rng *rng, int *out, size_t n, double lambda)
+{
+    if(lambda > POISSON_LAMBDA_MAX)
+    {
+        fprintf(stderr, "Error! The expected value of a Poisson distribution must be at most %g.\n", POISSON_LAMBDA_MAX);
+        exit(-1);
+    }
+    if(lambda < POISSON_PTRS_MIN) {
+        fill_poisson_table(rng, out, n, lambda);
+    }
+    else {
+        fill_poisson_ptrs(rng, out, n, lambda);
+    }
+}
+
+
+/**
+ * This function returns the p quantile of the standard normal distribution, for p in (0, 1). Wichura's approximation
+ * uses a rational function of (p - 0.5)^2 in the centre, and in the tails a rational function of sqrt(-log(r)), where
+ * r is the smaller of p and 1 - p, with one function up to 5 and another beyond.							*/
+double normal_inverse(double p)
+{
+    static const double a[8] = {3.3871328727963666080e0, 1.3314166789178437745e+2, 1.9715909503065514427e+3,
+                                1.3731693765509461125e+4, 4.5921953931549871457e+4, 6.7265770927008700853e+4,
+                                3.3430575583588128105e+4, 2.5090809287301226727e+3};
+    static const double b[8] = {1, 4.2313330701600911252e+1, 6.8718700749205790830e+2, 5.3941960214247511077e+3,
+                                2.1213794301586595867e+4, 3.9307895800092710610e+4, 2.8729085735721942674e+4,
+                                5.2264952788528545610e+3};
+    static const double c[8] = {1.42343711074968357734e0, 4.63033784615654529590e0, 5.76949722146069140550e0,
+                                3.64784832476320460504e0, 1.27045825245236838258e0, 2.41780725177450611770e-1,
+                                2.27238449892691845833e-2, 7.74545014278341407640e-4};
+    static const double d[8] = {1, 2.05319162663775882187e0, 1.67638483018380384940e0, 6.89767334985100004550e-1,
+                                1.48103976427480074590e-1, 1.51986665636164571966e-2, 5.47593808499534494600e-4,
+                                1.05075007164441684324e-9};
+    static const double e[8] = {6.65790464350110377720e0, 5.46378491116411436990e0, 1.78482653991729133580e0,
+                                2.96560571828504891230e-1, 2.65321895265761230930e-2, 1.24266094738807843860e-3,
+                                2.71155556874348757815e-5, 2.01033439929228813265e-7};
+    static const double f[8] = {1, 5.99832206555887937690e-1, 1.36929880922735805310e-1, 1.48753612908506148525e-2,
+                                7.86869131145613259100e-4, 1.84631831751005468180e-5, 1.42151175831644588870e-7,
+                                2.04426310338993978564e-15};
+    double q = p - 0.5;
+    double r, x;
+
+    if(fabs(q) <= 0.425)
+    {
+        r = 0.180625 - q * q;
+        return q * (((((((a[7] * r + a[6]) * r + a[5]) * r + a[4]) * r + a[3]) * r + a[2]) * r + a[1]) * r + a[0]) /
+               (((((((b[7] * r + b[6]) * r + b[5]) * r + b[4]) * r + b[3]) * r + b[2]) * r + b[1]) * r + b[0]);
+    }
+
+    r = sqrt(-log((q < 0) ? p : 1 - p));
+    if(r <= 5)
+    {
+        r -= 1.6;
+        x = (((((((c[7] * r + c[6]) * r + c[5]) * r + c[4]) * r + c[3]) * r + c[2]) * r + c[1]) * r + c[0]) /
+            (((((((d[7] * r + d[6]) * r + d[5]) * r + d[4]) * r + d[3]) * r + d[2]) * r + d[1]) * r + d[0]);
+    }
+    else
+    {
+        r -= 5;
+        x = (((((((e[7] * r + e[6]) * r + e[5]) * r + e[4]) * r + e[3]) * r + e[2]) * r + e[1]) * r + e[0]) /
+            (((((((f[7] * r + f[6]) * r + f[5]) * r + f[4]) * r + f[3]) * r + f[2]) * r + f[1]) * r + f[0]);
+    }
+    return (q < 0) ? -x : x;
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************************************************************
+ * Sampling Library
+ *
+ * Name: sampling.h
+ *
+ * Purpose: Batch samplers that fill a caller-provided array with random numbers from a distribution, using the generator
+ *          from rng.h. Working on a whole array at a time spreads the per-call overhead over many samples and lets the
+ *          samplers use vector instructions. Every generator in this directory, and the job generator, samples through
+ *          these functions.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	The sampling library, libsampling.a, holds sampling.c, rng.c, arrival.c, parallel.c, histogram.c, sketch.c and sobol.c.
+ * 	Build it once and link it into each program with the -lm option (and -pthread for programs that use parallel.h).
+ * 	(gcc -O2 -c sampling.c rng.c arrival.c parallel.c histogram.c sketch.c sobol.c && ar rcs libsampling.a *.o)
+ * 	(gcc -O2 -pthread -o program program.c libsampling.a -lm)
+ *
+*******************************************************************************************************************************/
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "rng.h"
+
+#define POISSON_LAMBDA_MAX 1e9       // Largest lambda of fill_poisson(). Samples up to 8 standard deviations above it fit in an int.
+
+// Structure contains an alias table for a discrete distribution over 0 to size - 1. A sample picks a column uniformly and
+// returns the column if the rest of its word is below cut[column], else alias[column].
+struct Alias_Table
+{
+    int size;
+    uint64_t threshold;     // 2^64 mod size. Words whose low bits are below it are rejected.
+    uint64_t *cut;
+    int *alias;
+};
+
+// Structure contains the cumulative distribution table of a discrete distribution over low to low + size - 1, for sampling
+// by inversion. guide[j] is the first value whose cumulative probability is above j / size.
+struct Cdf_Table
+{
+    long low;
+    int size;
+    double *cdf;
+    int *guide;
+};
+
+void fill_uniform(struct Rng *rng, double *out, size_t n, double low, double high);
+void fill_unit(struct Rng *rng, double *out, size_t n);
+void fill_dice(struct Rng *rng, int *out, size_t n, int sides);
+void fill_dice_sums(struct Rng *rng, int *out, size_t n, int count, int sides);
+void dice_pmf(int dice, int sides, double *pmf);
+void alias_setup(struct Alias_Table *table, const double *p, int size);
+void alias_free(struct Alias_Table *table);
+void fill_alias(struct Rng *rng, const struct Alias_Table *table, int *out, size_t n);
+void cdf_setup(struct Cdf_Table *table, const double *p, long low, int size);
+void cdf_free(struct Cdf_Table *table);
+long cdf_inverse(const struct Cdf_Table *table, double u);
+void fill_normal(struct Rng *rng, double *out, size_t n, double mean, double sd);
+void fill_normal_scalar(struct Rng *rng, double *out, size_t n, double mean, double sd);
+void fill_exponential(struct Rng *rng, double *out, size_t n, double mean);
+void fill_poisson(struct Rng *rng, int *out, size_t n, double lambda);
+double poisson_pmf(long k, double lambda);
+double normal_inverse(double p);
+
+#endif
@@ -0,0 +1,199 @@
+/*******************************************************************************************************************************
+ * Quantile Sketch
+ *
+ * Name: sketch.c
+ *
+ * Purpose: Functions for the quantile sketch declared in sketch.h. The bucket of a distance is found from its bits without
+ *          a logarithm: the exponent and the mantissa, read as one fixed-point number, give the base 2 logarithm to within
+ *          its linear interpolation between powers of 2, and multiplying by the number of buckets per binade gives the
+ *          bucket. The interpolation makes the buckets at the start of each binade the widest, so per_binade is chosen for
+ *          them, which takes about 1.44 times as many buckets as an exact logarithm.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sketch.h"
+
+#define SKETCH_LOW_BITS ((uint64_t)(1023 + SKETCH_MIN_EXPONENT) << 52)       // Bits of the double 2^SKETCH_MIN_EXPONENT.
+#define SKETCH_HIGH_BITS ((uint64_t)(1023 + SKETCH_MAX_EXPONENT) << 52)      // Bits of the double 2^SKETCH_MAX_EXPONENT.
+#define SKETCH_NAN_BITS 0x7FF0000000000000ULL                                // Bits of infinity. Larger bits are NaN.
+
+static double bucket_value(const struct Sketch *sketch, int bucket);
+
+
+/**
+ * This function sets up a sketch that counts values by their distance from center, with quantiles accurate to within
+ * alpha times that distance. The program exits with an error message if alpha is not between SKETCH_MIN_ALPHA and 1.
+ * A finer accuracy would need so many buckets per binade that the bucket of a distance no longer fits in the 64-bit
+ * product of sketch_index() (from about 2^25 buckets per binade) or the number of buckets in an int. 		*/
+void sketch_setup(struct Sketch *sketch, double alpha, double center)
+{
+    if(!(alpha >= SKETCH_MIN_ALPHA && alpha < 1))
+    {
+        fprintf(stderr, "Error! The accuracy of a quantile sketch must be at least %g and below 1.\n", SKETCH_MIN_ALPHA);
+        exit(-1);
+    }
+
+    // A bucket from a to a * (1 + 1 / per_binade) is represented by a value within (1 - alpha) / (2 * per_binade) of
+    // each end.
+    sketch->alpha = alpha;
+    sketch->center = center;
+    sketch->per_binade = (int)ceil((1 - alpha) / (2 * alpha));
+    sketch->buckets = (SKETCH_MAX_EXPONENT - SKETCH_MIN_EXPONENT) * sketch->per_binade;
+}
+
+
+/**
+ * This function returns the index in the counters of the value x. 											*/
+static inline int sketch_index(const struct Sketch *sketch, double x)
+{
+    double distance = x - sketch->center;
+    uint64_t bits, magnitude;
+    int bucket;
+
+    memcpy(&bits, &distance, sizeof(bits));
+    magnitude = bits & ~(1ULL << 63);
+
+    if(magnitude < SKETCH_LOW_BITS) {
+        return 0;
+    }
+    if(magnitude > SKETCH_NAN_BITS) {
+        return 2 * sketch->buckets + 1;
+    }
+    if(magnitude >= SKETCH_HIGH_BITS) {
+        bucket = sketch->buckets - 1;
+    }
+
+    // The lowest 20 bits of the mantissa are dropped so the product fits in 64 bits.
+    else {
+        bucket = (int)((((magnitude - SKETCH_LOW_BITS) >> 20) * sketch->per_binade) >> 32);
+    }
+    return 1 + bucket + (int)(bits >> 63) * sketch->buckets;       // Chooses the side without a branch.
+}
+
+
+/**
+ * This function adds the n values in x[] to the counters, count[]. 										*/
+void sketch_add(const struct Sketch *sketch, unsigned long long *count, const double *x, size_t n)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++) {
+        count[sketch_index(sketch, x[i])]++;
+    }
+}
+
+
+/**
+ * This function adds the n integer values in x[] to the counters, count[]. 									*/
+void sketch_add_int(const struct Sketch *sketch, unsigned long long *count, const int *x, size_t n)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++) {
+        count[sketch_index(sketch, x[i])]++;
+    }
+}
+
+
+/**
+ * This function returns the number of values counted by the sketch, not counting NaN. 							*/
+unsigned long long sketch_total(const struct Sketch *sketch, const unsigned long long *count)
+{
+    unsigned long long total = 0;
+    int i;
+
+    for(i = 0; i <= 2 * sketch->buckets; i++) {
+        total += count[i];
+    }
+    return total;
+}
+
+
+/**
+ * This function returns the q quantile of the values counted by the sketch, for q between 0 and 1. It is the value of
+ * the bucket holding the value of rank q * (total - 1), counting from the smallest. NaN is returned if the sketch is
+ * empty. 																									*/
+double sketch_quantile(const struct Sketch *sketch, const unsigned long long *count, double q)
+{
+    unsigned long long total = sketch_total(sketch, count);
+    double rank = q * (total - 1.0);
+    double seen = 0;
+    int bucket;
+
+    if(total == 0) {
+        return NAN;
+    }
+
+    // Values below the center, from the farthest.
+    for(bucket = sketch->buckets - 1; bucket >= 0; bucket--)
+    {
+        seen += count[sketch->buckets + 1 + bucket];
+        if(seen > rank) {
+            return sketch->center - bucket_value(sketch, bucket);
+        }
+    }
+
+    seen += count[0];
+    if(seen > rank) {
+        return sketch->center;
+    }
+
+    // Values above the center, from the nearest.
+    for(bucket = 0; bucket < sketch->buckets; bucket++)
+    {
+        seen += count[1 + bucket];
+        if(seen > rank) {
+            return sketch->center + bucket_value(sketch, bucket);
+        }
+    }
+    return sketch->center + bucket_value(sketch, sketch->buckets - 1);
+}
+
+
+/**
+ * This function returns the share of the values counted by the sketch that are above t. Values in the bucket holding t
+ * are taken as above it if the bucket's value is. 																*/
+double sketch_tail(const struct Sketch *sketch, const unsigned long long *count, double t)
+{
+    unsigned long long total = sketch_total(sketch, count);
+    unsigned long long above = 0;
+    int bucket;
+
+    if(total == 0) {
+        return NAN;
+    }
+    for(bucket = 0; bucket < sketch->buckets; bucket++)
+    {
+        if(sketch->center + bucket_value(sketch, bucket) > t) {
+            above += count[1 + bucket];
+        }
+        if(sketch->center - bucket_value(sketch, bucket) > t) {
+            above += count[sketch->buckets + 1 + bucket];
+        }
+    }
+    if(sketch->center > t) {
+        above += count[0];
+    }
+    return (double)above / total;
+}
+
+
+/**
+ * This function returns the distance that represents a bucket, which is the harmonic mean of its ends, so that every
+ * distance in the bucket is within a relative error of alpha of it. 											*/
+static double bucket_value(const struct Sketch *sketch, int bucket)
+{
+    int binade = bucket / sketch->per_binade;
+    int step = bucket % sketch->per_binade;
+    double low = ldexp(1 + (double)step / sketch->per_binade, binade + SKETCH_MIN_EXPONENT);
+    double high = ldexp(1 + (step + 1.0) / sketch->per_binade, binade + SKETCH_MIN_EXPONENT);
+
+    return 2 * low * high / (low + high);
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************************************************************
+ * Quantile Sketch
+ *
+ * Name: sketch.h
+ *
+ * Purpose: A streaming quantile sketch that needs no range chosen up front. Every value is counted by its distance from a
+ *          center, such as the mean, in a bucket of distances within a relative error of alpha of each other. Any quantile,
+ *          in the tails as well as the middle, is therefore found to within alpha times its distance from the center, and
+ *          so is the threshold of any tail mass. The buckets are spaced logarithmically, so a fixed number of them covers
+ *          distances from 2^SKETCH_MIN_EXPONENT to 2^SKETCH_MAX_EXPONENT, with one more for smaller distances, counted as 0.
+ *          Like a histogram (see histogram.h), the sketch keeps its counters in a caller-provided array of sketch_size()
+ *          elements, and two sketches with the same alpha are merged by adding their counters. It can therefore be fed on
+ *          several threads with parallel_histogram() and gives the same answers for any number of threads.
+ *          Element 0 counts the values at the center, elements 1 to buckets the values above it, elements buckets + 1 to
+ *          2 * buckets the values below it, and the last element counts NaN.
+ *          Source: C. Masson, J. E. Rim and H. K. Lee, "DDSketch: A Fast and Fully-Mergeable Quantile Sketch with
+ *          Relative-Error Guarantees", Proceedings of the VLDB Endowment 12(12), 2019.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Part of the sampling library, libsampling.a (see sampling.h).
+ *
+*******************************************************************************************************************************/
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <stddef.h>
+
+#define SKETCH_MIN_EXPONENT -32     // Distances below 2^-32 are counted as 0.
+#define SKETCH_MAX_EXPONENT 64      // Distances from 2^64 up, and infinities, are counted in the last bucket.
+#define SKETCH_MIN_ALPHA 1e-4       // Finest accuracy, which takes about a million counters (8 MB).
+
+// Structure contains the layout of a quantile sketch.
+struct Sketch
+{
+    double alpha;       // Relative accuracy of the quantiles.
+    double center;      // Value the distances are measured from.
+    int per_binade;     // Number of buckets between each power of 2 and the next.
+    int buckets;        // Number of buckets for each sign.
+};
+
+void sketch_setup(struct Sketch *sketch, double alpha, double center);
+void sketch_add(const struct Sketch *sketch, unsigned long long *count, const double *x, size_t n);
+void sketch_add_int(const struct Sketch *sketch, unsigned long long *count, const int *x, size_t n);
+double sketch_quantile(const struct Sketch *sketch, const unsigned long long *count, double q);
+double sketch_tail(const struct Sketch *sketch, const unsigned long long *count, double t);
+unsigned long long sketch_total(const struct Sketch *sketch, const unsigned long long *count);
+
+// Returns the number of counters used by the sketch.
+static inline int sketch_size(const struct Sketch *sketch)
+{
+    return 2 * sketch->buckets + 2;
+}
+
+#endif
@@ -0,0 +1,230 @@
+/*******************************************************************************************************************************
+ * Sobol Sequence
+ *
+ * Name: sobol.c
+ *
+ * Purpose: Sobol points and their inverse transforms, declared in sobol.h. The points are generated in Gray code order, so
+ *          each point differs from the last by one direction number per dimension. Every aligned block of 2^m indices
+ *          holds the same points as in the natural order, so chunks of PARALLEL_CHUNK points keep the even spread.
+ *          Owen scrambling reverses the bits of a coordinate, so that each bit only depends on the bits that were above it,
+ *          and passes it through Burley's hash, which adds the seed and then XORs the value with even multiples of itself.
+ *          Each step only carries into higher bits, so every bit is flipped by a function of the bits above it and the
+ *          seed, which is a nested uniform scramble. The hash is widened here to 64 bits.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "sobol.h"
+
+// Primitive polynomial and first direction numbers of dimensions 2 to SOBOL_DIMS, from the new-joe-kuo-6.21201 table of
+// Joe and Kuo. The polynomial has degree s and inner coefficients a, from the highest, and m are the first s direction
+// numbers as odd integers. The first dimension is the van der Corput sequence.
+static const struct
+{
+    int s;
+    int a;
+    int m[6];
+} joe_kuo[SOBOL_DIMS - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}}
+};
+
+static uint64_t splitmix64(uint64_t *state);
+
+
+/**
+ * This function returns the next word of the splitmix64 generator, which turns the seed into the scrambling seeds. 	*/
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+/**
+ * This function reverses the order of the bits of x. 															*/
+static inline uint64_t reverse_bits(uint64_t x)
+{
+    x = __builtin_bswap64(x);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    return x;
+}
+
+
+/**
+ * This function returns the coordinate x, a fraction of 2^64, after Owen scrambling with the given seed. 			*/
+static inline uint64_t owen_scramble(uint64_t x, uint64_t seed)
+{
+    x = reverse_bits(x);
+    x += seed;
+    x ^= x * 0x6C50B47CD3A1F0E6ULL;
+    x ^= x * 0xB82F1E5271C9A8D4ULL;
+    x ^= x * 0xC7AFE638E4B2F05AULL;
+    x ^= x * 0x8D22F6E6A5C7D3B2ULL;
+    return reverse_bits(x);
+}
+
+
+/**
+ * This function returns the next coordinate of the stream as a fraction of 2^64, and moves on to the next point after
+ * the last dimension. 																						*/
+static inline uint64_t sobol_next(struct Sobol_Stream *stream)
+{
+    const struct Sobol *sobol = stream->sobol;
+    int d = stream->dim;
+    uint64_t x = stream->x[d];
+    int i;
+
+    if(sobol->scrambled) {
+        x = owen_scramble(x, sobol->seed[d]);
+    }
+
+    // Moves on to the next point in Gray code order, which flips the bit of the lowest set bit of the new index.
+    if(++stream->dim == sobol->dims)
+    {
+        int bit = __builtin_ctzll(++stream->index);
+
+        stream->dim = 0;
+        for(i = 0; i < sobol->dims; i++) {
+            stream->x[i] ^= sobol->direction[i][bit];
+        }
+    }
+    return x;
+}
+
+
+/**
+ * This function sets up a Sobol sequence with the given number of dimensions, from 1 to SOBOL_DIMS. If scrambled is not 0,
+ * the points are Owen scrambled with seeds made from seed. The program exits with an error message if there are too
+ * many dimensions. 																							*/
+void sobol_setup(struct Sobol *sobol, int dims, int scrambled, uint64_t seed)
+{
+    int d, k, j, s, a;
+
+    if(dims < 1 || dims > SOBOL_DIMS)
+    {
+        fprintf(stderr, "Error! A Sobol sequence has from 1 to %d dimensions.\n", SOBOL_DIMS);
+        exit(-1);
+    }
+    sobol->dims = dims;
+    sobol->scrambled = scrambled;
+
+    for(d = 0; d < dims; d++)
+    {
+        uint64_t *v = sobol->direction[d];
+
+        sobol->seed[d] = splitmix64(&seed);
+        if(d == 0)
+        {
+            for(k = 0; k < 64; k++) {
+                v[k] = 1ULL << (63 - k);
+            }
+            continue;
+        }
+
+        // Direction number k is m_k / 2^(k + 1). The first s come from the table, and the rest from the recurrence of the
+        // polynomial: m_k = 2 a_1 m_(k-1) ^ 4 a_2 m_(k-2) ^ ... ^ 2^s m_(k-s) ^ m_(k-s), here on the shifted numbers.
+        s = joe_kuo[d - 1].s;
+        a = joe_kuo[d - 1].a;
+
+        for(k = 0; k < s; k++) {
+            v[k] = (uint64_t)joe_kuo[d - 1].m[k] << (63 - k);
+        }
+        for(k = s; k < 64; k++)
+        {
+            v[k] = v[k - s] ^ (v[k - s] >> s);
+            for(j = 1; j < s; j++)
+            {
+                if((a >> (s - 1 - j)) & 1) {
+                    v[k] ^= v[k - j];
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * This function starts a stream at the point with index first of the Sobol sequence. The point is the XOR of the direction
+ * numbers of the bits of the Gray code of first. 																*/
+void sobol_start(struct Sobol_Stream *stream, const struct Sobol *sobol, uint64_t first)
+{
+    uint64_t gray = first ^ (first >> 1);
+    int d, k;
+
+    stream->sobol = sobol;
+    stream->index = first;
+    stream->dim = 0;
+    for(d = 0; d < sobol->dims; d++)
+    {
+        stream->x[d] = 0;
+        for(k = 0; k < 64; k++)
+        {
+            if((gray >> k) & 1) {
+                stream->x[d] ^= sobol->direction[d][k];
+            }
+        }
+    }
+}
+
+
+/**
+ * This function fills out[] with the next n coordinates of the stream as numbers in (0, 1). Each number is the top 53
+ * bits of the coordinate plus half of 2^-53, so it is never 0 or 1 and can be passed to any inverse distribution
+ * function. 																									*/
+void sobol_fill_unit(struct Sobol_Stream *stream, double *out, size_t n)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++) {
+        out[i] = ((sobol_next(stream) >> 11) + 0.5) * 0x1.0p-53;
+    }
+}
+
+
+/**
+ * This function fills out[] with the next n coordinates of the stream turned into normally distributed numbers with the
+ * given mean and standard deviation (sd) by the inverse normal distribution function. 							*/
+void sobol_fill_normal(struct Sobol_Stream *stream, double *out, size_t n, double mean, double sd)
+{
+    size_t i;
+
+    sobol_fill_unit(stream, out, n);
+    for(i = 0; i < n; i++) {
+        out[i] = mean + sd * normal_inverse(out[i]);
+    }
+}
+
+
+/**
+ * This function fills out[] with the next n coordinates of the stream turned into numbers from the discrete distribution
+ * of the cumulative distribution table. 																		*/
+void sobol_fill_cdf(struct Sobol_Stream *stream, const struct Cdf_Table *table, int *out, size_t n)
+{
+    size_t i;
+
+    for(i = 0; i < n; i++) {
+        out[i] = (int)cdf_inverse(table, ((sobol_next(stream) >> 11) + 0.5) * 0x1.0p-53);
+    }
+}
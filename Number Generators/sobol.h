@@ -0,0 +1,69 @@
+/*******************************************************************************************************************************
+ * Sobol Sequence
+ *
+ * Name: sobol.h
+ *
+ * Purpose: Quasi-random points from the Sobol sequence, for quasi-Monte Carlo in place of the pseudo-random generator of
+ *          rng.h. The first 2^m points of each dimension fall one in each of 2^m equal intervals of [0, 1), and the points
+ *          are spread as evenly in up to SOBOL_DIMS dimensions, so averages and histograms converge at close to 1 / n
+ *          instead of 1 / sqrt(n). Uniform numbers taken from the sequence are turned into other distributions by their
+ *          inverse distribution function, which keeps that even spread.
+ *          The points can be scrambled with Owen's nested uniform scrambling, which keeps the even spread, makes every
+ *          point uniform over [0, 1) and gives the points a different, independent layout for each seed, so the error can
+ *          be estimated by repeating a run with other seeds. The scramble is hashed from the higher bits of each
+ *          coordinate instead of being stored as a tree.
+ *          A stream can start at any index of the sequence in O(64) steps, so each chunk of a parallel run takes its own
+ *          stretch of the same sequence and the points are the same for any number of threads (see
+ *          parallel_sequence_progress()).
+ *          Source: I. M. Sobol', "On the distribution of points in a cube and the approximate evaluation of integrals",
+ *          USSR Computational Mathematics and Mathematical Physics 7(4), 1967, with the direction numbers of S. Joe and
+ *          F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional projections", SIAM Journal on Scientific
+ *          Computing 30(5), 2008, A. B. Owen, "Randomly Permuted (t,m,s)-Nets and (t,s)-Sequences", Monte Carlo and
+ *          Quasi-Monte Carlo Methods in Scientific Computing, 1995, and B. Burley, "Practical Hash-based Owen
+ *          Scrambling", Journal of Computer Graphics Techniques 9(4), 2020.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Part of the sampling library, libsampling.a (see sampling.h).
+ *
+*******************************************************************************************************************************/
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sampling.h"
+
+#define SOBOL_DIMS 16           // Largest number of dimensions.
+
+// Sequences a program can take its numbers from.
+#define SEQUENCE_RANDOM 0       // Pseudo-random numbers from rng.h.
+#define SEQUENCE_SOBOL 1        // Sobol sequence.
+#define SEQUENCE_OWEN 2         // Owen scrambled Sobol sequence.
+
+// Structure contains the direction numbers and scrambling seeds of a Sobol sequence. It is set up once and shared by
+// every stream of the sequence.
+struct Sobol
+{
+    int dims;                               // Number of dimensions of each point.
+    int scrambled;                          // 1 if the points are Owen scrambled, else 0.
+    uint64_t seed[SOBOL_DIMS];              // Scrambling seed of each dimension.
+    uint64_t direction[SOBOL_DIMS][64];     // Direction numbers of each dimension, one per bit of the index.
+};
+
+// Structure contains the position of a stream in a Sobol sequence.
+struct Sobol_Stream
+{
+    const struct Sobol *sobol;
+    uint64_t index;             // Index of the next point.
+    int dim;                    // Dimension of the next coordinate of the point.
+    uint64_t x[SOBOL_DIMS];     // Unscrambled coordinates of the point, as fractions of 2^64.
+};
+
+void sobol_setup(struct Sobol *sobol, int dims, int scrambled, uint64_t seed);
+void sobol_start(struct Sobol_Stream *stream, const struct Sobol *sobol, uint64_t first);
+void sobol_fill_unit(struct Sobol_Stream *stream, double *out, size_t n);
+void sobol_fill_normal(struct Sobol_Stream *stream, double *out, size_t n, double mean, double sd);
+void sobol_fill_cdf(struct Sobol_Stream *stream, const struct Cdf_Table *table, int *out, size_t n);
+
+#endif
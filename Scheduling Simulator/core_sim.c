@@ -0,0 +1,170 @@
+/*******************************************************************************************************************************
+ * Heterogeneous Core Simulator
+ *
+ * Name: core_sim.c
+ *
+ * Purpose: Runs the jobs of each job runtime file, in the format: job size, job arrival[, width], on a machine of fast
+ *          (big) and efficient (little) cores read from a core file (see cores.h), with FIFO, SJF and RR order and each
+ *          placement of jobs on the cores, and with gang scheduling and EASY backfilling, which start each job on as many
+ *          cores as its width. For each run it prints the average response and turnaround time, the longest wait, the
+ *          makespan, the energy and average power of the cores, the throughput per watt, the utilization of the cores,
+ *          the share of their time left idle while jobs waited (fragmentation), how busy each class of cores was and, for
+ *          RR, how often a job resumed on another core. Jobs at least as large as the threshold are big jobs, so with
+ *          the default threshold, the mean job size, the large jobs of job_runtime_2.csv run on the big cores under the
+ *          class placement.
+ *
+ * Usage: ./core_sim [-q quantum] [-t threshold] <core_file> [job_runtime_file ...]
+ *  -q - Ticks an RR job runs before it goes back to the queue. Default = 30.
+ *  -t - Size from which a job is a big job. Default = the mean job size of each file.
+ *  job_runtime_file - Files of jobs. Default = job_runtime_1.csv, job_runtime_2.csv and job_runtime_3.csv.
+ *  (./core_sim Cores/big_little.txt)
+ *  (./core_sim -q 75 -t 200 Cores/server_64.txt job_runtime_2.csv)
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile cores.c, sched_engine.c, timer_wheel.c, snapshot.c and steady_state.c together with the program, with the -lm
+ * 	option.
+ * 	(gcc -O2 -o core_sim core_sim.c cores.c sched_engine.c timer_wheel.c snapshot.c steady_state.c -lm)
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cores.h"
+
+static const char *default_files[] = {"job_runtime_1.csv", "job_runtime_2.csv", "job_runtime_3.csv"};
+
+void Simulate_File(const struct Machine *machine, const char *path, int quantum_size, double threshold);
+
+
+int main(int argc, char *argv[])
+{
+    struct Machine machine;
+    int quantum_size = 30;
+    double threshold = 0;       // 0 for the mean job size of each file.
+    int i;
+
+    // Reads the options and skips over them.
+    while(argc > 2 && (strcmp(argv[1], "-q") == 0 || strcmp(argv[1], "-t") == 0))
+    {
+        if(strcmp(argv[1], "-q") == 0) {
+            quantum_size = atoi(argv[2]);
+        }
+        else if((threshold = atof(argv[2])) <= 0)
+        {
+            fprintf(stderr, "Error! The threshold must be positive.\n");
+            exit(-1);
+        }
+        argv[2] = argv[0];
+        argc -= 2;
+        argv += 2;
+    }
+
+    if(argc < 2 || quantum_size < 1)
+    {
+        fprintf(stderr, "Usage: %s [-q quantum >= 1] [-t threshold > 0] <core_file> [job_runtime_file ...]\n", argv[0]);
+        exit(-1);
+    }
+
+    Load_Machine(argv[1], &machine);
+
+    if(argc == 2)
+    {
+        for(i = 0; i < 3; i++) {
+            Simulate_File(&machine, default_files[i], quantum_size, threshold);
+        }
+    }
+    for(i = 2; i < argc; i++) {
+        Simulate_File(&machine, argv[i], quantum_size, threshold);
+    }
+
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Simulate_File()
+ * Arguments: machine - The cores to run the jobs on.
+ *            path - Name of the job runtime file.
+ *            quantum_size - Ticks an RR job runs before it goes back to the queue.
+ *            threshold - Size from which a job is a big job, or 0 for the mean job size.
+ * Description: Function to run the jobs of a file with each order and placement and print a table of
+ *              the results.
+ * *************************************************************************************************/
+
+void Simulate_File(const struct Machine *machine, const char *path, int quantum_size, double threshold)
+{
+    struct Job *queue;
+    struct Core_Summary summary;
+    struct timespec start, end;
+    char name[16];
+    FILE *fin;
+    double total = 0;
+    int n = 0, i, wide = 0;
+    int discipline, placement;
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!(fin = fopen(path, "r")))
+    {
+        perror("Error! Cannot open the job runtime file");
+        exit(-1);
+    }
+
+    n = Count_Jobs(fin);
+
+    // Prints an error message and exits the program if the memory cannot be allocated.
+    if(!(queue = malloc((n > 0 ? n : 1) * sizeof(struct Job))))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    n = Read_Jobs(fin, queue, n);
+    fclose(fin);
+
+    if(threshold <= 0)
+    {
+        for(i = 0; i < n; i++) {
+            total += queue[i].size;
+        }
+        threshold = (n > 0) ? total / n : 0;
+    }
+    for(i = 0; i < n; i++) {
+        wide += (queue[i].width > 1);
+    }
+
+    printf("%s: %d jobs (%d parallel) on %d cores, big jobs from size %.2f\n", path, n, wide, machine->cores, threshold);
+    printf("%-10s %-9s %13s %14s %10s %11s %13s %9s %10s %6s %6s %8s %8s %10s %9s\n", "Algorithm", "Placement",
+           "Avg Response", "Avg Turnaround", "Max Wait", "Makespan", "Energy", "Avg Power", "Jobs/kT/W", "Util", "Frag",
+           "Big Busy", "Lit Busy", "Migrations", "Time (ms)");
+
+    for(discipline = 0; discipline < NO_OF_DISCIPLINES; discipline++)
+    {
+        if(discipline == CORE_RR) {
+            snprintf(name, sizeof(name), "RR(%d)", quantum_size);
+        }
+        else {
+            snprintf(name, sizeof(name), "%s", discipline_names[discipline]);
+        }
+
+        // Gang scheduling and EASY backfilling place jobs on the fastest idle cores only.
+        for(placement = 0; placement < ((discipline < CORE_GANG) ? NO_OF_PLACEMENTS : 1); placement++)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            Run_Cores(machine, queue, n, discipline, placement, quantum_size, threshold, &summary);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            printf("%-10s %-9s %13.2f %14.2f %10.2f %11.2f %13.1f %9.2f %10.4f %5.1f%% %5.1f%% %7.1f%% %7.1f%% %10lld "
+                   "%9.3f\n", name, placement_names[placement], summary.avg_response, summary.avg_turnaround,
+                   summary.max_wait, summary.makespan, summary.energy, summary.avg_power, summary.throughput_per_watt,
+                   100 * summary.utilization, 100 * summary.fragmentation, 100 * summary.big_busy,
+                   100 * summary.little_busy, summary.migrations,
+                   1e3 * (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e6);
+        }
+    }
+    printf("\n");
+
+    free(queue);
+}
@@ -0,0 +1,882 @@
+/*******************************************************************************************************************************
+ * Heterogeneous Cores
+ *
+ * Name: cores.c
+ *
+ * Purpose: Reads the core files and runs the event-driven simulation of a machine of many cores described in cores.h.
+ *          Everything a run needs is allocated once at its start, so the events themselves allocate nothing.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cores.h"
+
+#define BACKFILL_DEPTH 256      // Jobs behind the head EASY looks at for backfilling, as batch schedulers bound it.
+
+const char *discipline_names[NO_OF_DISCIPLINES] = {"FIFO", "SJF", "RR", "Gang", "EASY"};
+const char *placement_names[NO_OF_PLACEMENTS] = {"any", "class", "prefer"};
+
+// Structure contains the jobs waiting for a core of one class, in a ring (FIFO and RR), a heap by job size (SJF) or,
+// for Gang and EASY, a list linked through job[], so EASY can take out jobs from behind the head.
+struct Ready
+{
+    int *job;
+    int head;
+    int tail;               // Last job of the list.
+    int count;
+};
+
+// Structure contains the state of one run.
+struct Run
+{
+    const struct Machine *machine;
+    struct Job *queue;
+    int n;
+    int discipline;
+    int placement;
+    int quantum_size;
+    int order[MAX_CORE_GROUPS];     // Groups from the fastest to the slowest.
+    int *free[MAX_CORE_GROUPS];     // Stack of the idle cores of each group.
+    int free_count[MAX_CORE_GROUPS];
+    double busy[MAX_CORE_GROUPS];   // Ticks the cores of each group spent running jobs.
+    int idle;                       // Number of idle cores.
+    int *core_group;                // Group of each core.
+    int *core_job;                  // Job running on each core.
+    int *core_next;                 // Next core of the job running on each core, or -1.
+    double *core_event;             // Time of each running job's next event, on the first of its cores.
+    double *core_work;              // Job size the running job completes by its next event.
+    int *heap;                      // First cores of the running jobs, by their next event.
+    int heap_count;
+    double *profile_end;            // Running jobs in order of completion, for EASY.
+    int *profile_job;
+    int profile_count;
+    int *width;                     // Number of cores each job runs on.
+    double *left;                   // Job size left to run of each job.
+    int *last_core;                 // Core each job last ran on, or -1.
+    int *job_class;                 // Class of cores each job waits for.
+    struct Ready ready[2];          // Waiting jobs of each class; with placement any, all wait in ready[0].
+    long long migrations;
+};
+
+static int Parse_Group(const char *text, struct Core_Group *group);
+static void Ready_Push(struct Run *run, struct Ready *ready, int job);
+static int Ready_Pop(struct Run *run, struct Ready *ready);
+static int Smaller_Job(const struct Run *run, int a, int b);
+static void Heap_Push(struct Run *run, int core);
+static int Heap_Pop(struct Run *run);
+static int Idle_Core(struct Run *run, int core_class);
+static double Kth_Speed(const struct Run *run, int k);
+static void Start_Job(struct Run *run, int core, int job, double clock);
+static void Profile_Add(struct Run *run, int job, double end);
+static void Profile_Remove(struct Run *run, int job, double end);
+static void Dispatch(struct Run *run, double clock);
+static void Dispatch_Gang(struct Run *run, double clock);
+static void *Allocate(size_t size);
+
+
+
+/***************************************************************************************************
+ * Function Name: Read_Machine()
+ * Arguments: fin - The core file.
+ *            name - Name of the file, only used in error messages.
+ *            machine - Structure to return the cores in.
+ * Description: Function to read the groups of cores of a machine from a core file. The program exits
+ *              with an error message if the file is not a valid core file.
+ * *************************************************************************************************/
+
+void Read_Machine(FILE *fin, const char *name, struct Machine *machine)
+{
+    char line[256];
+    char key[32];
+    int line_no = 0;
+    int used = 0;
+
+    memset(machine, 0, sizeof(*machine));
+
+    while(fgets(line, sizeof(line), fin))
+    {
+        line_no++;
+
+        // Skips blank lines and comments.
+        if(sscanf(line, "%31s%n", key, &used) != 1 || key[0] == '#') {
+            continue;
+        }
+
+        if(strcmp(key, "cores") != 0)
+        {
+            fprintf(stderr, "Error! %s:%d: Unknown item \"%s\".\n", name, line_no, key);
+            exit(-1);
+        }
+        if(machine->groups == MAX_CORE_GROUPS)
+        {
+            fprintf(stderr, "Error! %s:%d: More than %d groups of cores.\n", name, line_no, MAX_CORE_GROUPS);
+            exit(-1);
+        }
+        if(!Parse_Group(line + used, &machine->group[machine->groups]))
+        {
+            fprintf(stderr, "Error! %s:%d: Invalid cores. (cores <count> <big|little> <speed> <busy power> <idle power>)\n",
+                    name, line_no);
+            exit(-1);
+        }
+        machine->cores += machine->group[machine->groups].count;
+        machine->groups++;
+    }
+
+    if(machine->groups == 0)
+    {
+        fprintf(stderr, "Error! %s: A machine needs at least one group of cores.\n", name);
+        exit(-1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Load_Machine()
+ * Arguments: path - Name of the core file.
+ *            machine - Structure to return the cores in.
+ * Description: Function to read the cores of a machine from the core file at path.
+ * *************************************************************************************************/
+
+void Load_Machine(const char *path, struct Machine *machine)
+{
+    FILE *fin = fopen(path, "r");
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!fin)
+    {
+        perror("Error! Cannot open core file!");
+        exit(-1);
+    }
+
+    Read_Machine(fin, path, machine);
+    fclose(fin);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Run_Cores()
+ * Arguments: machine - The cores to run the jobs on.
+ *            queue - An array of type structure Job, in the order the jobs arrive, used to return the
+ *                    results of each job.
+ *            n - Number of jobs.
+ *            discipline - Order in which waiting jobs are taken, CORE_FIFO, CORE_SJF, CORE_RR,
+ *                         CORE_GANG or CORE_EASY.
+ *            placement - Way of placing the jobs, PLACE_ANY, PLACE_CLASS or PLACE_PREFER.
+ *            quantum_size - Ticks an RR job runs before it goes back to the queue.
+ *            threshold - Size from which a job is a big job.
+ *            summary - Structure to return the totals and averages of the run in.
+ * Description: Function to simulate the jobs on the cores, from event to event, and work out the
+ *              energy the cores use, and how much of their time is used or lost to fragmentation,
+ *              from the first arrival to the last completion.
+ * *************************************************************************************************/
+
+void Run_Cores(const struct Machine *machine, struct Job *queue, int n, int discipline, int placement, int quantum_size,
+               double threshold, struct Core_Summary *summary)
+{
+    struct Run run;
+    int has[2] = {0, 0};        // 1 if the machine has cores of the class, else 0.
+    int core = 0;
+    int arrived = 0;
+    int completed = 0;
+    int g, i, j, job;
+    double clock, first, last = 0, ticks;
+    double busy[2] = {0, 0}, capacity[2] = {0, 0};
+    double stranded = 0;        // Idle core ticks while jobs were waiting.
+
+    memset(summary, 0, sizeof(*summary));
+    if(n == 0) {
+        return;
+    }
+
+    memset(&run, 0, sizeof(run));
+    run.machine = machine;
+    run.queue = queue;
+    run.n = n;
+    run.discipline = discipline;
+    run.placement = (discipline < CORE_GANG) ? placement : PLACE_ANY;
+    run.quantum_size = (quantum_size > 0) ? quantum_size : 1;
+
+    run.core_group = Allocate(machine->cores * sizeof(int));
+    run.core_job = Allocate(machine->cores * sizeof(int));
+    run.core_next = Allocate(machine->cores * sizeof(int));
+    run.core_event = Allocate(machine->cores * sizeof(double));
+    run.core_work = Allocate(machine->cores * sizeof(double));
+    run.heap = Allocate(machine->cores * sizeof(int));
+    run.profile_end = Allocate(machine->cores * sizeof(double));
+    run.profile_job = Allocate(machine->cores * sizeof(int));
+    run.width = Allocate(n * sizeof(int));
+    run.left = Allocate(n * sizeof(double));
+    run.last_core = Allocate(n * sizeof(int));
+    run.job_class = Allocate(n * sizeof(int));
+    run.ready[0].job = Allocate(n * sizeof(int));
+    run.ready[1].job = Allocate(n * sizeof(int));
+
+    // Orders the groups from the fastest to the slowest, keeping the file's order among equally fast ones.
+    for(g = 0; g < machine->groups; g++)
+    {
+        for(i = g; i > 0 && machine->group[run.order[i - 1]].speed < machine->group[g].speed; i--) {
+            run.order[i] = run.order[i - 1];
+        }
+        run.order[i] = g;
+    }
+
+    // Numbers the cores group by group, all idle.
+    for(g = 0; g < machine->groups; g++)
+    {
+        run.free[g] = Allocate(machine->group[g].count * sizeof(int));
+        for(i = 0; i < machine->group[g].count; i++, core++)
+        {
+            run.core_group[core] = g;
+            run.free[g][machine->group[g].count - 1 - i] = core;
+        }
+        run.free_count[g] = machine->group[g].count;
+        run.idle += machine->group[g].count;
+        has[machine->group[g].core_class] = 1;
+    }
+
+    // Sorts each job into a class. A class without cores sends its jobs to the other class.
+    Reset_Jobs(queue, n);
+    for(job = 0; job < n; job++)
+    {
+        run.left[job] = queue[job].size;
+        run.last_core[job] = -1;
+        run.width[job] = (discipline < CORE_GANG) ? 1 : queue[job].width;
+        if(run.width[job] > machine->cores) {
+            run.width[job] = machine->cores;
+        }
+        run.job_class[job] = (queue[job].size >= threshold) ? BIG_CORE : LITTLE_CORE;
+        if(run.placement == PLACE_ANY || !has[run.job_class[job]]) {
+            run.job_class[job] = has[BIG_CORE] ? BIG_CORE : LITTLE_CORE;
+        }
+    }
+
+    first = clock = queue[0].arrival_time;
+
+    while(completed < n)
+    {
+        // The running job with the earliest event goes first; an arrival at the same time waits for it.
+        int finish = run.heap_count > 0 && (arrived == n || run.core_event[run.heap[0]] <= queue[arrived].arrival_time);
+        double next = finish ? run.core_event[run.heap[0]] : queue[arrived].arrival_time;
+
+        if(run.ready[0].count + run.ready[1].count > 0) {
+            stranded += run.idle * (next - clock);
+        }
+        clock = next;
+
+        if(finish)
+        {
+            core = Heap_Pop(&run);
+            job = run.core_job[core];
+            run.left[job] -= run.core_work[core];
+            if(run.discipline == CORE_EASY) {
+                Profile_Remove(&run, job, clock);
+            }
+
+            // Gives back every core of the job.
+            for(; core >= 0; core = run.core_next[core])
+            {
+                g = run.core_group[core];
+                run.free[g][run.free_count[g]++] = core;
+                run.idle++;
+            }
+
+            // Completes the job, or puts it back in the queue at the end of its quantum.
+            if(run.left[job] <= 0)
+            {
+                queue[job].status = 2;
+                queue[job].time_left = 0;
+                queue[job].end_time = clock;
+                queue[job].turnaround = clock - queue[job].arrival_time;
+                last = clock;
+                completed++;
+            }
+            else
+            {
+                queue[job].time_left = run.left[job];
+                Ready_Push(&run, &run.ready[(run.placement == PLACE_ANY) ? 0 : run.job_class[job]], job);
+            }
+        }
+        else
+        {
+            job = arrived++;
+            queue[job].status = 1;
+            Ready_Push(&run, &run.ready[(run.placement == PLACE_ANY) ? 0 : run.job_class[job]], job);
+        }
+
+        Dispatch(&run, clock);
+    }
+
+    // Adds up the averages, and the energy of every core over the makespan.
+    for(job = 0; job < n; job++)
+    {
+        summary->avg_response += queue[job].response_time;
+        summary->avg_turnaround += queue[job].turnaround;
+        if(queue[job].response_time > summary->max_wait) {
+            summary->max_wait = queue[job].response_time;
+        }
+    }
+    summary->avg_response /= n;
+    summary->avg_turnaround /= n;
+    summary->makespan = last - first;
+    summary->migrations = run.migrations;
+
+    for(g = 0; g < machine->groups; g++)
+    {
+        ticks = machine->group[g].count * summary->makespan;
+        summary->energy += machine->group[g].busy_power * run.busy[g] +
+                           machine->group[g].idle_power * (ticks - run.busy[g]);
+        busy[machine->group[g].core_class] += run.busy[g];
+        capacity[machine->group[g].core_class] += ticks;
+    }
+
+    if(summary->makespan > 0) {
+        summary->avg_power = summary->energy / summary->makespan;
+    }
+    if(summary->energy > 0) {
+        summary->throughput_per_watt = 1000.0 * n / summary->energy;
+    }
+    summary->big_busy = (capacity[BIG_CORE] > 0) ? busy[BIG_CORE] / capacity[BIG_CORE] : 0;
+    summary->little_busy = (capacity[LITTLE_CORE] > 0) ? busy[LITTLE_CORE] / capacity[LITTLE_CORE] : 0;
+    if(summary->makespan > 0)
+    {
+        summary->utilization = (busy[BIG_CORE] + busy[LITTLE_CORE]) / (machine->cores * summary->makespan);
+        summary->fragmentation = stranded / (machine->cores * summary->makespan);
+    }
+
+    for(j = 0; j < machine->groups; j++) {
+        free(run.free[j]);
+    }
+    free(run.core_group);
+    free(run.core_job);
+    free(run.core_next);
+    free(run.core_event);
+    free(run.core_work);
+    free(run.heap);
+    free(run.profile_end);
+    free(run.profile_job);
+    free(run.width);
+    free(run.left);
+    free(run.last_core);
+    free(run.job_class);
+    free(run.ready[0].job);
+    free(run.ready[1].job);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Parse_Group()
+ * Arguments: text - The rest of a cores line, after the key.
+ *            group - Structure to return the group of cores in.
+ * Description: Function to read a group of cores. Returns 1 if the group is valid, else 0.
+ * *************************************************************************************************/
+
+static int Parse_Group(const char *text, struct Core_Group *group)
+{
+    char core_class[16];
+
+    if(sscanf(text, "%d %15s %lf %lf %lf", &group->count, core_class, &group->speed, &group->busy_power,
+              &group->idle_power) != 5) {
+        return 0;
+    }
+
+    if(strcmp(core_class, "big") == 0) {
+        group->core_class = BIG_CORE;
+    }
+    else if(strcmp(core_class, "little") == 0) {
+        group->core_class = LITTLE_CORE;
+    }
+    else {
+        return 0;
+    }
+
+    return group->count > 0 && group->speed > 0 && group->busy_power >= 0 && group->idle_power >= 0;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Ready_Push()
+ * Arguments: run - State of the run.
+ *            ready - A queue of waiting jobs.
+ *            job - The job to add.
+ * Description: Function to add a job to a queue of waiting jobs: at the end of the ring or list, or
+ *              into the heap by job size for SJF.
+ * *************************************************************************************************/
+
+static void Ready_Push(struct Run *run, struct Ready *ready, int job)
+{
+    int i, parent;
+
+    if(run->discipline >= CORE_GANG)
+    {
+        if(ready->count++ == 0) {
+            ready->head = job;
+        }
+        else {
+            ready->job[ready->tail] = job;
+        }
+        ready->tail = job;
+        return;
+    }
+
+    if(run->discipline != CORE_SJF)
+    {
+        ready->job[(ready->head + ready->count++) % run->n] = job;
+        return;
+    }
+
+    // Sifts the job up from the bottom of the heap.
+    for(i = ready->count++; i > 0; i = parent)
+    {
+        parent = (i - 1) / 2;
+        if(!Smaller_Job(run, job, ready->job[parent])) {
+            break;
+        }
+        ready->job[i] = ready->job[parent];
+    }
+    ready->job[i] = job;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Ready_Pop()
+ * Arguments: run - State of the run.
+ *            ready - A queue of waiting jobs, not empty.
+ * Description: Function to remove and return the next job of a queue: the first in the ring or list,
+ *              or the smallest in the heap for SJF.
+ * *************************************************************************************************/
+
+static int Ready_Pop(struct Run *run, struct Ready *ready)
+{
+    int job, moved, i, child;
+
+    if(run->discipline >= CORE_GANG)
+    {
+        job = ready->head;
+        ready->head = ready->job[job];
+        ready->count--;
+        return job;
+    }
+
+    if(run->discipline != CORE_SJF)
+    {
+        job = ready->job[ready->head];
+        ready->head = (ready->head + 1) % run->n;
+        ready->count--;
+        return job;
+    }
+
+    // Sifts the last job of the heap down from the top.
+    job = ready->job[0];
+    moved = ready->job[--ready->count];
+    for(i = 0; (child = 2 * i + 1) < ready->count; i = child)
+    {
+        if(child + 1 < ready->count && Smaller_Job(run, ready->job[child + 1], ready->job[child])) {
+            child++;
+        }
+        if(!Smaller_Job(run, ready->job[child], moved)) {
+            break;
+        }
+        ready->job[i] = ready->job[child];
+    }
+    ready->job[i] = moved;
+    return job;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Smaller_Job()
+ * Arguments: run - State of the run.
+ *            a, b - Two jobs.
+ * Description: Function to return 1 if job a goes before job b in SJF order, the smaller first and
+ *              the earlier of two equal jobs first, else 0.
+ * *************************************************************************************************/
+
+static int Smaller_Job(const struct Run *run, int a, int b)
+{
+    if(run->queue[a].size != run->queue[b].size) {
+        return run->queue[a].size < run->queue[b].size;
+    }
+    return a < b;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Heap_Push()
+ * Arguments: run - State of the run.
+ *            core - A core that has just started a job.
+ * Description: Function to add a running core to the heap of running cores by its next event.
+ * *************************************************************************************************/
+
+static void Heap_Push(struct Run *run, int core)
+{
+    int i, parent;
+
+    for(i = run->heap_count++; i > 0; i = parent)
+    {
+        parent = (i - 1) / 2;
+        if(run->core_event[run->heap[parent]] <= run->core_event[core]) {
+            break;
+        }
+        run->heap[i] = run->heap[parent];
+    }
+    run->heap[i] = core;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Heap_Pop()
+ * Arguments: run - State of the run, with at least one core running.
+ * Description: Function to remove and return the running core with the earliest event.
+ * *************************************************************************************************/
+
+static int Heap_Pop(struct Run *run)
+{
+    int core = run->heap[0];
+    int moved = run->heap[--run->heap_count];
+    int i, child;
+
+    for(i = 0; (child = 2 * i + 1) < run->heap_count; i = child)
+    {
+        if(child + 1 < run->heap_count && run->core_event[run->heap[child + 1]] < run->core_event[run->heap[child]]) {
+            child++;
+        }
+        if(run->core_event[run->heap[child]] >= run->core_event[moved]) {
+            break;
+        }
+        run->heap[i] = run->heap[child];
+    }
+    run->heap[i] = moved;
+    return core;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Idle_Core()
+ * Arguments: run - State of the run.
+ *            core_class - Class of core wanted, or -1 for any class.
+ * Description: Function to take the fastest idle core of a class off its group's stack. Returns the
+ *              core, or -1 if no core of the class is idle.
+ * *************************************************************************************************/
+
+static int Idle_Core(struct Run *run, int core_class)
+{
+    int i, g;
+
+    for(i = 0; i < run->machine->groups; i++)
+    {
+        g = run->order[i];
+        if(run->free_count[g] > 0 && (core_class < 0 || run->machine->group[g].core_class == core_class)) {
+            run->idle--;
+            return run->free[g][--run->free_count[g]];
+        }
+    }
+    return -1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Kth_Speed()
+ * Arguments: run - State of the run.
+ *            k - A number of cores, no more than are idle.
+ * Description: Function to return the speed of the k-th fastest idle core, which is the speed a job
+ *              of width k would run at if it started now.
+ * *************************************************************************************************/
+
+static double Kth_Speed(const struct Run *run, int k)
+{
+    int i, g = 0;
+
+    for(i = 0; i < run->machine->groups && k > 0; i++)
+    {
+        g = run->order[i];
+        k -= run->free_count[g];
+    }
+    return run->machine->group[g].speed;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Start_Job()
+ * Arguments: run - State of the run.
+ *            core - An idle core, already taken off its stack.
+ *            job - The job to run on it.
+ *            clock - The simulated time.
+ * Description: Function to run a job on a core, and on the fastest other idle cores up to its width,
+ *              until it completes or, for RR, until its quantum is over, and add the job's next event
+ *              to the heap. The job runs at the speed of the slowest of its cores.
+ * *************************************************************************************************/
+
+static void Start_Job(struct Run *run, int core, int job, double clock)
+{
+    double speed = run->machine->group[run->core_group[core]].speed;
+    double length;              // Ticks to complete the job on these cores.
+    int last = core, other, i;
+
+    if(run->last_core[job] < 0)
+    {
+        run->queue[job].start_time = clock;
+        run->queue[job].response_time = clock - run->queue[job].arrival_time;
+    }
+    else
+    {
+        run->queue[job].context_switch++;
+        if(run->last_core[job] != core) {
+            run->migrations++;
+        }
+    }
+    run->last_core[job] = core;
+
+    // Links the rest of the job's cores to the first.
+    for(i = 1; i < run->width[job]; i++)
+    {
+        other = Idle_Core(run, -1);
+        run->core_next[last] = other;
+        last = other;
+        if(run->machine->group[run->core_group[other]].speed < speed) {
+            speed = run->machine->group[run->core_group[other]].speed;
+        }
+    }
+    run->core_next[last] = -1;
+
+    length = run->left[job] / speed;
+    run->core_job[core] = job;
+    run->core_work[core] = run->left[job];
+    if(run->discipline == CORE_RR && length > run->quantum_size)
+    {
+        length = run->quantum_size;
+        run->core_work[core] = run->quantum_size * speed;
+    }
+    run->core_event[core] = clock + length;
+
+    for(other = core; other >= 0; other = run->core_next[other]) {
+        run->busy[run->core_group[other]] += length;
+    }
+    Heap_Push(run, core);
+    if(run->discipline == CORE_EASY) {
+        Profile_Add(run, job, clock + length);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Profile_Add()
+ * Arguments: run - State of the run.
+ *            job - A job that has just started.
+ *            end - Time the job completes.
+ * Description: Function to add a running job to the profile, in order of completion. The place is
+ *              found by binary search, and the jobs after it are shifted up, so it costs O(running jobs).
+ * *************************************************************************************************/
+
+static void Profile_Add(struct Run *run, int job, double end)
+{
+    int low = 0, high = run->profile_count, middle;
+
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        if(run->profile_end[middle] <= end) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    memmove(&run->profile_end[low + 1], &run->profile_end[low], (run->profile_count - low) * sizeof(double));
+    memmove(&run->profile_job[low + 1], &run->profile_job[low], (run->profile_count - low) * sizeof(int));
+    run->profile_end[low] = end;
+    run->profile_job[low] = job;
+    run->profile_count++;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Profile_Remove()
+ * Arguments: run - State of the run.
+ *            job - A job that has just completed.
+ *            end - Time the job completed.
+ * Description: Function to remove a completed job from the profile. Its place is found by binary
+ *              search for its completion time, and the jobs after it are shifted down, so it costs
+ *              O(running jobs).
+ * *************************************************************************************************/
+
+static void Profile_Remove(struct Run *run, int job, double end)
+{
+    int low = 0, high = run->profile_count, middle;
+
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        if(run->profile_end[middle] < end) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    // Jobs completing at the same time are next to each other.
+    while(run->profile_job[low] != job) {
+        low++;
+    }
+
+    run->profile_count--;
+    memmove(&run->profile_end[low], &run->profile_end[low + 1], (run->profile_count - low) * sizeof(double));
+    memmove(&run->profile_job[low], &run->profile_job[low + 1], (run->profile_count - low) * sizeof(int));
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Dispatch()
+ * Arguments: run - State of the run.
+ *            clock - The simulated time.
+ * Description: Function to start waiting jobs on idle cores until either runs out. Each class's jobs
+ *              first take the idle cores of their own class; with placement prefer, the jobs still
+ *              waiting then take the idle cores of the other class.
+ * *************************************************************************************************/
+
+static void Dispatch(struct Run *run, double clock)
+{
+    int c, core;
+    struct Ready *ready;
+
+    if(run->discipline >= CORE_GANG)
+    {
+        Dispatch_Gang(run, clock);
+        return;
+    }
+
+    if(run->placement == PLACE_ANY)
+    {
+        while(run->ready[0].count > 0 && (core = Idle_Core(run, -1)) >= 0) {
+            Start_Job(run, core, Ready_Pop(run, &run->ready[0]), clock);
+        }
+        return;
+    }
+
+    for(c = BIG_CORE; c <= LITTLE_CORE; c++)
+    {
+        ready = &run->ready[c];
+        while(ready->count > 0 && (core = Idle_Core(run, c)) >= 0) {
+            Start_Job(run, core, Ready_Pop(run, ready), clock);
+        }
+    }
+
+    if(run->placement == PLACE_PREFER)
+    {
+        for(c = BIG_CORE; c <= LITTLE_CORE; c++)
+        {
+            ready = &run->ready[c];
+            while(ready->count > 0 && (core = Idle_Core(run, 1 - c)) >= 0) {
+                Start_Job(run, core, Ready_Pop(run, ready), clock);
+            }
+        }
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Dispatch_Gang()
+ * Arguments: run - State of the run.
+ *            clock - The simulated time.
+ * Description: Function to start waiting jobs, in order of arrival, while the job at the head of the
+ *              queue has enough idle cores. With EASY, the head then gets a reservation, the time at
+ *              which enough running jobs will have completed to free its cores, and each of the next
+ *              BACKFILL_DEPTH jobs behind it that fits on the idle cores starts now if it completes
+ *              by the reservation or uses only cores the head will not need (the extra cores).
+ * *************************************************************************************************/
+
+static void Dispatch_Gang(struct Run *run, double clock)
+{
+    struct Ready *ready = &run->ready[0];
+    int head, job, previous, core, i, cores, extra;
+    double shadow, end;
+
+    while(ready->count > 0 && run->width[ready->head] <= run->idle)
+    {
+        core = Idle_Core(run, -1);
+        Start_Job(run, core, Ready_Pop(run, ready), clock);
+    }
+
+    if(run->discipline != CORE_EASY || ready->count < 2 || run->idle == 0) {
+        return;
+    }
+
+    // Finds the reservation of the head from the profile. The head is wider than the idle cores, so
+    // some running jobs must complete first.
+    head = ready->head;
+    cores = run->idle;
+    for(i = 0; cores < run->width[head]; i++) {
+        cores += run->width[run->profile_job[i]];
+    }
+    shadow = run->profile_end[i - 1];
+    extra = cores - run->width[head];
+
+    // Starts the jobs that do not delay the head, taking them out of the list.
+    previous = head;
+    for(i = 1; i < ready->count && i <= BACKFILL_DEPTH && run->idle > 0; i++)
+    {
+        job = ready->job[previous];
+        if(run->width[job] <= run->idle)
+        {
+            end = clock + run->left[job] / Kth_Speed(run, run->width[job]);
+            if(end <= shadow || run->width[job] <= extra)
+            {
+                if(end > shadow) {
+                    extra -= run->width[job];
+                }
+                ready->job[previous] = ready->job[job];
+                if(job == ready->tail) {
+                    ready->tail = previous;
+                }
+                ready->count--;
+                i--;
+
+                core = Idle_Core(run, -1);
+                Start_Job(run, core, job, clock);
+                continue;
+            }
+        }
+        previous = job;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Allocate()
+ * Arguments: size - Number of bytes.
+ * Description: Function to allocate memory. The program exits with an error message if the memory
+ *              cannot be allocated.
+ * *************************************************************************************************/
+
+static void *Allocate(size_t size)
+{
+    void *memory = malloc(size > 0 ? size : 1);
+
+    if(!memory)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+    return memory;
+}
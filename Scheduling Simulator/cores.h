@@ -0,0 +1,101 @@
+/*******************************************************************************************************************************
+ * Heterogeneous Cores
+ *
+ * Name: cores.h
+ *
+ * Purpose: Runs the jobs of a job runtime file on a machine of many cores, some fast and some slow, and accounts for the
+ *          energy they use. Each core has a speed factor, the units of job size it completes per tick, and the power it
+ *          draws while busy and while idle. The cores are read from a small text file, one group of alike cores per line:
+ *              # Comment
+ *              cores 4 big 2.0 6.0 1.0         Number, class (big or little), speed, busy power and idle power.
+ *              cores 8 little 1.0 1.5 0.2
+ *          Jobs at least as large as a threshold are big jobs and the others are little jobs. Where a job runs is set by
+ *          the placement:
+ *              any     The job takes the fastest idle core.
+ *              class   Big jobs run only on big cores and little jobs only on little cores.
+ *              prefer  Jobs run on a core of their own class if one is idle, else on an idle core of the other class.
+ *          The jobs waiting for a core are taken in FIFO, SJF or RR order; RR jobs go back to the queue when their
+ *          quantum, in ticks of the core they run on, is over, and may resume on another core.
+ *          Parallel jobs, with a width of more than one in the job runtime file (see Read_Jobs()), need that many cores
+ *          at the same time. The Gang and EASY orders start each such job on all its cores together, the fastest idle
+ *          ones, and the job runs at the speed of the slowest of them; FIFO, SJF and RR run every job on one core.
+ *              Gang    Jobs start strictly in order of arrival, so a wide job at the head of the queue holds back the
+ *                      jobs behind it until enough cores are idle.
+ *              EASY    EASY backfilling: the job at the head gets a reservation at the earliest time enough cores will
+ *                      be idle, and the jobs behind it may start on the idle cores as long as they do not delay it,
+ *                      either by completing before the reservation or by using only cores it does not need.
+ *          The reservation is found from a profile of the running jobs in order of completion, so the time from which
+ *          a number of cores are idle is one pass from its start. The Gang and EASY orders ignore the placement, and a
+ *          job wider than the machine is cut to the number of cores.
+ *          Unlike the single-CPU algorithms of sched_engine.h, the simulation steps from event to event (arrivals, ends
+ *          of quanta and completions) rather than tick by tick. The running jobs are kept in a heap ordered by their next
+ *          event and the idle cores in a stack per group, fastest group first, so each event of FIFO, SJF and RR costs
+ *          O(log cores), and the time of a run hardly depends on the number of cores. Gang and EASY cost more: the
+ *          profile is an array sorted by completion time, found by binary search but shifted with memmove() when a job
+ *          starts or completes, so O(running jobs), and on every event EASY walks the profile to the reservation and
+ *          looks at up to BACKFILL_DEPTH waiting jobs behind the head. An event of EASY thus costs
+ *          O(running jobs + BACKFILL_DEPTH), bounded by the number of cores and the depth but not by the number of jobs.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile cores.c together with the program and the scheduler engine.
+ *
+*******************************************************************************************************************************/
+#ifndef CORES_H
+#define CORES_H
+
+#include <stdio.h>
+#include "sched_engine.h"
+
+#define MAX_CORE_GROUPS 16      // Largest number of groups of alike cores in a core file.
+#define NO_OF_DISCIPLINES 5     // Orders in which waiting jobs are taken.
+#define NO_OF_PLACEMENTS 3      // Ways of placing jobs on the cores.
+
+enum Core_Class { BIG_CORE, LITTLE_CORE };
+enum Discipline { CORE_FIFO, CORE_SJF, CORE_RR, CORE_GANG, CORE_EASY };
+enum Placement { PLACE_ANY, PLACE_CLASS, PLACE_PREFER };
+
+// Structure contains a group of alike cores.
+struct Core_Group
+{
+    int count;
+    int core_class;         // BIG_CORE or LITTLE_CORE.
+    double speed;           // Units of job size completed per tick.
+    double busy_power;      // Power drawn per tick while running a job.
+    double idle_power;      // Power drawn per tick while idle.
+};
+
+// Structure contains the cores of a machine.
+struct Machine
+{
+    int groups;
+    int cores;              // Total number of cores in the groups.
+    struct Core_Group group[MAX_CORE_GROUPS];
+};
+
+// Structure contains the totals and averages of one run on a machine.
+struct Core_Summary
+{
+    double avg_response;
+    double avg_turnaround;
+    double max_wait;            // Longest time from a job's arrival to its start.
+    double makespan;            // Ticks from the first arrival to the last completion.
+    double energy;              // Power times ticks, over the makespan, of every core busy or idle.
+    double avg_power;           // Energy per tick of the makespan.
+    double throughput_per_watt; // Jobs completed per 1000 ticks per unit of average power.
+    double big_busy;            // Share of the big and the little cores' time spent running jobs.
+    double little_busy;
+    double utilization;         // Share of all the cores' time spent running jobs.
+    double fragmentation;       // Share of all the cores' time spent idle while jobs were waiting.
+    long long migrations;       // Times an RR job resumed on a different core than it last ran on.
+};
+
+extern const char *discipline_names[NO_OF_DISCIPLINES];
+extern const char *placement_names[NO_OF_PLACEMENTS];
+
+void Read_Machine(FILE *fin, const char *name, struct Machine *machine);
+void Load_Machine(const char *path, struct Machine *machine);
+void Run_Cores(const struct Machine *machine, struct Job *queue, int n, int discipline, int placement, int quantum_size,
+               double threshold, struct Core_Summary *summary);
+
+#endif
@@ -16,131 +16,344 @@
  *          format: job size, job arrival.
  * 
  * 
- * Usage: ./job_generator
+ *          Other mixtures can be described in workload files (see workload.h), one output file being written for each.
+ *          In simulate mode the jobs are not written to files. They are handed to the scheduling algorithms of the
+ *          scheduler in memory and the average response and turnaround time, total number of context switches and overhead
+ *          of each algorithm are printed. With -b the per-job results of each algorithm are also written to a binary
+ *          results file, results_<n>.res, which can be queried without loading it (see results.h and results_query.c).
+ *          With -Q or -O, the jobs are made from a quasi-random Sobol sequence, so the mixture, job sizes and times between
+ *          arrivals follow their distributions much more closely than with random numbers and the averages of the scheduling
+ *          algorithms vary less from one seed to the next.
+ *          With -a, the average response and turnaround time of FIFO and the average turnaround time of processor
+ *          sharing, as a stand-in for RR, are estimated from the moments of each workload by the queueing formulas of
+ *          queueing.h. Alone, -a prints the estimates without generating any jobs; with -s they are printed under the
+ *          simulated results to cross-check them.
+ *          With -p, each algorithm stops as soon as its average turnaround time is known to the given relative precision,
+ *          and the jobs of its warm-up from an empty system are left out of the averages (see steady_state.h). The jobs
+ *          left out, the jobs measured and the precision reached are printed with the results, and stored as the averages
+ *          of the results files. The jobs an algorithm had not completed when it stopped have status 3 in the results files,
+ *          with NaN for the times they never reached.
+ * 
+ * 
+ * Usage: ./job_generator [-a] [-s [-b] [-m snapshot_file [-i interval]] [-p precision]] [-Q | -O] [seed]
+ *                        [workload_file ...]
+ *  -a - Print the analytic estimates of each workload, instead of generating the jobs unless -s is given.
+ *  -s - Simulate the jobs in memory instead of writing them to job_runtime_<n>.csv.
+ *  -b - With -s, write the results of each algorithm to results_<n>.res.
+ *  -m - With -s, write metrics snapshots to the file or named pipe while the algorithms run (see snapshot.h).
+ *  -i - Ticks of simulated time between snapshots. Default = 100000.
+ *  -p - With -s, the relative half-width of the 95% confidence interval of the average turnaround time at which each
+ *       algorithm stops, such as 0.05.
+ *  -Q - Make the jobs from the Sobol sequence, handed to the jobs in an order given by the seed.
+ *  -O - Make the jobs from the Sobol sequence with Owen scrambling, which is also different for each seed.
+ *  The seed is optional and defaults to the current time. The same seed always gives the same jobs.
+ *  The workload files are optional and default to the three mixtures above. The seed has to be given with them.
+ *  (./job_generator -s 42 Workloads/bimodal.txt)
+ *  (./job_generator -s -O 42 Workloads/bimodal.txt)
+ *  (./job_generator -s -b 42 Workloads/poisson.txt)
+ *  (./job_generator -s -m snapshots.jsonl 42 Workloads/bursty.txt)
+ *  (./job_generator -a -s 42 Workloads/poisson.txt)
+ *  (./job_generator -s -p 0.1 42 Workloads/steady.txt)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
- * 	The program uses the rand() function from the stdlib.h library to generate random numbers. 
- * 	The program uses the time.h library to seed the random number generator with the current time.
- * 	The _USE_MATH_DEFINES macro is used to make M_PI available for use in the program and the float.h library
- *  is used to make DBL_EPSILON available.
- * 	Include the -lm option at compile time.
- * 	(gcc job_generator.c -o job_generator -lm)
+ * 	The program uses the batch normal sampler, fill_normal(), from sampling.h with the xoshiro256++ generator from rng.h
+ * 	in the Number Generators directory to generate random numbers, sobol.h to generate quasi-random numbers, and the
+ * 	scheduling algorithms from sched_engine.c, timer_wheel.c, snapshot.c and steady_state.c. Results files are written by
+ * 	results.c and the analytic estimates made by queueing.c.
+ * 	Build the sampling library, libsampling.a, in the Number Generators directory first (see sampling.h) and include the
+ * 	-lm option at compile time.
+ * 	(gcc -O2 job_generator.c workload.c sched_engine.c timer_wheel.c snapshot.c steady_state.c results.c queueing.c "../Number Generators/libsampling.a" -o job_generator -lm)
  * 
 *******************************************************************************************************************************/
-#include<float.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
-#define _USE_MATH_DEFINES
-#include <math.h>
-
-#define NO_OF_JOBS 5000                         // Sets value for the number of jobs to be generated.
+#include "workload.h"
+#include "sched_engine.h"
+#include "results.h"
+#include "snapshot.h"
+#include "steady_state.h"
+#include "../Number Generators/sobol.h"
 
-float scale_factor = 1.0 / (float)RAND_MAX; 	// Used to scale the values returned by the rand() function to [0,1]. Global variable.
+void Write_Jobs(const char *path, const double *size, const double *arrival, int n);
+void Simulate_Jobs(const char *name, const struct Workload *workload, const double *size, const double *arrival,
+                   const char *results_path, int analytic);
 
-float rand_generator(float mean, float sd);
-
-int main() 
+int main(int argc, char *argv[]) 
 {
-    FILE *f1, *f2, *f3;
-
+    int simulate = 0;       // 1 if the jobs are simulated in memory, else 0.
+    int binary = 0;         // 1 if the simulated results are written to results files, else 0.
+    int analytic = 0;       // 1 if the analytic estimates are printed, else 0.
+    struct Moments moments;
+    const char *snapshot_path = NULL;           // File or named pipe the snapshots are written to, if any.
+    long long interval = SNAPSHOT_INTERVAL;     // Ticks of simulated time between snapshots.
+    static struct Snapshots stream;
+    double precision = 0;   // Relative precision at which the algorithms stop, or 0 to run every job.
+    static struct Steady_State detection;
+    int sequence = SEQUENCE_RANDOM;     // Sequence the jobs are made from.
+    int mixtures;           // Number of mixtures generated.
     int i = 0;              // Loop counter.
-	float arrival_time;     // Job arrival time.
-    float job_size;         // Job runtime.
-    float split;            // Used to create the split ratio.
-
-    // Opens files for writting.
-    f1 = fopen("job_runtime_1.csv", "w");
-    f2 = fopen("job_runtime_2.csv", "w");
-    f3 = fopen("job_runtime_3.csv", "w");
-
-    // Prints and error message and exits the program if the output file(s) cannot be openned.
-    if (!(f1 && f2 && f3)) 
-    {           
-        perror("Error! Cannot open output file(s)!");
-        exit(-1);
-    }
-    
+    char name[64];          // Name of the output file or of the built-in mixture.
+    char results_path[64];  // Name of the results file.
+    struct Rng rng;         // State of the random number generator.
+    struct Workload workload;
+    double *size, *arrival;
 
-    srand(time(NULL));		// Seeds the rand() function with the current time.
+    // Reads the options and skips over them.
+    while(argc > 1 && (strcmp(argv[1], "-s") == 0 || strcmp(argv[1], "-b") == 0 || strcmp(argv[1], "-Q") == 0 ||
+                       strcmp(argv[1], "-O") == 0 || strcmp(argv[1], "-m") == 0 || strcmp(argv[1], "-i") == 0 ||
+                       strcmp(argv[1], "-a") == 0 || strcmp(argv[1], "-p") == 0))
+    {
+        if(strcmp(argv[1], "-m") == 0 || strcmp(argv[1], "-i") == 0 || strcmp(argv[1], "-p") == 0)
+        {
+            // Prints an error message and exits the program if the option has no value.
+            if(argc < 3)
+            {
+                fprintf(stderr, "Error! %s needs a value.\n", argv[1]);
+                exit(-1);
+            }
+            if(strcmp(argv[1], "-m") == 0) {
+                snapshot_path = argv[2];
+            }
+            else if(strcmp(argv[1], "-p") == 0)
+            {
+                if((precision = atof(argv[2])) <= 0)
+                {
+                    fprintf(stderr, "Error! The precision must be above 0.\n");
+                    exit(-1);
+                }
+            }
+            else if((interval = atoll(argv[2])) < 1)
+            {
+                fprintf(stderr, "Error! The snapshot interval must be at least 1 tick.\n");
+                exit(-1);
+            }
+            argv[2] = argv[0];
+            argc--;
+            argv++;
+        }
+        else if(strcmp(argv[1], "-s") == 0) {
+            simulate = 1;
+        }
+        else if(strcmp(argv[1], "-b") == 0) {
+            binary = 1;
+        }
+        else if(strcmp(argv[1], "-a") == 0) {
+            analytic = 1;
+        }
+        else if(strcmp(argv[1], "-O") == 0) {
+            sequence = SEQUENCE_OWEN;
+        }
+        else if(sequence == SEQUENCE_RANDOM) {
+            sequence = SEQUENCE_SOBOL;
+        }
+        argv[1] = argv[0];
+        argc--;
+        argv++;
+    }
 
-	// Loop to generate and write to file the arrival time and job runtime for the first mixture of jobs.
-	for(arrival_time = 0.0, i = 0; i < NO_OF_JOBS; i++) 
-    {		
-        job_size = rand_generator(150, 20);
-        arrival_time = arrival_time + rand_generator(75, 20);
-        fprintf(f1, "%.2f,%.2f\n", job_size, arrival_time);
-	}
+    // Opens the stream of snapshots, which the scheduling algorithms write to while they run.
+    if(snapshot_path && simulate)
+    {
+        Snapshots_Open(&stream, snapshot_path, interval);
+        snapshots = &stream;
+    }
 
-    // Loop to generate and write to file the arrival time and job runtime for the second mixture of jobs.
-    for(arrival_time = 0.0, i = 0; i < NO_OF_JOBS; i++) 
+    // Turns on the steady state detection, which stops each scheduling algorithm once its averages are precise enough.
+    if(precision > 0 && simulate)
     {
-        split = rand() * scale_factor;
+        Steady_Open(&detection, precision);
+        steady = &detection;
+    }
+
+    rng_seed(&rng, rng_seed_from_args(argc, argv, 1));     // Seeds the generator with the given seed or the current time.
+    mixtures = (argc > 2) ? argc - 2 : NO_OF_MIXTURES;
 
-        // Splits jobs into two classes.
-        if(split > 0.8) {
-            job_size = rand_generator(250, 15);
-        }       
+    for(i = 0; i < mixtures; i++)
+    {
+        // Reads the workload file or takes the built-in mixture.
+        if(argc > 2) {
+            Load_Workload(argv[i + 2], &workload);
+        }
         else {
-            job_size = rand_generator(50, 10);
+            Default_Workload(i, &workload);
         }
 
-		arrival_time = arrival_time + rand_generator(75, 20);
-        fprintf(f2, "%.2f,%.2f\n", job_size, arrival_time);
-	}
+        // Prints the estimates from the workload alone, without generating its jobs.
+        if(analytic && !simulate)
+        {
+            snprintf(name, sizeof(name), "Mixture %d", i + 1);
+            printf("\n%s (%d jobs)\n", argc > 2 ? argv[i + 2] : name, workload.jobs);
+            Describe_Workload(stdout, &workload);
+            Workload_Moments(&workload, &moments);
+            Print_Estimates(stdout, &moments);
+            continue;
+        }
 
-    // Loop to generate and write to file the arrival time and job runtime for the third mixture of jobs.
-    for(arrival_time = 0.0, i = 0; i < NO_OF_JOBS; i++) 
-    {
-        split = rand() * scale_factor;
+        size = malloc(workload.jobs * sizeof(double));
+        arrival = malloc(workload.jobs * sizeof(double));
+        if(!(size && arrival))
+        {
+            perror("Error! Cannot allocate memory!");
+            exit(-1);
+        }
 
-        // Splits jobs into two classes.
-        if(split < 0.8) {
-            job_size = rand_generator(250, 15);
-        }       
+        if(sequence != SEQUENCE_RANDOM) {
+            Generate_Quasi_Jobs(&rng, sequence == SEQUENCE_OWEN, &workload, size, arrival);
+        }
         else {
-            job_size = rand_generator(50, 10);
+            Generate_Jobs(&rng, &workload, size, arrival);
         }
 
-		arrival_time = arrival_time + rand_generator(75, 20);
-        fprintf(f3, "%.2f,%.2f\n", job_size, arrival_time);
-	}
-
+        if(simulate)
+        {
+            snprintf(name, sizeof(name), "Mixture %d", i + 1);
+            snprintf(results_path, sizeof(results_path), "results_%d.res", i + 1);
+            if(snapshots) {
+                snapshots->run = argc > 2 ? argv[i + 2] : name;
+            }
+            Simulate_Jobs(argc > 2 ? argv[i + 2] : name, &workload, size, arrival, binary ? results_path : NULL,
+                          analytic);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "job_runtime_%d.csv", i + 1);
+            Write_Jobs(name, size, arrival, workload.jobs);
+        }
 
-    // Closes the files.
-    fclose(f1);
-    fclose(f2);
-    fclose(f3);
+        free(size);
+        free(arrival);
+    }
 
+    if(snapshots) {
+        Snapshots_Close(snapshots);
+    }
+    if(steady) {
+        Steady_Close(steady);
+    }
     exit(0);
 }
 
 
 
-/***************************************************************************************************************************
- * Function Name: rand_generator()
- * Arguments: Two float variables - mean and sd.
- * Description: This function generates normally distributed random numbers using the Box-Muller transform method. Outputs 
- *              a random number from the normal distribution.
- * Source: https://en.wikipedia.org/wiki/Box%E2%80%93Muller_transform 											
- * *************************************************************************************************************************/ 
+/***************************************************************************************************
+ * Function Name: Write_Jobs()
+ * Arguments: path - Name of the output file.
+ *            size, arrival - Job runtime and arrival time of each job.
+ *            n - Number of jobs.
+ * Description: Function to write the jobs to a csv file in the format: job size, job arrival.
+ * *************************************************************************************************/
+void Write_Jobs(const char *path, const double *size, const double *arrival, int n)
+{
+    FILE *fout = fopen(path, "w");
+    int i;
+
+    // Prints and error message and exits the program if the output file cannot be openned.
+    if(!fout)
+    {
+        perror("Error! Cannot open output file(s)!");
+        exit(-1);
+    }
+
+    for(i = 0; i < n; i++) {
+        fprintf(fout, "%.2f,%.2f\n", size[i], arrival[i]);
+    }
+    fclose(fout);
+}
+
+
 
-float rand_generator(float mean, float sd) 
+/***************************************************************************************************
+ * Function Name: Simulate_Jobs()
+ * Arguments: name - Name of the workload, printed with the results.
+ *            workload - The workload the jobs were generated from.
+ *            size, arrival - Job runtime and arrival time of each job.
+ *            results_path - Name of the results file to write the results of each algorithm to, or NULL.
+ *            analytic - 1 to print the analytic estimates of the workload under the results, else 0.
+ * Description: Function to run each scheduling algorithm of the scheduler on the jobs in memory and
+ *              print the average response and turnaround time, total number of context switches and
+ *              overhead of each. With steady state detection, the averages are those of the jobs after
+ *              the warm-up, and the jobs left out and measured and the precision reached are printed.
+ * *************************************************************************************************/
+void Simulate_Jobs(const char *name, const struct Workload *workload, const double *size, const double *arrival,
+                   const char *results_path, int analytic)
 {
-	float u1 = 0, u2 = 0;		// Stores the uniformly distributed random numbers
-	float z = 0;				// Stores the randomly generated number after transformation
-	
-	// The value returned by the rand() function is multiplied by the scale_factor and stored in u1 and u2.
-	u1 = rand() * scale_factor;
-	u2 = rand() * scale_factor;
-
-	// This if statement gets rid of infinities caused by the log function when u1 is less than zero.
-	if (u1 < DBL_EPSILON) {
-        u1 = DBL_EPSILON;
+    int n = workload->jobs;
+    struct Job *jobs = malloc(n * sizeof(struct Job));      // Jobs as generated.
+    struct Job *queue = malloc(n * sizeof(struct Job));     // Jobs run by each scheduling algorithm.
+    struct Summary summary;
+    struct Moments moments;
+    struct Results_Writer writer;
+    struct timespec start, end;
+    int i, policy;
+
+    if(!(jobs && queue))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        jobs[i].size = size[i];
+        jobs[i].arrival_time = arrival[i];
+    }
+
+    if(results_path) {
+        Results_Create(&writer, results_path, jobs, n);
+    }
+
+    printf("\n%s (%d jobs)\n", name, n);
+    Describe_Workload(stdout, workload);
+    printf("%-10s %14s %16s %18s %10s", "Algorithm", "Avg Response", "Avg Turnaround", "Context Switches", "Overhead");
+    if(steady) {
+        printf(" %9s %9s %9s", "Warm-up", "Measured", "+/-");
+    }
+    printf("\n");
+
+    for(policy = 0; policy < NO_OF_POLICIES; policy++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        memcpy(queue, jobs, n * sizeof(struct Job));
+        Run_Policy(policy, queue, n);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        Summarize(queue, n, &summary);
+        if(steady)
+        {
+            summary.avg_response = steady->mean_response;
+            summary.avg_turnaround = steady->mean_turnaround;
+        }
+        printf("%-10s %14.2f %16.2f %18d %9.2f%%", policy_names[policy], summary.avg_response, summary.avg_turnaround,
+               summary.total_context_switches, 100 * summary.overhead / summary.cpu_time);
+        if(steady && steady->half_width >= 0) {
+            printf(" %9d %9d %8.2f%%%s", steady->warmup, steady->measured, 100 * steady->half_width,
+                   steady->reached ? "" : " (precision not reached)");
+        }
+        else if(steady) {
+            printf(" %9d %9d %9s (precision not reached)", steady->warmup, steady->measured, "-");
+        }
+        printf("   (%.3f s)\n", (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+        if(results_path) {
+            Results_Add(&writer, policy_names[policy], queue, &summary);
+        }
+    }
+
+    if(analytic)
+    {
+        Workload_Moments(workload, &moments);
+        Print_Estimates(stdout, &moments);
+    }
+
+    if(results_path)
+    {
+        Results_Close(&writer);
+        printf("Results written to %s\n", results_path);
     }
 
-	z = sqrt(-2 * log(u1)) * cos(2 * M_PI * u2);	// Applies the Box-Muller transform formula and stores the value in z.
-	return mean + sd * z;		                    // returns the normally distributed random number.
+    free(jobs);
+    free(queue);
 }
-	
@@ -0,0 +1,313 @@
+/*******************************************************************************************************************************
+ * Load Generator
+ *
+ * Name: load_generator.c
+ *
+ * Purpose: Replays a job runtime file, in the format: job size, job arrival, through the scheduler daemon as fast as the
+ *          daemon answers. The program keeps a simulated clock and, for every event, sends the next job arrival, the
+ *          completion of the running job or the expiry of its quantum, whichever comes first, and runs the job the daemon
+ *          picks. The trace can be repeated to sustain the load, with each repetition shifted to start where the previous
+ *          one ended. The number of decisions per second and the daemon's decision latency are printed at the end.
+ *          Only the jobs from the oldest one not yet completed to the last one that arrived are kept, in a ring whose size
+ *          is a power of 2 and doubles when they no longer fit, so a long replay needs no more memory than the jobs in the
+ *          system at once.
+ *
+ * Usage: ./load_generator <job_runtime_file> [repeat] [socket_path]
+ *  repeat - Number of times the trace is replayed. Default = 1.
+ *  socket_path - Path of the daemon's Unix domain socket. Default = /tmp/scheduler_daemon.sock.
+ *  (./load_generator job_runtime_1.csv 100)
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	The message formats are defined in scheduler_daemon.h.
+ * 	(gcc -O2 load_generator.c -o load_generator)
+ *
+*******************************************************************************************************************************/
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "scheduler_daemon.h"
+
+int Send(int fd, int type, long long job_no, float size, double time, struct Decision *decision);
+double *Grow_Ring(double *ring, long long capacity, long long oldest, long long next);
+
+
+int main(int argc, char *argv[])
+{
+    const char *path = DAEMON_SOCKET;
+    struct sockaddr_un addr;
+    struct Decision decision;
+    struct Request request;
+    struct Stats stats;
+    struct timespec t0, t1;
+    FILE *fin;
+    int fd;
+
+    float *size = NULL;             // Job sizes read from the trace.
+    double *arrival = NULL;         // Job arrival times read from the trace.
+    double *remaining;              // Ring of the time each job in the system still needs on the CPU, NaN once completed.
+    long long ring = 1;             // Size of the ring, a power of 2.
+    int capacity = 0;
+    int n = 0;                      // Number of jobs in the trace.
+    int repeat = 1;                 // Number of times the trace is replayed.
+    float job_size, arrival_time;
+
+    long long total;                // Number of jobs replayed.
+    long long next = 0;             // Next job to arrive.
+    long long oldest = 0;           // Oldest job not yet completed.
+    long long completed = 0;        // Number of jobs completed.
+    long long messages = 0;         // Number of decisions asked for.
+    long long running = -1;         // Job on the CPU, -1 if the CPU is idle.
+    double run_start = 0;           // Time from which the running job's remaining time is counted.
+    double quantum_end = DBL_MAX;   // Time at which the running job's quantum expires.
+    double span;                    // Time shift between repetitions of the trace.
+    double seconds;
+
+    // Reads the trace, repetitions and socket path from the command line.
+    if(argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <job_runtime_file> [repeat] [socket_path]\n", argv[0]);
+        exit(-1);
+    }
+    if(argc > 2) {
+        repeat = atoi(argv[2]);
+    }
+    if(argc > 3) {
+        path = argv[3];
+    }
+    if(repeat <= 0)
+    {
+        fprintf(stderr, "Error! The number of repetitions must be positive.\n");
+        exit(-1);
+    }
+
+    fin = fopen(argv[1], "r");
+    if(!fin)
+    {
+        perror("Error! Cannot open input file!");
+        exit(-1);
+    }
+
+    // Loop to read the job runtime and arrival time into the arrays.
+    while(fscanf(fin, "%f,%f", &job_size, &arrival_time) == 2)
+    {
+        if(n == capacity)
+        {
+            capacity = capacity ? 2 * capacity : 8192;
+            size = realloc(size, capacity * sizeof(float));
+            arrival = realloc(arrival, capacity * sizeof(double));
+            if(!(size && arrival))
+            {
+                perror("Error! Cannot allocate memory!");
+                exit(-1);
+            }
+        }
+        size[n] = job_size;
+        arrival[n] = arrival_time;
+        n++;
+    }
+    fclose(fin);
+
+    if(n == 0)
+    {
+        fprintf(stderr, "Error! No jobs in %s\n", argv[1]);
+        exit(-1);
+    }
+
+    total = (long long)n * repeat;
+    span = arrival[n - 1];
+    while(ring < n) {
+        ring *= 2;
+    }
+    remaining = Grow_Ring(NULL, ring, 0, 0);
+
+    // Connects to the daemon.
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("Error! Cannot connect to the scheduler daemon!");
+        exit(-1);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    // Loops until all jobs are completed.
+    while(completed < total)
+    {
+        double t_arrival = DBL_MAX, t_done = DBL_MAX, t_event;
+        int type;
+        long long job;
+
+        if(next < total) {
+            t_arrival = arrival[next % n] + span * (next / n);
+        }
+        if(running >= 0) {
+            t_done = run_start + remaining[running & (ring - 1)];
+        }
+
+        // Picks the earliest of the next arrival, the running job's completion and its quantum expiry.
+        if(t_arrival <= t_done && t_arrival <= quantum_end)
+        {
+            type = MSG_ARRIVAL;
+            job = next;
+            t_event = t_arrival;
+
+            // Doubles the ring if every place is taken by a job still in the system.
+            if(next - oldest == ring)
+            {
+                remaining = Grow_Ring(remaining, ring, oldest, next);
+                ring *= 2;
+            }
+            remaining[next & (ring - 1)] = size[next % n];
+            next++;
+        }
+        else if(t_done <= quantum_end)
+        {
+            type = MSG_COMPLETE;
+            job = running;
+            t_event = t_done;
+            completed++;
+        }
+        else
+        {
+            type = MSG_EXPIRE;
+            job = running;
+            t_event = quantum_end;
+        }
+
+        // Charges the running job for the time it spent on the CPU.
+        if(running >= 0)
+        {
+            remaining[running & (ring - 1)] -= t_event - run_start;
+            run_start = t_event;
+        }
+
+        if(!Send(fd, type, job, (type == MSG_ARRIVAL) ? remaining[job & (ring - 1)] : 0, t_event, &decision))
+        {
+            fprintf(stderr, "Error! Lost connection to the scheduler daemon.\n");
+            exit(-1);
+        }
+        messages++;
+
+        // Frees the place of a completed job, and of the completed jobs after the oldest one still in the system.
+        if(type == MSG_COMPLETE)
+        {
+            remaining[job & (ring - 1)] = NAN;
+            while(oldest < next && isnan(remaining[oldest & (ring - 1)])) {
+                oldest++;
+            }
+        }
+
+        // Runs the job picked by the daemon. A new quantum starts whenever a job is put on the CPU.
+        if(decision.job_no != running || type == MSG_EXPIRE)
+        {
+            running = decision.job_no;
+            run_start = t_event;
+            quantum_end = (running >= 0 && decision.quantum > 0) ? t_event + decision.quantum : DBL_MAX;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    // Asks the daemon for its decision latency.
+    memset(&request, 0, sizeof(request));
+    request.type = MSG_STATS;
+    if(write(fd, &request, sizeof(request)) != sizeof(request) || read(fd, &stats, sizeof(stats)) != sizeof(stats))
+    {
+        fprintf(stderr, "Error! Cannot read statistics from the scheduler daemon.\n");
+        exit(-1);
+    }
+    close(fd);
+
+    printf("Jobs: %lld\nDecisions: %lld\nSimulated time: %.2f\nWall time: %.3f s\nDecisions per second: %.0f\n", total,
+    messages, run_start, seconds, messages / seconds);
+    printf("Daemon decisions: %lld\nLatency p50: %.0f ns\nLatency p99: %.0f ns\nLatency max: %.0f ns\n", stats.decisions,
+    stats.p50, stats.p99, stats.max);
+
+    free(size);
+    free(arrival);
+    free(remaining);
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Grow_Ring()
+ * Arguments: ring - Ring of the remaining times of the jobs in the system, NULL for a new ring.
+ *            capacity - Size of the ring, a power of 2.
+ *            oldest - Oldest job not yet completed.
+ *            next - Next job to arrive.
+ * Description: Function to return a ring of twice the size, or of the given size for a new ring,
+ *              holding the jobs from oldest to next - 1 in the places of their job numbers. The
+ *              program exits with an error message if the memory cannot be allocated.
+ * *************************************************************************************************/
+double *Grow_Ring(double *ring, long long capacity, long long oldest, long long next)
+{
+    long long size = ring ? 2 * capacity : capacity;
+    double *grown = malloc(size * sizeof(double));
+    long long job;
+
+    if(!grown)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+    for(job = oldest; job < next; job++) {
+        grown[job & (size - 1)] = ring[job & (capacity - 1)];
+    }
+    free(ring);
+    return grown;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Send()
+ * Arguments: fd - Socket connected to the daemon.
+ *            type - Request type.
+ *            job_no - Job the event belongs to.
+ *            size - Job size, only used for arrivals.
+ *            time - Time at which the event happened.
+ *            decision - Used to return the daemon's dispatch decision.
+ * Description: Function to send an event to the daemon and wait for its decision. Returns 0 if the
+ *              connection was lost, else 1.
+ * *************************************************************************************************/
+int Send(int fd, int type, long long job_no, float size, double time, struct Decision *decision)
+{
+    struct Request request;
+    char *p = (char *)decision;
+    size_t len = sizeof(*decision);
+
+    memset(&request, 0, sizeof(request));
+    request.type = type;
+    request.job_no = job_no;
+    request.size = size;
+    request.time = time;
+
+    if(write(fd, &request, sizeof(request)) != sizeof(request)) {
+        return 0;
+    }
+
+    // Loop to read the whole decision.
+    while(len > 0)
+    {
+        ssize_t r = read(fd, p, len);
+        if(r <= 0) {
+            return 0;
+        }
+        p += r;
+        len -= r;
+    }
+    return 1;
+}
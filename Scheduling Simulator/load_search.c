@@ -0,0 +1,681 @@
+/*******************************************************************************************************************************
+ * Load Search
+ *
+ * Name: load_search.c
+ *
+ * Purpose: Finds the highest load each scheduling algorithm can sustain before a service level objective (SLO) is broken,
+ *          such as the 99th percentile of the response time staying below a threshold. The jobs of each mixture are either
+ *          read from a job runtime file, in the format: job size, job arrival, or generated from a workload file (see
+ *          workload.h). To run them at a given utilization, the share of the CPU's time needed by the jobs, the times
+ *          between their arrivals are all scaled by the same factor, so the order of the jobs and the shape of their
+ *          arrivals, bursts and all, are kept. The utilization at which the metric crosses the threshold is then found by
+ *          binary search, assuming the metric grows with the load: a probe that meets the SLO raises the lower end of the
+ *          interval and one that breaks it lowers the upper end, until the interval is narrower than the tolerance.
+ *          The searches of every algorithm and mixture are independent, so they run in parallel, one search per thread at
+ *          a time, and a table of the highest sustainable utilization of each is printed at the end.
+ *          With -a, the searches of FIFO, and of RR for the mean turnaround time, start from the utilization at which the
+ *          analytic estimate of queueing.h (FIFO, and processor sharing for RR) meets the threshold. The estimate is
+ *          bracketed by two probes BRACKET tolerances either side of it before bisecting, which saves about half the
+ *          probes when it is close and costs a probe or two when it is not. The estimate is printed next to the result.
+ *
+ * Usage: ./load_search [-a] [-m metric] [-t threshold] [-r low,high] [-e tolerance] [-s seed] [-j threads] [file ...]
+ *  -a - Start the searches that have an analytic estimate from it.
+ *  -m - The SLO metric: mean_response, mean_turnaround, or pNN_response or pNN_turnaround for the NNth percentile, such
+ *       as p99_response or p99.9_turnaround. Default = p99_response.
+ *  -t - The largest value of the metric that meets the SLO, in ticks. Default = 10 times the mean job size of each mixture.
+ *  -r - The range of utilizations searched. Default = 0.05,1.
+ *  -e - The search stops once the highest sustainable utilization is known to within this. Default = 0.005.
+ *  -s - Seed of the jobs generated from workload files. Default = the current time.
+ *  -j - Number of searches run at the same time. Default = the number of CPUs.
+ *  The files are job runtime files, named *.csv, or workload files, and default to the three built-in mixtures.
+ *  (./load_search job_runtime_1.csv job_runtime_2.csv job_runtime_3.csv)
+ *  (./load_search -m p99.9_turnaround -t 20000 -s 42 Workloads/bursty.txt Workloads/poisson.txt)
+ *  (./load_search -a -m mean_response -s 42 Workloads/poisson.txt)
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	The jobs are run by the scheduling algorithms of sched_engine.c and generated by workload.c with the sampling library,
+ * 	libsampling.a, from the Number Generators directory (see sampling.h). Include the -lm and -pthread options at compile
+ * 	time. The analytic estimates are made by queueing.c.
+ * 	(gcc -O2 -pthread -o load_search load_search.c workload.c sched_engine.c timer_wheel.c snapshot.c steady_state.c queueing.c "../Number Generators/libsampling.a" -lm)
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "workload.h"
+#include "sched_engine.h"
+#include "../Number Generators/parallel.h"
+
+#define MAX_MIXTURES 32         // Largest number of mixtures searched.
+#define BRACKET 4               // Tolerances either side of an analytic estimate probed first.
+
+// Structure contains the jobs of one mixture.
+struct Mixture
+{
+    char name[64];
+    int n;
+    struct Job *jobs;           // Jobs with their arrival times as given.
+    double utilization;         // Utilization of the jobs as given.
+    double threshold;           // Largest value of the metric that meets the SLO.
+    struct Moments moments;     // Moments of the jobs as given, for the analytic estimates.
+};
+
+// Structure contains the SLO metric.
+struct Metric
+{
+    char name[32];
+    double quantile;            // Quantile of the times, or a negative number for their mean.
+    int turnaround;             // 1 for the turnaround time, 0 for the response time.
+};
+
+// Structure contains the search of one scheduling algorithm on one mixture.
+struct Search
+{
+    const struct Mixture *mixture;
+    int policy;
+    double load;                // Highest utilization found to meet the SLO.
+    double value;               // Value of the metric at that utilization.
+    int below;                  // 1 if the SLO is broken even at the lowest utilization searched.
+    int above;                  // 1 if the SLO is met even at the highest utilization searched.
+    int probes;                 // Number of simulations run.
+    double guess;               // Analytic estimate of the highest sustainable utilization, or 0 if there is none.
+};
+
+// Structure contains the searches shared by the threads.
+struct Search_Pool
+{
+    struct Search *searches;
+    int count;
+    int next;                   // Index of the next search to run.
+    struct Metric metric;
+    double low, high;           // Range of utilizations searched.
+    double tolerance;
+    pthread_mutex_t lock;
+};
+
+void Parse_Metric(const char *arg, struct Metric *metric);
+void Read_Mixture(const char *path, struct Mixture *mixture);
+void Generate_Mixture(struct Rng *rng, const struct Workload *workload, const char *name, struct Mixture *mixture);
+void Measure_Mixture(struct Mixture *mixture);
+void *Run_Searches(void *arg);
+void Run_Search(struct Search *search, const struct Search_Pool *pool);
+double Analytic_Load(const struct Search *search, const struct Search_Pool *pool);
+double Analytic_Value(const struct Search *search, const struct Metric *metric, double utilization);
+double Probe(const struct Search *search, const struct Metric *metric, double utilization, struct Job *queue,
+             float *times);
+int Compare_Floats(const void *a, const void *b);
+
+
+int main(int argc, char *argv[])
+{
+    static struct Mixture mixtures[MAX_MIXTURES];
+    struct Search_Pool pool;
+    struct Workload workload;
+    struct Rng rng;
+    pthread_t *workers;
+    char *seed_args[2] = {argv[0], NULL};   // Seed given on the command line, if any.
+    double threshold = 0;       // Threshold given on the command line, or 0 for the default of each mixture.
+    int threads = parallel_default_threads();
+    int analytic = 0;           // 1 if the searches start from the analytic estimates, else 0.
+    int count, option, i, t;
+
+    Parse_Metric("p99_response", &pool.metric);
+    pool.low = 0.05;
+    pool.high = 1;
+    pool.tolerance = 0.005;
+
+    // Reads the options.
+    while((option = getopt(argc, argv, "am:t:r:e:s:j:")) != -1)
+    {
+        switch(option)
+        {
+            case 'a': analytic = 1; break;
+            case 'm': Parse_Metric(optarg, &pool.metric); break;
+            case 't': threshold = atof(optarg); break;
+            case 'r':
+                if(sscanf(optarg, "%lf,%lf", &pool.low, &pool.high) != 2) {
+                    pool.low = -1;
+                }
+                break;
+            case 'e': pool.tolerance = atof(optarg); break;
+            case 's': seed_args[1] = optarg; break;
+            case 'j': threads = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-a] [-m metric] [-t threshold] [-r low,high] [-e tolerance] [-s seed] "
+                        "[-j threads] [file ...]\n", argv[0]);
+                exit(-1);
+        }
+    }
+
+    // Prints an error message and exits the program if the search cannot be run.
+    if(pool.low <= 0 || pool.high <= pool.low || pool.tolerance <= 0 || threshold < 0 || threads < 1)
+    {
+        fprintf(stderr, "Error! The range must be 0 < low < high, and the tolerance, threshold and threads positive.\n");
+        exit(-1);
+    }
+    if(argc - optind > MAX_MIXTURES)
+    {
+        fprintf(stderr, "Error! At most %d mixtures can be searched.\n", MAX_MIXTURES);
+        exit(-1);
+    }
+
+    rng_seed(&rng, rng_seed_from_args(seed_args[1] ? 2 : 1, seed_args, 1));  // Seeds with the given seed or the time.
+
+    // Reads or generates the jobs of each mixture.
+    count = (optind < argc) ? argc - optind : NO_OF_MIXTURES;
+    for(i = 0; i < count; i++)
+    {
+        const char *path = (optind < argc) ? argv[optind + i] : NULL;
+        size_t length = path ? strlen(path) : 0;
+        char name[64];
+
+        if(length > 4 && strcmp(path + length - 4, ".csv") == 0) {
+            Read_Mixture(path, &mixtures[i]);
+        }
+        else
+        {
+            if(path) {
+                Load_Workload(path, &workload);
+            }
+            else {
+                Default_Workload(i, &workload);
+            }
+            snprintf(name, sizeof(name), "Mixture %d", i + 1);
+            Generate_Mixture(&rng, &workload, path ? path : name, &mixtures[i]);
+        }
+
+        Measure_Mixture(&mixtures[i]);
+        if(threshold > 0) {
+            mixtures[i].threshold = threshold;
+        }
+    }
+
+    // Sets up one search for each scheduling algorithm and mixture.
+    pool.count = count * NO_OF_POLICIES;
+    pool.next = 0;
+    pool.searches = calloc(pool.count, sizeof(struct Search));
+    workers = malloc(threads * sizeof(pthread_t));
+    if(!(pool.searches && workers))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+    for(i = 0; i < pool.count; i++)
+    {
+        pool.searches[i].mixture = &mixtures[i / NO_OF_POLICIES];
+        pool.searches[i].policy = i % NO_OF_POLICIES;
+        if(analytic) {
+            pool.searches[i].guess = Analytic_Load(&pool.searches[i], &pool);
+        }
+    }
+    pthread_mutex_init(&pool.lock, NULL);
+
+    printf("Highest utilization with %s <= threshold, searched from %.3f to %.3f to within %.3f\n", pool.metric.name,
+           pool.low, pool.high, pool.tolerance);
+    for(i = 0; i < count; i++)
+    {
+        printf("%s: %d jobs, utilization %.3f as given, threshold %.2f ticks\n", mixtures[i].name, mixtures[i].n,
+               mixtures[i].utilization, mixtures[i].threshold);
+    }
+    fflush(stdout);
+
+    // Runs the searches on the given number of threads.
+    if(threads > pool.count) {
+        threads = pool.count;
+    }
+    for(t = 0; t < threads; t++)
+    {
+        if(pthread_create(&workers[t], NULL, Run_Searches, &pool) != 0)
+        {
+            perror("Error! Cannot create thread!");
+            exit(-1);
+        }
+    }
+    for(t = 0; t < threads; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    // Prints the highest sustainable utilization of each scheduling algorithm on each mixture.
+    printf("\n%-24s %-10s %10s %16s %8s %10s\n", "Mixture", "Algorithm", "Max Load", pool.metric.name, "Probes",
+           analytic ? "Analytic" : "");
+    for(i = 0; i < pool.count; i++)
+    {
+        const struct Search *search = &pool.searches[i];
+        char load[16];
+        char guess[16] = "";
+
+        if(search->below) {
+            snprintf(load, sizeof(load), "< %.3f", pool.low);
+        }
+        else if(search->above) {
+            snprintf(load, sizeof(load), ">= %.3f", pool.high);
+        }
+        else {
+            snprintf(load, sizeof(load), "%.3f", search->load);
+        }
+        if(analytic) {
+            snprintf(guess, sizeof(guess), (search->guess > 0) ? "%.3f" : "-", search->guess);
+        }
+        printf("%-24s %-10s %10s %16.2f %8d %10s\n", search->mixture->name, policy_names[search->policy], load,
+               search->value, search->probes, guess);
+    }
+
+    for(i = 0; i < count; i++) {
+        free(mixtures[i].jobs);
+    }
+    free(pool.searches);
+    free(workers);
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Parse_Metric()
+ * Arguments: arg - Name of the metric, such as p99_response.
+ *            metric - Structure used to return the metric.
+ * Description: Function to read the SLO metric. The program exits with an error message if it is not
+ *              one of the metrics.
+ * *************************************************************************************************/
+void Parse_Metric(const char *arg, struct Metric *metric)
+{
+    const char *kind = strchr(arg, '_');
+    char *end;
+
+    if(kind && strncmp(arg, "mean_", 5) == 0) {
+        metric->quantile = -1;
+    }
+    else if(kind && arg[0] == 'p')
+    {
+        metric->quantile = strtod(arg + 1, &end) / 100;
+        if(end != kind || metric->quantile <= 0 || metric->quantile > 1) {
+            kind = NULL;
+        }
+    }
+    else {
+        kind = NULL;
+    }
+
+    if(!kind || (strcmp(kind, "_response") != 0 && strcmp(kind, "_turnaround") != 0) || strlen(arg) >= sizeof(metric->name))
+    {
+        fprintf(stderr, "Error! %s is not a metric such as mean_response or p99_turnaround.\n", arg);
+        exit(-1);
+    }
+    metric->turnaround = (strcmp(kind, "_turnaround") == 0);
+    strcpy(metric->name, arg);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Read_Mixture()
+ * Arguments: path - Name of a job runtime file.
+ *            mixture - Structure used to return the jobs.
+ * Description: Function to read the jobs of a job runtime file, in increasing order of arrival time.
+ *              The program exits with an error message if the file cannot be read.
+ * *************************************************************************************************/
+void Read_Mixture(const char *path, struct Mixture *mixture)
+{
+    FILE *fin = fopen(path, "r");
+    int n;
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!fin)
+    {
+        perror("Error! Cannot open the job runtime file");
+        exit(-1);
+    }
+
+    n = Count_Jobs(fin);
+
+    mixture->jobs = malloc((n > 0 ? n : 1) * sizeof(struct Job));
+    if(!mixture->jobs)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+    mixture->n = Read_Jobs(fin, mixture->jobs, n);
+    snprintf(mixture->name, sizeof(mixture->name), "%s", path);
+    fclose(fin);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Generate_Mixture()
+ * Arguments: rng - The random number generator.
+ *            workload - The workload the jobs are generated from.
+ *            name - Name of the mixture.
+ *            mixture - Structure used to return the jobs.
+ * Description: Function to generate the jobs of a workload.
+ * *************************************************************************************************/
+void Generate_Mixture(struct Rng *rng, const struct Workload *workload, const char *name, struct Mixture *mixture)
+{
+    int n = workload->jobs;
+    double *size = malloc(n * sizeof(double));
+    double *arrival = malloc(n * sizeof(double));
+    int i;
+
+    mixture->jobs = malloc(n * sizeof(struct Job));
+    if(!(size && arrival && mixture->jobs))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    Generate_Jobs(rng, workload, size, arrival);
+    for(i = 0; i < n; i++)
+    {
+        mixture->jobs[i].size = size[i];
+        mixture->jobs[i].arrival_time = arrival[i];
+    }
+    mixture->n = n;
+    snprintf(mixture->name, sizeof(mixture->name), "%s", name);
+
+    free(size);
+    free(arrival);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Measure_Mixture()
+ * Arguments: mixture - The jobs of a mixture.
+ * Description: Function to find the utilization of the jobs as given, the total job size over the time
+ *              from the first arrival to the last, and the default threshold of 10 times the mean job
+ *              size. The program exits with an error message if the arrivals cannot be scaled.
+ * *************************************************************************************************/
+void Measure_Mixture(struct Mixture *mixture)
+{
+    double total = 0;
+    double span;
+    int i;
+
+    for(i = 0; i < mixture->n; i++) {
+        total += mixture->jobs[i].size;
+    }
+    span = (mixture->n > 1) ? mixture->jobs[mixture->n - 1].arrival_time - mixture->jobs[0].arrival_time : 0;
+
+    // Prints an error message and exits the program if the jobs do not arrive over a period of time.
+    if(span <= 0 || total <= 0)
+    {
+        fprintf(stderr, "Error! The jobs of %s must have positive sizes and arrive over a period of time.\n", mixture->name);
+        exit(-1);
+    }
+
+    mixture->utilization = total / span;
+    mixture->threshold = 10 * total / mixture->n;
+    Trace_Moments(mixture->jobs, mixture->n, &mixture->moments);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Run_Searches()
+ * Arguments: arg - The searches shared by the threads.
+ * Description: Function to run searches from the pool until none are left. Runs on each thread.
+ * *************************************************************************************************/
+void *Run_Searches(void *arg)
+{
+    struct Search_Pool *pool = arg;
+    int s;
+
+    for(;;)
+    {
+        pthread_mutex_lock(&pool->lock);
+        s = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if(s >= pool->count) {
+            return NULL;
+        }
+        Run_Search(&pool->searches[s], pool);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Run_Search()
+ * Arguments: search - The search of one scheduling algorithm on one mixture.
+ *            pool - The metric, range and tolerance of the search.
+ * Description: Function to binary search the highest utilization at which the scheduling algorithm
+ *              meets the SLO on the mixture. With an analytic estimate, the two utilizations BRACKET
+ *              tolerances either side of it are probed first, and the ends of the range only if they
+ *              are still needed.
+ * *************************************************************************************************/
+void Run_Search(struct Search *search, const struct Search_Pool *pool)
+{
+    int n = search->mixture->n;
+    struct Job *queue = malloc(n * sizeof(struct Job));     // Jobs run by each probe.
+    float *times = malloc(n * sizeof(float));               // Response or turnaround times of each probe.
+    double threshold = search->mixture->threshold;
+    double low = pool->low, high = pool->high, middle, value;
+    int met = 0;                // 1 if the SLO is known to be met at low, else 0.
+    int broken = 0;             // 1 if the SLO is known to be broken at high, else 0.
+
+    if(!(queue && times))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    search->probes = 0;
+
+    // Brackets the analytic estimate: the probe below it raises low if it meets the SLO, else lowers high.
+    if(search->guess > low && search->guess < high)
+    {
+        middle = (search->guess - BRACKET * pool->tolerance > low) ? search->guess - BRACKET * pool->tolerance : low;
+        value = Probe(search, &pool->metric, middle, queue, times);
+        search->probes++;
+
+        if(value <= threshold)
+        {
+            low = middle;
+            met = 1;
+            search->load = middle;
+            search->value = value;
+
+            middle = (search->guess + BRACKET * pool->tolerance < high) ? search->guess + BRACKET * pool->tolerance : high;
+            value = Probe(search, &pool->metric, middle, queue, times);
+            search->probes++;
+            if(value <= threshold)
+            {
+                low = middle;
+                search->load = middle;
+                search->value = value;
+            }
+            else
+            {
+                high = middle;
+                broken = 1;
+            }
+        }
+        else
+        {
+            high = middle;
+            broken = 1;
+        }
+    }
+
+    // If the SLO is met at the highest utilization or broken at the lowest, there is nothing to search.
+    if(!broken)
+    {
+        value = Probe(search, &pool->metric, high, queue, times);
+        search->probes++;
+        if(value <= threshold)
+        {
+            search->above = 1;
+            search->load = high;
+            search->value = value;
+        }
+    }
+    if(!search->above && !met)
+    {
+        search->value = Probe(search, &pool->metric, low, queue, times);
+        search->probes++;
+        search->below = (search->value > threshold);
+        search->load = low;
+    }
+
+    // Halves the interval holding the highest sustainable utilization until it is narrower than the tolerance.
+    while(!search->above && !search->below && high - low > pool->tolerance)
+    {
+        middle = (low + high) / 2;
+        value = Probe(search, &pool->metric, middle, queue, times);
+        search->probes++;
+
+        if(value <= threshold)
+        {
+            low = middle;
+            search->load = middle;
+            search->value = value;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    free(queue);
+    free(times);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Analytic_Load()
+ * Arguments: search - The search of one scheduling algorithm on one mixture.
+ *            pool - The metric and range of the search.
+ * Description: Function to return the highest utilization in the range at which the analytic estimate
+ *              of the metric meets the threshold, found by bisection, or 0 if the algorithm and metric
+ *              have no estimate: only the mean response and turnaround time of FIFO and the mean
+ *              turnaround time of RR, taken as processor sharing, do.
+ * *************************************************************************************************/
+double Analytic_Load(const struct Search *search, const struct Search_Pool *pool)
+{
+    double low = pool->low, high = pool->high, middle;
+    double threshold = search->mixture->threshold;
+    int i;
+
+    if(Analytic_Value(search, &pool->metric, low) < 0) {
+        return 0;
+    }
+    if(Analytic_Value(search, &pool->metric, high) <= threshold) {
+        return high;
+    }
+    if(Analytic_Value(search, &pool->metric, low) > threshold) {
+        return low;
+    }
+
+    for(i = 0; i < 50; i++)
+    {
+        middle = (low + high) / 2;
+        if(Analytic_Value(search, &pool->metric, middle) <= threshold) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Analytic_Value()
+ * Arguments: search - The search of one scheduling algorithm on one mixture.
+ *            metric - The SLO metric.
+ *            utilization - The utilization to estimate the metric at.
+ * Description: Function to return the analytic estimate of the metric with the arrival rate scaled to
+ *              the utilization, which keeps the SCV of the time between arrivals. Returns a negative
+ *              number if the algorithm and metric have no estimate, and HUGE_VAL if the queue has no
+ *              steady state at this utilization: the fluid estimate of an overloaded run is close to
+ *              0 just above full utilization, which would place the guess there.
+ * *************************************************************************************************/
+double Analytic_Value(const struct Search *search, const struct Metric *metric, double utilization)
+{
+    struct Moments moments = search->mixture->moments;
+    struct Estimate estimate;
+
+    if(metric->quantile >= 0) {
+        return -1;
+    }
+
+    moments.rate = utilization / moments.mean_size;
+    Estimate_Queue(&moments, &estimate);
+    if(estimate.overloaded) {
+        return HUGE_VAL;
+    }
+
+    if(strcmp(policy_names[search->policy], "FIFO") == 0) {
+        return metric->turnaround ? estimate.fifo_turnaround : estimate.fifo_response;
+    }
+    if(strncmp(policy_names[search->policy], "RR", 2) == 0 && metric->turnaround) {
+        return estimate.ps_turnaround;
+    }
+    return -1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Probe()
+ * Arguments: search - The search of one scheduling algorithm on one mixture.
+ *            metric - The SLO metric.
+ *            utilization - The utilization to run the jobs at.
+ *            queue - An array of n jobs used to run the jobs.
+ *            times - An array of n times used to find a percentile.
+ * Description: Function to run the scheduling algorithm on the mixture with the times between the
+ *              arrivals scaled to give the utilization, and return the value of the metric.
+ * *************************************************************************************************/
+double Probe(const struct Search *search, const struct Metric *metric, double utilization, struct Job *queue,
+             float *times)
+{
+    const struct Mixture *mixture = search->mixture;
+    double scale = mixture->utilization / utilization;      // Factor applied to the time since the first arrival.
+    double first = mixture->jobs[0].arrival_time;
+    struct Summary summary;
+    int n = mixture->n;
+    int i, rank;
+
+    for(i = 0; i < n; i++)
+    {
+        queue[i].size = mixture->jobs[i].size;
+        queue[i].arrival_time = first + (mixture->jobs[i].arrival_time - first) * scale;
+    }
+    Run_Policy(search->policy, queue, n);
+
+    if(metric->quantile < 0)
+    {
+        Summarize(queue, n, &summary);
+        return metric->turnaround ? summary.avg_turnaround : summary.avg_response;
+    }
+
+    // Finds the percentile by the nearest rank of the sorted times.
+    for(i = 0; i < n; i++) {
+        times[i] = metric->turnaround ? queue[i].turnaround : queue[i].response_time;
+    }
+    qsort(times, n, sizeof(float), Compare_Floats);
+    rank = (int)(metric->quantile * n + 0.999999);
+    return times[(rank > 0 ? rank : 1) - 1];
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Compare_Floats()
+ * Arguments: a, b - The floats to compare.
+ * Description: Function to compare two floats for qsort().
+ * *************************************************************************************************/
+int Compare_Floats(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+
+    return (x > y) - (x < y);
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************************************************************
+ * Analytic Queueing Estimates
+ *
+ * Name: queueing.c
+ *
+ * Purpose: Works out the moments of a job runtime file and the analytic FIFO and processor sharing estimates described in
+ *          queueing.h.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include "queueing.h"
+
+#define CYCLE_POINTS 360        // Points of the daily cycle the pointwise stationary average is taken over.
+#define FLUID_STEPS 4096        // Least number of steps of the fluid model of an overloaded run.
+#define FLUID_STEPS_PER_CYCLE 64
+
+static double FIFO_Wait(double utilization, double arrival_scv, double size_scv, double mean_size);
+static double Fluid_Wait(const struct Moments *moments, double utilization);
+
+
+
+/***************************************************************************************************
+ * Function Name: Trace_Moments()
+ * Arguments: queue - An array of type structure Job, in the order the jobs arrive.
+ *            n - Number of jobs.
+ *            moments - Structure to return the moments in.
+ * Description: Function to work out the arrival rate, the SCV of the time between arrivals and the
+ *              first two moments of the job size of the jobs.
+ * *************************************************************************************************/
+
+void Trace_Moments(const struct Job *queue, int n, struct Moments *moments)
+{
+    double gap, gap_sum = 0, gap_m2 = 0, mean_gap;
+    int i;
+
+    moments->jobs = n;
+    moments->rate = 0;
+    moments->arrival_scv = 1;
+    moments->amplitude = 0;
+    moments->period = 0;
+    moments->mean_size = 0;
+    moments->size_m2 = 0;
+
+    for(i = 0; i < n; i++)
+    {
+        moments->mean_size += queue[i].size;
+        moments->size_m2 += (double)queue[i].size * queue[i].size;
+        if(i > 0)
+        {
+            gap = queue[i].arrival_time - queue[i - 1].arrival_time;
+            gap_sum += gap;
+            gap_m2 += gap * gap;
+        }
+    }
+    if(n > 0)
+    {
+        moments->mean_size /= n;
+        moments->size_m2 /= n;
+    }
+
+    if(n > 1 && gap_sum > 0)
+    {
+        mean_gap = gap_sum / (n - 1);
+        moments->rate = 1 / mean_gap;
+        moments->arrival_scv = (gap_m2 / (n - 1)) / (mean_gap * mean_gap) - 1;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Estimate_Queue()
+ * Arguments: moments - The moments of the jobs.
+ *            estimate - Structure to return the estimates in.
+ * Description: Function to estimate the average response and turnaround time of FIFO and the average
+ *              turnaround time of processor sharing from the moments of the jobs.
+ * *************************************************************************************************/
+
+void Estimate_Queue(const struct Moments *moments, struct Estimate *estimate)
+{
+    double mean = moments->mean_size;
+    double rho = moments->rate * mean;
+    double peak = rho * (1 + moments->amplitude);
+    double weight, total = 0, wait = 0, ps = 0, local;
+    int k;
+
+    estimate->utilization = rho;
+    estimate->size_scv = (mean > 0) ? moments->size_m2 / (mean * mean) - 1 : 0;
+    estimate->overloaded = (peak >= 1);
+    estimate->ps_turnaround = -1;
+
+    if(estimate->overloaded)
+    {
+        estimate->fifo_response = Fluid_Wait(moments, rho);
+        estimate->fifo_turnaround = estimate->fifo_response + mean;
+        return;
+    }
+
+    if(moments->amplitude > 0)
+    {
+        // Averages the formulas over the cycle, weighted by the rate at each point.
+        for(k = 0; k < CYCLE_POINTS; k++)
+        {
+            weight = 1 + moments->amplitude * sin(2 * M_PI * (k + 0.5) / CYCLE_POINTS);
+            local = rho * weight;
+            wait += weight * FIFO_Wait(local, moments->arrival_scv, estimate->size_scv, mean);
+            ps += weight * mean / (1 - local);
+            total += weight;
+        }
+        wait /= total;
+        ps /= total;
+    }
+    else
+    {
+        wait = FIFO_Wait(rho, moments->arrival_scv, estimate->size_scv, mean);
+        ps = mean / (1 - rho);
+    }
+
+    estimate->fifo_response = wait;
+    estimate->fifo_turnaround = wait + mean;
+    estimate->ps_turnaround = ps;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Print_Estimates()
+ * Arguments: fout - File to print to.
+ *            moments - The moments of the jobs.
+ * Description: Function to print the estimates for the moments as rows of the same form as the
+ *              simulated results, under a line describing the moments.
+ * *************************************************************************************************/
+
+void Print_Estimates(FILE *fout, const struct Moments *moments)
+{
+    struct Estimate estimate;
+
+    Estimate_Queue(moments, &estimate);
+
+    fprintf(fout, "Analytic estimate: utilization %.3f, arrival SCV %.3f, size SCV %.3f, %s\n", estimate.utilization,
+            moments->arrival_scv, estimate.size_scv,
+            (estimate.utilization >= 1) ? "overloaded (fluid model of the run)" :
+            estimate.overloaded ? "overloaded at the peak (fluid model of the run, without random waits)" :
+            (moments->amplitude > 0) ? "pointwise stationary over the cycle" : "steady state");
+    fprintf(fout, "%-10s %14.2f %16.2f\n", "FIFO", estimate.fifo_response, estimate.fifo_turnaround);
+    if(estimate.ps_turnaround >= 0) {
+        fprintf(fout, "%-10s %14s %16.2f\n", "PS (RR)", "-", estimate.ps_turnaround);
+    }
+    else {
+        fprintf(fout, "%-10s %14s %16s\n", "PS (RR)", "-", "-");
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: FIFO_Wait()
+ * Arguments: utilization - rho, below 1.
+ *            arrival_scv, size_scv - Ca^2 and Cs^2.
+ *            mean_size - E[S].
+ * Description: Function to return the Allen-Cunneen mean wait of a single-server FIFO queue, which is
+ *              the Pollaczek-Khinchine mean wait for Poisson arrivals.
+ * *************************************************************************************************/
+
+static double FIFO_Wait(double utilization, double arrival_scv, double size_scv, double mean_size)
+{
+    return (arrival_scv + size_scv) / 2 * utilization / (1 - utilization) * mean_size;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Fluid_Wait()
+ * Arguments: moments - The moments of the jobs.
+ *            utilization - rho at the mean rate.
+ * Description: Function to return the average wait of the jobs in the fluid model of a run: over the
+ *              jobs / rate ticks the jobs arrive in, the backlog of work grows by rho(t) - 1 per tick,
+ *              not falling below 0, and the average is of the backlog weighted by the rate of arrivals.
+ * *************************************************************************************************/
+
+static double Fluid_Wait(const struct Moments *moments, double utilization)
+{
+    double horizon = (moments->rate > 0) ? moments->jobs / moments->rate : 0;
+    double steps = FLUID_STEPS, step, weight, backlog = 0, wait = 0, total = 0;
+    long k;
+
+    if(horizon <= 0) {
+        return 0;
+    }
+
+    // Takes enough steps to follow the daily cycle.
+    if(moments->amplitude > 0 && moments->period > 0 && horizon / moments->period * FLUID_STEPS_PER_CYCLE > steps) {
+        steps = ceil(horizon / moments->period * FLUID_STEPS_PER_CYCLE);
+    }
+    step = horizon / steps;
+
+    for(k = 0; k < (long)steps; k++)
+    {
+        weight = 1;
+        if(moments->amplitude > 0 && moments->period > 0) {
+            weight += moments->amplitude * sin(2 * M_PI * (k + 0.5) * step / moments->period);
+        }
+
+        backlog += (utilization * weight - 1) * step;
+        if(backlog < 0) {
+            backlog = 0;
+        }
+        wait += weight * backlog;
+        total += weight;
+    }
+    return wait / total;
+}
@@ -0,0 +1,64 @@
+/*******************************************************************************************************************************
+ * Analytic Queueing Estimates
+ *
+ * Name: queueing.h
+ *
+ * Purpose: Estimates the average response and turnaround time of FIFO, and the average turnaround time of processor sharing
+ *          (PS) as a stand-in for RR with a small time slice, from a few moments of the jobs instead of a simulation: the
+ *          arrival rate, the squared coefficient of variation (SCV) of the time between arrivals, and the mean and second
+ *          moment of the job size. The moments come from a job runtime file (Trace_Moments()) or straight from a workload
+ *          (Workload_Moments() in workload.h), so a configuration can be judged in microseconds before it is simulated.
+ *          With utilization rho = rate * E[S] below 1, FIFO waits on average
+ *              Wq = (Ca^2 + Cs^2) / 2 * rho / (1 - rho) * E[S]                 (Allen-Cunneen)
+ *          which for Poisson arrivals (Ca^2 = 1) is the Pollaczek-Khinchine formula rate * E[S^2] / (2 (1 - rho)), and a
+ *          job's response is its wait and its turnaround its wait plus its size. Under PS the mean turnaround is
+ *          E[S] / (1 - rho), whatever the job size distribution. An MMPP enters through the asymptotic index of
+ *          dispersion of its counts in place of Ca^2, and a daily cycle through a pointwise stationary average: the
+ *          formulas at the rate of each moment of the cycle, weighted by that rate.
+ *          At or above full utilization, at the mean rate or at the peak of the cycle, no steady state exists and the
+ *          queue grows for as long as the load stays that high. FIFO is then estimated by the fluid model of a finite run
+ *          of n jobs, over the n / rate ticks they arrive in: the backlog of work grows by rho(t) - 1 per tick (and never
+ *          falls below 0), and each job waits for the backlog it finds. At a fixed rate this is an average wait of about
+ *          n / 2 * (E[S] - 1 / rate). The PS estimate is not given.
+ *          The estimates are for the model, not for the tick-by-tick simulator, which rounds each job up to whole ticks
+ *          and charges the overhead model; they are meant to rank configurations and to cross-check simulations.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile queueing.c together with the program and the scheduler engine, and include the -lm option.
+ *
+*******************************************************************************************************************************/
+#ifndef QUEUEING_H
+#define QUEUEING_H
+
+#include <stdio.h>
+#include "sched_engine.h"
+
+// Structure contains the moments of the jobs of a run.
+struct Moments
+{
+    int jobs;               // Number of jobs, for the fluid estimate of an overloaded run.
+    double rate;            // Mean number of arrivals per tick.
+    double arrival_scv;     // Squared coefficient of variation of the time between arrivals (Ca^2).
+    double amplitude;       // Relative change of the rate over a daily cycle, or 0.
+    double period;          // Length of the daily cycle.
+    double mean_size;       // E[S].
+    double size_m2;         // E[S^2].
+};
+
+// Structure contains the analytic estimates for one set of moments.
+struct Estimate
+{
+    double utilization;     // rho = rate * E[S].
+    double size_scv;        // Cs^2.
+    int overloaded;         // 1 if the queue has no steady state, at the mean rate or at the peak of the cycle, else 0.
+    double fifo_response;
+    double fifo_turnaround;
+    double ps_turnaround;   // Negative if not given.
+};
+
+void Trace_Moments(const struct Job *queue, int n, struct Moments *moments);
+void Estimate_Queue(const struct Moments *moments, struct Estimate *estimate);
+void Print_Estimates(FILE *fout, const struct Moments *moments);
+
+#endif
@@ -0,0 +1,420 @@
+/*******************************************************************************************************************************
+ * Results File
+ *
+ * Name: results.c
+ *
+ * Purpose: Writes and maps the binary results files declared in results.h. The writer streams each column to the file as
+ *          soon as an algorithm has run, so only the index is held in memory until the file is closed. Nothing here runs
+ *          a scheduling algorithm, so a reader such as the query tool is compiled with results.c alone.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "results.h"
+
+#define RESULTS_BUFFER 4096     // Number of values written at a time.
+
+// Names of the columns, as given to the query tool.
+const char *result_names[RESULT_COLUMNS + 2] = {"start", "time_left", "status", "switches", "end", "response",
+                                                "turnaround", "overhead", "arrival", "size"};
+
+static void Write_Column(struct Results_Writer *writer, const struct Job *queue, int column);
+static void Write_Block(struct Results_Writer *writer, const void *data, size_t length);
+static void Invalid_File(const char *path);
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Create()
+ * Arguments: writer - Structure used to keep track of the file being written.
+ *            path - Name of the results file.
+ *            queue - An array of type structure Job containing the jobs' arrival times and sizes.
+ *            n - Number of jobs in the array.
+ * Description: Function to create a results file and write its header and the arrival time and size
+ *              columns. The columns of each scheduling algorithm are added with Results_Add().
+ * *************************************************************************************************/
+
+void Results_Create(struct Results_Writer *writer, const char *path, const struct Job *queue, int n)
+{
+    struct Results_Header header;
+
+    writer->fout = fopen(path, "wb");
+
+    // Prints an error message and exits the program if the output file cannot be opened.
+    if(!writer->fout)
+    {
+        perror("Error! Cannot open output file!");
+        exit(-1);
+    }
+    writer->jobs = n;
+    writer->policies = 0;
+    writer->index = NULL;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = RESULTS_MAGIC;
+    header.version = RESULTS_VERSION;
+    header.jobs = n;
+    header.arrival = sizeof(header);
+    header.size = header.arrival + (uint64_t)n * sizeof(float);
+
+    Write_Block(writer, &header, sizeof(header));
+    Write_Column(writer, queue, RESULT_ARRIVAL);
+    Write_Column(writer, queue, RESULT_SIZE);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Add()
+ * Arguments: writer - Structure used to keep track of the file being written.
+ *            name - Name of the scheduling algorithm.
+ *            queue - An array of type structure Job containing the jobs completed by the algorithm.
+ *            summary - The totals and averages to store in the index, as worked out by the caller with
+ *                      Summarize() or from the steady state detection.
+ * Description: Function to append the columns of one scheduling algorithm to the results file and add
+ *              it to the index, with its totals and averages.
+ * *************************************************************************************************/
+
+void Results_Add(struct Results_Writer *writer, const char *name, const struct Job *queue, const struct Summary *summary)
+{
+    struct Results_Entry *entry;
+    uint64_t offset;
+    int column;
+
+    writer->index = realloc(writer->index, (writer->policies + 1) * sizeof(struct Results_Entry));
+
+    // Prints an error message and exits the program if the memory cannot be allocated.
+    if(!writer->index)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    entry = &writer->index[writer->policies];
+    memset(entry, 0, sizeof(*entry));
+    strncpy(entry->name, name, RESULTS_NAME - 1);
+    entry->summary = *summary;
+
+    // The columns follow the header, the two job columns and the columns of the algorithms before.
+    offset = sizeof(struct Results_Header) + (2 + (uint64_t)writer->policies * RESULT_COLUMNS) * writer->jobs * 4;
+    for(column = 0; column < RESULT_COLUMNS; column++)
+    {
+        entry->column[column] = offset + (uint64_t)column * writer->jobs * 4;
+        Write_Column(writer, queue, column);
+    }
+    writer->policies++;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Close()
+ * Arguments: writer - Structure used to keep track of the file being written.
+ * Description: Function to write the index and footer and close the results file. The index starts
+ *              at a multiple of 8 bytes, after 4 bytes of padding if there is an odd number of jobs, so
+ *              its 64-bit fields are aligned when the file is mapped.
+ * *************************************************************************************************/
+
+void Results_Close(struct Results_Writer *writer)
+{
+    struct Results_Footer footer;
+    uint64_t columns_end = sizeof(struct Results_Header) + (2 + (uint64_t)writer->policies * RESULT_COLUMNS) * writer->jobs * 4;
+    static const unsigned char padding[8];
+
+    memset(&footer, 0, sizeof(footer));
+    footer.index = (columns_end + 7) / 8 * 8;
+    footer.policies = writer->policies;
+    footer.jobs = writer->jobs;
+    footer.magic = RESULTS_MAGIC;
+
+    Write_Block(writer, padding, footer.index - columns_end);
+    Write_Block(writer, writer->index, writer->policies * sizeof(struct Results_Entry));
+    Write_Block(writer, &footer, sizeof(footer));
+
+    // Prints an error message and exits the program if the file could not be written in full.
+    if(fclose(writer->fout) != 0)
+    {
+        perror("Error! Cannot write output file!");
+        exit(-1);
+    }
+    free(writer->index);
+    writer->index = NULL;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Map()
+ * Arguments: results - Structure used to return the mapped file.
+ *            path - Name of the results file.
+ * Description: Function to map a results file into memory for reading and check its layout. Only the
+ *              header, index and footer are read; the columns are read by the system as they are used.
+ *              The program exits with an error message if the file cannot be mapped or is not a valid
+ *              results file.
+ * *************************************************************************************************/
+
+void Results_Map(struct Results *results, const char *path)
+{
+    const struct Results_Header *header;
+    const struct Results_Footer *footer;
+    struct stat info;
+    uint64_t columns_end;
+    uint32_t p;
+    int column;
+    int fd = open(path, O_RDONLY);
+
+    // Prints an error message and exits the program if the input file cannot be opened.
+    if(fd < 0 || fstat(fd, &info) != 0)
+    {
+        perror("Error! Cannot open input file!");
+        exit(-1);
+    }
+    if((size_t)info.st_size < sizeof(struct Results_Header) + sizeof(struct Results_Footer)) {
+        Invalid_File(path);
+    }
+
+    results->length = info.st_size;
+    results->map = mmap(NULL, results->length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(results->map == MAP_FAILED)
+    {
+        perror("Error! Cannot map input file!");
+        exit(-1);
+    }
+
+    header = (const struct Results_Header *)results->map;
+    footer = (const struct Results_Footer *)(results->map + results->length - sizeof(struct Results_Footer));
+
+    // Checks that the header and footer agree and that the index ends where the footer starts.
+    if(header->magic != RESULTS_MAGIC || footer->magic != RESULTS_MAGIC || header->version != RESULTS_VERSION ||
+       header->jobs != footer->jobs ||
+       footer->index + (uint64_t)footer->policies * sizeof(struct Results_Entry) + sizeof(struct Results_Footer) !=
+       results->length) {
+        Invalid_File(path);
+    }
+
+    results->jobs = footer->jobs;
+    results->policies = footer->policies;
+    results->index = (const struct Results_Entry *)(results->map + footer->index);
+    results->arrival = (const float *)(results->map + header->arrival);
+    results->size = (const float *)(results->map + header->size);
+
+    // Checks that every column lies before the index.
+    if(footer->index < sizeof(struct Results_Header) + (uint64_t)results->jobs * 4) {
+        Invalid_File(path);
+    }
+    columns_end = footer->index - (uint64_t)results->jobs * 4;
+    if(header->arrival > columns_end || header->size > columns_end) {
+        Invalid_File(path);
+    }
+    for(p = 0; p < results->policies; p++)
+    {
+        for(column = 0; column < RESULT_COLUMNS; column++)
+        {
+            if(results->index[p].column[column] > columns_end || results->index[p].column[column] % 4 != 0) {
+                Invalid_File(path);
+            }
+        }
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Unmap()
+ * Arguments: results - The mapped results file.
+ * Description: Function to unmap a results file mapped by Results_Map().
+ * *************************************************************************************************/
+
+void Results_Unmap(struct Results *results)
+{
+    munmap((void *)results->map, results->length);
+    results->map = NULL;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Policy()
+ * Arguments: results - The mapped results file.
+ *            name - Name of a scheduling algorithm, as in policy_names[], or its number in the file.
+ * Description: Function to find a scheduling algorithm in the index. Returns its number, or -1 if it
+ *              is not in the file.
+ * *************************************************************************************************/
+
+int Results_Policy(const struct Results *results, const char *name)
+{
+    char *end;
+    long number = strtol(name, &end, 10);
+    uint32_t p;
+
+    if(*name && !*end) {
+        return (number >= 0 && number < results->policies) ? (int)number : -1;
+    }
+    for(p = 0; p < results->policies; p++)
+    {
+        if(strcmp(results->index[p].name, name) == 0) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Column()
+ * Arguments: name - Name of a column, as in result_names[].
+ * Description: Function to find a column by its name. Returns its number, or -1 if there is none.
+ * *************************************************************************************************/
+
+int Results_Column(const char *name)
+{
+    int column;
+
+    for(column = 0; column < RESULT_COLUMNS + 2; column++)
+    {
+        if(strcmp(result_names[column], name) == 0) {
+            return column;
+        }
+    }
+    return -1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Value()
+ * Arguments: results - The mapped results file.
+ *            policy - Number of the scheduling algorithm.
+ *            column - Number of the column, which may be RESULT_ARRIVAL or RESULT_SIZE.
+ *            job - Job number.
+ * Description: Function to return one job's value in a column.
+ * *************************************************************************************************/
+
+double Results_Value(const struct Results *results, int policy, int column, uint32_t job)
+{
+    switch(column)
+    {
+        case RESULT_ARRIVAL: return results->arrival[job];
+        case RESULT_SIZE: return results->size[job];
+        case RESULT_STATUS:
+        case RESULT_SWITCHES: return Results_Ints(results, policy, column)[job];
+        default: return Results_Floats(results, policy, column)[job];
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Results_Record()
+ * Arguments: results - The mapped results file.
+ *            policy - Number of the scheduling algorithm.
+ *            job - Job number.
+ *            record - Structure used to return the job's details.
+ * Description: Function to gather one job's details under a scheduling algorithm from its columns.
+ * *************************************************************************************************/
+
+void Results_Record(const struct Results *results, int policy, uint32_t job, struct Job *record)
+{
+    memset(record, 0, sizeof(*record));
+    record->job_no = job;
+    record->arrival_time = results->arrival[job];
+    record->size = results->size[job];
+    record->start_time = Results_Floats(results, policy, RESULT_START)[job];
+    record->time_left = Results_Floats(results, policy, RESULT_TIME_LEFT)[job];
+    record->status = Results_Ints(results, policy, RESULT_STATUS)[job];
+    record->context_switch = Results_Ints(results, policy, RESULT_SWITCHES)[job];
+    record->end_time = Results_Floats(results, policy, RESULT_END)[job];
+    record->response_time = Results_Floats(results, policy, RESULT_RESPONSE)[job];
+    record->turnaround = Results_Floats(results, policy, RESULT_TURNAROUND)[job];
+    record->overhead = Results_Floats(results, policy, RESULT_OVERHEAD)[job];
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Write_Column()
+ * Arguments: writer - Structure used to keep track of the file being written.
+ *            queue - An array of type structure Job.
+ *            column - Number of the column to write.
+ * Description: Function to write one column of the jobs, RESULTS_BUFFER values at a time.
+ * *************************************************************************************************/
+
+static void Write_Column(struct Results_Writer *writer, const struct Job *queue, int column)
+{
+    union
+    {
+        float f;
+        int32_t i;
+    } buffer[RESULTS_BUFFER];
+    uint32_t first, i, count;
+
+    for(first = 0; first < writer->jobs; first += count)
+    {
+        count = (writer->jobs - first < RESULTS_BUFFER) ? writer->jobs - first : RESULTS_BUFFER;
+
+        for(i = 0; i < count; i++)
+        {
+            const struct Job *job = &queue[first + i];
+
+            switch(column)
+            {
+                case RESULT_START: buffer[i].f = job->start_time; break;
+                case RESULT_TIME_LEFT: buffer[i].f = job->time_left; break;
+                case RESULT_STATUS: buffer[i].i = job->status; break;
+                case RESULT_SWITCHES: buffer[i].i = job->context_switch; break;
+                case RESULT_END: buffer[i].f = job->end_time; break;
+                case RESULT_RESPONSE: buffer[i].f = job->response_time; break;
+                case RESULT_TURNAROUND: buffer[i].f = job->turnaround; break;
+                case RESULT_OVERHEAD: buffer[i].f = job->overhead; break;
+                case RESULT_ARRIVAL: buffer[i].f = job->arrival_time; break;
+                case RESULT_SIZE: buffer[i].f = job->size; break;
+            }
+        }
+        Write_Block(writer, buffer, count * sizeof(buffer[0]));
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Write_Block()
+ * Arguments: writer - Structure used to keep track of the file being written.
+ *            data - Bytes to write.
+ *            length - Number of bytes.
+ * Description: Function to write bytes to the results file. The program exits with an error message
+ *              if they cannot be written.
+ * *************************************************************************************************/
+
+static void Write_Block(struct Results_Writer *writer, const void *data, size_t length)
+{
+    if(length > 0 && fwrite(data, 1, length, writer->fout) != length)
+    {
+        perror("Error! Cannot write output file!");
+        exit(-1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Invalid_File()
+ * Arguments: path - Name of the file.
+ * Description: Function to print an error message and exit the program when a file is not a valid
+ *              results file.
+ * *************************************************************************************************/
+
+static void Invalid_File(const char *path)
+{
+    fprintf(stderr, "Error! %s is not a valid results file.\n", path);
+    exit(-1);
+}
@@ -0,0 +1,127 @@
+/*******************************************************************************************************************************
+ * Results File
+ *
+ * Name: results.h
+ *
+ * Purpose: A binary file of the per-job results of the scheduling algorithms, which can be read without loading it. Each
+ *          result is a column of one fixed-width 4-byte value per job, in job number order: the arrival time and size of
+ *          the jobs first, followed by the RESULT_COLUMNS columns of each algorithm in turn. The file ends with an index
+ *          holding the name, totals and column offsets of each algorithm, and a fixed-size footer giving the position of
+ *          the index. A reader maps the file into memory with Results_Map() and finds any column from the index, and any
+ *          job's value in it from its job number, without reading the rest of the file; scanning a column only reads that
+ *          column's pages.
+ *          The layout is:
+ *              struct Results_Header
+ *              arrival time and size columns (float)
+ *              RESULT_COLUMNS columns for each algorithm (float, or int for the status and context switches)
+ *              4 bytes of padding if the number of jobs is odd, so the index starts at a multiple of 8 bytes
+ *              one struct Results_Entry for each algorithm (the index)
+ *              struct Results_Footer
+ *          Values are stored in the byte order of the machine that wrote the file, which is checked with the magic number.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile results.c together with the program. The totals of each algorithm are worked out by the caller, so a
+ * 	program that only reads results files needs no other file of the scheduler.
+ *
+*******************************************************************************************************************************/
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "sched_engine.h"
+
+#define RESULTS_MAGIC 0x53455253484353ULL  // "SCHSRES" in the low bytes, which also detects the byte order.
+#define RESULTS_VERSION 1
+#define RESULTS_NAME 16                     // Longest algorithm name, including the terminating null.
+
+// Columns of each scheduling algorithm.
+#define RESULT_START 0
+#define RESULT_TIME_LEFT 1
+#define RESULT_STATUS 2             // int
+#define RESULT_SWITCHES 3           // int
+#define RESULT_END 4
+#define RESULT_RESPONSE 5
+#define RESULT_TURNAROUND 6
+#define RESULT_OVERHEAD 7
+#define RESULT_COLUMNS 8
+
+// Columns shared by every algorithm, numbered after the algorithm's columns.
+#define RESULT_ARRIVAL RESULT_COLUMNS
+#define RESULT_SIZE (RESULT_COLUMNS + 1)
+
+extern const char *result_names[RESULT_COLUMNS + 2];
+
+// Structure contains the start of a results file.
+struct Results_Header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t jobs;              // Number of jobs, the length of every column.
+    uint64_t arrival;           // Offset of the arrival time column.
+    uint64_t size;              // Offset of the size column.
+};
+
+// Structure contains the index entry of one scheduling algorithm.
+struct Results_Entry
+{
+    char name[RESULTS_NAME];
+    struct Summary summary;
+    uint32_t pad;
+    uint64_t column[RESULT_COLUMNS];    // Offset of each column.
+};
+
+// Structure contains the end of a results file.
+struct Results_Footer
+{
+    uint64_t index;             // Offset of the index.
+    uint32_t policies;          // Number of algorithms in the index.
+    uint32_t jobs;
+    uint64_t magic;
+};
+
+// Structure contains a results file being written.
+struct Results_Writer
+{
+    FILE *fout;
+    uint32_t jobs;
+    uint32_t policies;          // Number of algorithms written so far.
+    struct Results_Entry *index;
+};
+
+// Structure contains a results file mapped into memory.
+struct Results
+{
+    const unsigned char *map;
+    size_t length;
+    uint32_t jobs;
+    uint32_t policies;
+    const struct Results_Entry *index;
+    const float *arrival;
+    const float *size;
+};
+
+void Results_Create(struct Results_Writer *writer, const char *path, const struct Job *queue, int n);
+void Results_Add(struct Results_Writer *writer, const char *name, const struct Job *queue, const struct Summary *summary);
+void Results_Close(struct Results_Writer *writer);
+void Results_Map(struct Results *results, const char *path);
+void Results_Unmap(struct Results *results);
+int Results_Policy(const struct Results *results, const char *name);
+int Results_Column(const char *name);
+double Results_Value(const struct Results *results, int policy, int column, uint32_t job);
+void Results_Record(const struct Results *results, int policy, uint32_t job, struct Job *record);
+
+// Returns the column of one scheduling algorithm as floats. Only valid for columns that are not int.
+static inline const float *Results_Floats(const struct Results *results, int policy, int column)
+{
+    return (const float *)(results->map + results->index[policy].column[column]);
+}
+
+// Returns the column of one scheduling algorithm as ints. Only valid for RESULT_STATUS and RESULT_SWITCHES.
+static inline const int32_t *Results_Ints(const struct Results *results, int policy, int column)
+{
+    return (const int32_t *)(results->map + results->index[policy].column[column]);
+}
+
+#endif
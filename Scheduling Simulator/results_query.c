@@ -0,0 +1,307 @@
+/*******************************************************************************************************************************
+ * Results Query
+ *
+ * Name: results_query.c
+ *
+ * Purpose: Looks up jobs in a binary results file written by the scheduler or the job generator with -b (see results.h)
+ *          without loading the file. The file is mapped into memory, so a job's record is read from its row of each column
+ *          and a filter only reads the columns it tests.
+ *          With only the file, the totals and averages of each scheduling algorithm are printed from the index.
+ *          With an algorithm and a job number, the job's details under that algorithm are printed, or under every
+ *          algorithm if the algorithm is "all".
+ *          With an algorithm and one or more conditions, every job meeting all of them is printed, one per line, with its
+ *          arrival time, size and the columns tested. A condition is a column name, one of <, <=, =, !=, >= and >, and a
+ *          number, given as one argument (quoted, as the shell would take < and > as redirections).
+ *          The columns are start, time_left, status, switches, end, response, turnaround, overhead, arrival and size.
+ *
+ * Usage: ./results_query [-c] <results_file> [algorithm [job_no | condition ...]]
+ *  -c - Only print the number of jobs meeting the conditions.
+ *  algorithm - Name of the scheduling algorithm, such as "RR(75)", or its number in the file.
+ *  (./results_query scheduling_1.res)
+ *  (./results_query scheduling_1.res "RR(75)" 3456)
+ *  (./results_query -c scheduling_1.res SJF "turnaround>5000" "size<100")
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile results.c together with the program.
+ * 	(gcc -O2 -o results_query results_query.c results.c)
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "results.h"
+
+#define MAX_CONDITIONS 16       // Largest number of conditions of a filter.
+
+// Comparison operators of a condition.
+#define OP_LESS 0
+#define OP_LESS_EQUAL 1
+#define OP_EQUAL 2
+#define OP_NOT_EQUAL 3
+#define OP_GREATER_EQUAL 4
+#define OP_GREATER 5
+
+// Structure contains one condition of a filter.
+struct Condition
+{
+    int column;
+    int op;
+    double value;
+};
+
+void Print_Index(const struct Results *results);
+void Print_Record(const struct Results *results, int policy, uint32_t job);
+void Parse_Condition(const char *arg, struct Condition *condition);
+int Test(double x, const struct Condition *condition);
+void Filter(const struct Results *results, int policy, const struct Condition *conditions, int count, int count_only);
+
+
+int main(int argc, char *argv[])
+{
+    struct Results results;
+    struct Condition conditions[MAX_CONDITIONS];
+    int count_only = 0;     // 1 if only the number of matching jobs is printed, else 0.
+    int policy = -1;
+    int i;
+    char *end;
+    long job;
+
+    // Reads the option and skips over it.
+    if(argc > 1 && strcmp(argv[1], "-c") == 0)
+    {
+        count_only = 1;
+        argv[1] = argv[0];
+        argc--;
+        argv++;
+    }
+
+    if(argc < 2 || argc - 3 > MAX_CONDITIONS)
+    {
+        fprintf(stderr, "Usage: %s [-c] <results_file> [algorithm [job_no | condition ...]]\n", argv[0]);
+        exit(-1);
+    }
+
+    Results_Map(&results, argv[1]);
+
+    if(argc == 2)
+    {
+        Print_Index(&results);
+        Results_Unmap(&results);
+        exit(0);
+    }
+
+    // Prints an error message and exits the program if the algorithm is not in the file.
+    if(strcmp(argv[2], "all") != 0 && (policy = Results_Policy(&results, argv[2])) < 0)
+    {
+        fprintf(stderr, "Error! %s is not in %s.\n", argv[2], argv[1]);
+        exit(-1);
+    }
+
+    // A job number looks up one job's record.
+    job = (argc == 4) ? strtol(argv[3], &end, 10) : 0;
+    if(argc == 4 && *argv[3] && !*end)
+    {
+        if(job < 0 || job >= results.jobs)
+        {
+            fprintf(stderr, "Error! The job number must be from 0 to %u.\n", results.jobs - 1);
+            exit(-1);
+        }
+        printf("%-10s %12s %10s %12s %10s %6s %8s %12s %12s %12s %10s\n", "Algorithm", "Arrival", "Size", "Start",
+               "Time Left", "Status", "Switches", "End", "Response", "Turnaround", "Overhead");
+        for(i = 0; i < (int)results.policies; i++)
+        {
+            if(policy < 0 || policy == i) {
+                Print_Record(&results, i, job);
+            }
+        }
+    }
+
+    // Conditions filter the jobs of one algorithm.
+    else
+    {
+        if(policy < 0 || argc == 3)
+        {
+            fprintf(stderr, "Error! A filter needs one algorithm and at least one condition.\n");
+            exit(-1);
+        }
+        for(i = 3; i < argc; i++) {
+            Parse_Condition(argv[i], &conditions[i - 3]);
+        }
+        Filter(&results, policy, conditions, argc - 3, count_only);
+    }
+
+    Results_Unmap(&results);
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Print_Index()
+ * Arguments: results - The mapped results file.
+ * Description: Function to print the number of jobs and the totals and averages of each scheduling
+ *              algorithm, read from the index alone.
+ * *************************************************************************************************/
+void Print_Index(const struct Results *results)
+{
+    uint32_t p;
+
+    printf("%u jobs, %u algorithms\n", results->jobs, results->policies);
+    printf("%-10s %14s %16s %18s %10s\n", "Algorithm", "Avg Response", "Avg Turnaround", "Context Switches", "Overhead");
+    for(p = 0; p < results->policies; p++)
+    {
+        const struct Summary *summary = &results->index[p].summary;
+
+        printf("%-10s %14.2f %16.2f %18d %9.2f%%\n", results->index[p].name, summary->avg_response,
+               summary->avg_turnaround, summary->total_context_switches,
+               (summary->cpu_time > 0) ? 100 * summary->overhead / summary->cpu_time : 0);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Print_Record()
+ * Arguments: results - The mapped results file.
+ *            policy - Number of the scheduling algorithm.
+ *            job - Job number.
+ * Description: Function to print one job's details under a scheduling algorithm.
+ * *************************************************************************************************/
+void Print_Record(const struct Results *results, int policy, uint32_t job)
+{
+    struct Job record;
+
+    Results_Record(results, policy, job, &record);
+    printf("%-10s %12.2f %10.2f %12.2f %10.2f %6d %8d %12.2f %12.2f %12.2f %10.2f\n", results->index[policy].name,
+           record.arrival_time, record.size, record.start_time, record.time_left, record.status, record.context_switch,
+           record.end_time, record.response_time, record.turnaround, record.overhead);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Parse_Condition()
+ * Arguments: arg - The condition, such as "turnaround>5000".
+ *            condition - Structure used to return the condition.
+ * Description: Function to read a condition from a command-line argument. The program exits with an
+ *              error message if it cannot be read.
+ * *************************************************************************************************/
+void Parse_Condition(const char *arg, struct Condition *condition)
+{
+    static const char *ops[] = {"<=", ">=", "!=", "<", "=", ">"};
+    static const int codes[] = {OP_LESS_EQUAL, OP_GREATER_EQUAL, OP_NOT_EQUAL, OP_LESS, OP_EQUAL, OP_GREATER};
+    char name[32];
+    size_t length = strcspn(arg, "<>=!");
+    char *end;
+    int i;
+
+    if(length == 0 || length >= sizeof(name))
+    {
+        fprintf(stderr, "Error! %s is not a condition such as turnaround>5000.\n", arg);
+        exit(-1);
+    }
+    memcpy(name, arg, length);
+    name[length] = '\0';
+
+    if((condition->column = Results_Column(name)) < 0)
+    {
+        fprintf(stderr, "Error! There is no column %s.\n", name);
+        exit(-1);
+    }
+
+    for(i = 0; i < 6; i++)
+    {
+        if(strncmp(arg + length, ops[i], strlen(ops[i])) == 0)
+        {
+            condition->op = codes[i];
+            length += strlen(ops[i]);
+            break;
+        }
+    }
+
+    condition->value = strtod(arg + length, &end);
+    if(i == 6 || end == arg + length || *end)
+    {
+        fprintf(stderr, "Error! %s is not a condition such as turnaround>5000.\n", arg);
+        exit(-1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Test()
+ * Arguments: x - A job's value in the column of the condition.
+ *            condition - The condition.
+ * Description: Function to return 1 if the value meets the condition, else 0.
+ * *************************************************************************************************/
+int Test(double x, const struct Condition *condition)
+{
+    switch(condition->op)
+    {
+        case OP_LESS: return x < condition->value;
+        case OP_LESS_EQUAL: return x <= condition->value;
+        case OP_EQUAL: return x == condition->value;
+        case OP_NOT_EQUAL: return x != condition->value;
+        case OP_GREATER_EQUAL: return x >= condition->value;
+        default: return x > condition->value;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Filter()
+ * Arguments: results - The mapped results file.
+ *            policy - Number of the scheduling algorithm.
+ *            conditions - The conditions of the filter.
+ *            count - Number of conditions.
+ *            count_only - 1 if only the number of matching jobs is printed, else 0.
+ * Description: Function to print the jobs that meet every condition under the scheduling algorithm.
+ *              The column of the first condition is scanned, and the other columns are only read for
+ *              the jobs that meet it, so the first condition should be the most selective.
+ * *************************************************************************************************/
+void Filter(const struct Results *results, int policy, const struct Condition *conditions, int count, int count_only)
+{
+    long long matches = 0;
+    uint32_t job;
+    int i;
+
+    if(!count_only)
+    {
+        printf("%10s %12s %10s", "Job No", "Arrival", "Size");
+        for(i = 0; i < count; i++) {
+            printf(" %12s", result_names[conditions[i].column]);
+        }
+        printf("\n");
+    }
+
+    for(job = 0; job < results->jobs; job++)
+    {
+        if(!Test(Results_Value(results, policy, conditions[0].column, job), &conditions[0])) {
+            continue;
+        }
+        for(i = 1; i < count; i++)
+        {
+            if(!Test(Results_Value(results, policy, conditions[i].column, job), &conditions[i])) {
+                break;
+            }
+        }
+        if(i < count) {
+            continue;
+        }
+
+        matches++;
+        if(!count_only)
+        {
+            printf("%10u %12.2f %10.2f", job, results->arrival[job], results->size[job]);
+            for(i = 0; i < count; i++) {
+                printf(" %12.2f", Results_Value(results, policy, conditions[i].column, job));
+            }
+            printf("\n");
+        }
+    }
+
+    printf("%lld of %u jobs under %s\n", matches, results->jobs, results->index[policy].name);
+}
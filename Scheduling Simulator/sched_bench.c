@@ -0,0 +1,155 @@
+/*******************************************************************************************************************************
+ * Scheduler Benchmark
+ *
+ * Name: sched_bench.c
+ *
+ * Purpose: Times each scheduling algorithm of the scheduler engine on the jobs of a job runtime file, in the format: job
+ *          size, job arrival, once with the generic version of the algorithm, which reads the time slice and the overhead
+ *          model at run time, and once with the copy specialized for them (see KERNEL in sched_engine.c). Each is run a
+ *          number of times and the fastest run is kept, as the other runs only add noise from the rest of the machine.
+ *          The results of the two versions are checked to be the same, job by job, and the time of each and the speedup of
+ *          the specialized copy are printed for each algorithm.
+ *
+ * Usage: ./sched_bench [-r runs] <job_runtime_file> [switch_cost] [cache_penalty] [cache_warmup]
+ *  -r - Number of times each version is run. Default = 5.
+ *  switch_cost, cache_penalty, cache_warmup - The overhead model, as for the scheduler. Default = 0, no overhead.
+ *  (./sched_bench job_runtime_1.csv)
+ *  (./sched_bench -r 10 job_runtime_2.csv 2 0.5 10)
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile sched_engine.c, timer_wheel.c, snapshot.c and steady_state.c together with the program, with the -lm option.
+ * 	(gcc -O2 -o sched_bench sched_bench.c sched_engine.c timer_wheel.c snapshot.c steady_state.c -lm)
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sched_engine.h"
+
+double Time_Policy(int policy, const struct Job *jobs, struct Job *queue, int n, int runs);
+
+
+int main(int argc, char *argv[])
+{
+    struct Job *jobs;           // Jobs as read from the file.
+    struct Job *generic;        // Jobs run by the generic version.
+    struct Job *fast;           // Jobs run by the specialized copy.
+    struct Summary summary;
+    FILE *fin;
+    int runs = 5;               // Number of times each version is run.
+    int n = 0;
+    int policy;
+    double generic_time, fast_time;
+
+    // Reads the option and skips over it.
+    if(argc > 2 && strcmp(argv[1], "-r") == 0)
+    {
+        runs = atoi(argv[2]);
+        argv[2] = argv[0];
+        argc -= 2;
+        argv += 2;
+    }
+
+    if(argc < 2 || argc > 5 || runs < 1)
+    {
+        fprintf(stderr, "Usage: %s [-r runs] <job_runtime_file> [switch_cost] [cache_penalty] [cache_warmup]\n", argv[0]);
+        exit(-1);
+    }
+
+    switch_cost = (argc > 2) ? atoi(argv[2]) : 0;
+    cache_penalty = (argc > 3) ? atof(argv[3]) : 0;
+    cache_warmup = (argc > 4) ? atoi(argv[4]) : 0;
+
+    // Prints an error message and exits the program if the overhead model cannot be used.
+    if(switch_cost < 0 || cache_penalty < 0 || cache_penalty >= 1 || cache_warmup < 0)
+    {
+        fprintf(stderr, "Error! The switch cost and cache warmup must not be negative and the cache penalty must be in [0, 1).\n");
+        exit(-1);
+    }
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!(fin = fopen(argv[1], "r")))
+    {
+        perror("Error! Cannot open the job runtime file");
+        exit(-1);
+    }
+
+    n = Count_Jobs(fin);
+
+    jobs = malloc((n > 0 ? n : 1) * sizeof(struct Job));
+    generic = malloc((n > 0 ? n : 1) * sizeof(struct Job));
+    fast = malloc((n > 0 ? n : 1) * sizeof(struct Job));
+
+    // Prints an error message and exits the program if the memory cannot be allocated.
+    if(!(jobs && generic && fast))
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    n = Read_Jobs(fin, jobs, n);
+    fclose(fin);
+
+    printf("%d jobs, switch cost %d, cache penalty %.2f for %d ticks, fastest of %d runs\n", n, switch_cost, cache_penalty,
+           cache_warmup, runs);
+    printf("%-10s %14s %16s %10s %16s\n", "Algorithm", "Generic (ms)", "Specialized (ms)", "Speedup", "Avg Turnaround");
+
+    for(policy = 0; policy < NO_OF_POLICIES; policy++)
+    {
+        specialized = 0;
+        generic_time = Time_Policy(policy, jobs, generic, n, runs);
+        specialized = 1;
+        fast_time = Time_Policy(policy, jobs, fast, n, runs);
+
+        // Prints an error message and exits the program if the two versions do not give the same results.
+        if(memcmp(generic, fast, n * sizeof(struct Job)) != 0)
+        {
+            fprintf(stderr, "Error! The specialized %s gives different results.\n", policy_names[policy]);
+            exit(-1);
+        }
+
+        Summarize(fast, n, &summary);
+        printf("%-10s %14.3f %16.3f %9.2fx %16.2f\n", policy_names[policy], 1e3 * generic_time, 1e3 * fast_time,
+               generic_time / fast_time, summary.avg_turnaround);
+    }
+
+    free(jobs);
+    free(generic);
+    free(fast);
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Time_Policy()
+ * Arguments: policy - Number of the scheduling algorithm, an index into policy_names[].
+ *            jobs - The jobs to run.
+ *            queue - An array of type structure Job used to run the jobs and return the results.
+ *            n - Number of jobs.
+ *            runs - Number of times the algorithm is run.
+ * Description: Function to run a scheduling algorithm on the jobs a number of times and return the
+ *              time of the fastest run in seconds.
+ * *************************************************************************************************/
+double Time_Policy(int policy, const struct Job *jobs, struct Job *queue, int n, int runs)
+{
+    struct timespec start, end;
+    double best = 0, elapsed;
+    int i;
+
+    for(i = 0; i < runs; i++)
+    {
+        memcpy(queue, jobs, n * sizeof(struct Job));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        Run_Policy(policy, queue, n);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if(i == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
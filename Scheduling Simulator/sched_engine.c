@@ -0,0 +1,1206 @@
+/*******************************************************************************************************************************
+ * Scheduler Engine
+ * 
+ * Name: sched_engine.c
+ * 
+ * Purpose: Implements the scheduling algorithms declared in sched_engine.h, FIFO, SJF, STCF and RR, together with the 
+ *          context switch and cache refill overhead model. Each algorithm runs on an array of n jobs whose sizes and
+ *          arrival times have been filled in, in increasing order of arrival time.
+ *          The arrivals of the jobs and the end of each time slice are timers in a timing wheel (see timer_wheel.h), which
+ *          is advanced once per tick. While every job that has arrived is completed, the clock jumps straight to the next
+ *          timer instead of counting through the idle ticks.
+ *          If the global 'snapshots' is set, a snapshot of the metrics of the running algorithm is written every few ticks
+ *          of simulated time by a timer in the same wheel (see snapshot.h).
+ *          If the global 'steady' is set, every completed job is also passed to the steady state detection, and the
+ *          algorithm stops as soon as it reports that its averages are known to the requested precision (see
+ *          steady_state.h). The jobs not completed by then are given status 3, and the times they never reached are
+ *          set to NaN.
+ * 
+ * Subroutines/libraries required: 
+ * 	See include statements.
+ * 
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sched_engine.h"
+#include "timer_wheel.h"
+#include "snapshot.h"
+#include "steady_state.h"
+
+int switch_cost = 0;            // Ticks spent on each context switch. Global variable.
+float cache_penalty = 0;        // Fraction of progress lost per tick while a resumed job refills its cache. Global variable.
+int cache_warmup = 0;           // Number of ticks a resumed job runs at the reduced speed. Global variable.
+int specialized = 1;            // 0 runs the generic version of every scheduling algorithm. Global variable.
+struct Snapshots *snapshots = NULL;     // Stream of metrics snapshots written while the algorithms run, or NULL. Global variable.
+struct Steady_State *steady = NULL;     // Steady state detection that stops the algorithms early, or NULL. Global variable.
+
+// Names of the scheduling algorithms run by Run_Policy(), in the order of their numbers.
+const char *policy_names[NO_OF_POLICIES] = {"FIFO", "SJF", "STCF(30)", "RR(30)", "RR(75)"};
+
+// Structure contains the timers of a scheduling algorithm.
+struct Timers
+{
+    struct Job *queue;          // Jobs of the run.
+    int n;
+    struct Timer_Wheel wheel;
+    struct Timer *arrival;      // Arrival timer of each job, which sets the job's status to 1.
+    struct Timer quantum;       // End of the running job's time slice.
+    struct Timer snapshot;      // Next metrics snapshot, if snapshots are written.
+    int due;                    // Number of jobs whose arrival timers have fired.
+    int expired;                // Set to 1 when the time slice has ended.
+    int completed;              // Number of jobs completed, as of the last tick.
+    long long slices;           // Number of time slices that have ended.
+};
+
+static int *Ready_Array(int n);
+static int Shortest_Arrived(const struct Job *queue, const int *ready, int arrived);
+static void Start_Timers(struct Timers *timers, struct Job *queue, int n, const char *policy, int time_slice);
+static void Stop_Timers(struct Timers *timers);
+static void Fire(struct Timer *timer, void *context);
+static inline int Next_Tick(struct Timers *timers, int time_clock, int completed);
+static int Overhead_Model(void);
+
+// The scheduling algorithms are written once, as kernels that are always inlined into their callers, and each caller passes
+// them constant arguments where it can. The compiler then builds a separate copy of the algorithm for each set of constants,
+// with the branches that do not apply to it folded away: a copy for each common time slice length, and a copy without the
+// overhead model, in which a job never waits for a context switch or refills its cache and the overhead fields are never
+// touched. Run with other arguments, the algorithms fall back to the generic copy, which reads them at run time.
+#define KERNEL static inline __attribute__((always_inline))
+
+static void FIFO_Plain(struct Job *queue, int n);
+static void SJF_Plain(struct Job *queue, int n);
+static void STCF_Plain(struct Job *queue, int n, int pre_emption_size);
+static void STCF_Plain_30(struct Job *queue, int n);
+static void STCF_Plain_75(struct Job *queue, int n);
+static void STCF_30(struct Job *queue, int n);
+static void STCF_75(struct Job *queue, int n);
+static void RR_Plain(struct Job *queue, int n, int quantum_size);
+static void RR_Plain_30(struct Job *queue, int n);
+static void RR_Plain_75(struct Job *queue, int n);
+static void RR_30(struct Job *queue, int n);
+static void RR_75(struct Job *queue, int n);
+
+
+
+/***************************************************************************************************
+ * Function Name: Count_Jobs()
+ * Arguments: fin - File containing job arrival time and job size.
+ * Description: Function to return the number of jobs in the file, counted from the beginning of the
+ *              file up to the first line that is not a job.
+ * *************************************************************************************************/
+
+int Count_Jobs(FILE *fin)
+{
+    char line[128];
+    float size, arrival;
+    int n = 0;
+
+    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
+
+    while(fgets(line, sizeof(line), fin) && sscanf(line, "%f,%f", &size, &arrival) == 2) {
+        n++;
+    }
+    return n;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Read_Jobs()
+ * Arguments: fin - File containing job arrival time and job size.
+ *            queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs to be read.
+ * Description: Function to read the job runtime, arrival time and, if the line has it, the width of
+ *              n jobs from the beginning of the file. Returns the number of jobs read.
+ * *************************************************************************************************/
+
+int Read_Jobs(FILE *fin, struct Job *queue, int n)
+{
+    char line[128];
+    int current;
+
+    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
+
+    for(current = 0; current < n; current++)
+    {
+        if(!fgets(line, sizeof(line), fin) ||
+           sscanf(line, "%f,%f", &queue[current].size, &queue[current].arrival_time) != 2) {
+            break;
+        }
+        if(sscanf(line, "%*f,%*f,%d", &queue[current].width) != 1 || queue[current].width < 1) {
+            queue[current].width = 1;
+        }
+    }
+    return current;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Reset_Jobs()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ * Description: Function to set every job back to not arrived and not run, keeping its size and
+ *              arrival time, so the same array can be run by each scheduling algorithm in turn.
+ * *************************************************************************************************/
+
+void Reset_Jobs(struct Job *queue, int n)
+{
+    int current;
+
+    for(current = 0; current < n; current++)
+    {
+        queue[current].job_no = current;
+        queue[current].status = 0;
+        queue[current].context_switch = 0;
+        queue[current].time_left = queue[current].size;
+        queue[current].start_time = 0;
+        queue[current].end_time = 0;
+        queue[current].response_time = 0;
+        queue[current].turnaround = 0;
+        queue[current].overhead = 0;
+        queue[current].switch_left = 0;
+        queue[current].warm_left = 0;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Run_Policy()
+ * Arguments: policy - Number of the scheduling algorithm, an index into policy_names[].
+ *            queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ * Description: Function to run one of the five scheduling algorithms of the scheduler on the jobs. 
+ * *************************************************************************************************/
+
+void Run_Policy(int policy, struct Job *queue, int n)
+{
+    switch(policy)
+    {
+        case 0: FIFO(queue, n); break;
+        case 1: SJF(queue, n); break;
+        case 2: STCF(queue, n, 30); break;
+        case 3: RR(queue, n, 30); break;
+        case 4: RR(queue, n, 75); break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Summarize()
+ * Arguments: queue - An array of type structure Job containing the details of the completed jobs.
+ *            n - Number of jobs in the array.
+ *            summary - Structure used to return the totals and averages.
+ * Description: Function to compute the average response and turnaround time, the total number of
+ *              context switches, the overhead and the CPU time of a scheduling algorithm. The averages
+ *              are over the completed jobs only, and the CPU time counts only the work done, so a run
+ *              stopped early (see steady_state.h) is not averaged with the jobs it never completed.
+ * *************************************************************************************************/
+
+void Summarize(const struct Job *queue, int n, struct Summary *summary)
+{
+    int i;
+    int completed = 0;
+
+    summary->avg_response = 0;
+    summary->avg_turnaround = 0;
+    summary->total_context_switches = 0;
+    summary->overhead = 0;
+    summary->cpu_time = 0;
+
+    for(i = 0; i < n; i++)
+    {
+        summary->total_context_switches += queue[i].context_switch;
+        summary->overhead += queue[i].overhead;
+        if(queue[i].status != 2)
+        {
+            summary->cpu_time += queue[i].size - queue[i].time_left + queue[i].overhead;
+            continue;
+        }
+        summary->avg_response += queue[i].response_time;
+        summary->avg_turnaround += queue[i].turnaround;
+        summary->cpu_time += queue[i].size + queue[i].overhead;
+        completed++;
+    }
+
+    if(completed > 0)
+    {
+        summary->avg_response = summary->avg_response / completed;
+        summary->avg_turnaround = summary->avg_turnaround / completed;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Ready_Array()
+ * Arguments: n - Number of jobs.
+ * Description: Function to allocate the 'ready' array of a scheduling algorithm, with every element
+ *              set to -1. The array is freed by the caller.
+ * *************************************************************************************************/
+
+static int *Ready_Array(int n)
+{
+    int *ready = malloc((n > 0 ? n : 1) * sizeof(int));
+    int i;
+
+    // Prints an error message and exits the program if the memory cannot be allocated.
+    if(!ready)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    for(i = 0; i < n; i++) {
+        ready[i] = -1;
+    }
+    return ready;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Shortest_Arrived()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            ready - The 'ready' array of STCF, holding the job numbers of the arrived jobs.
+ *            arrived - Number of jobs that have arrived.
+ * Description: Function to return the index in 'ready' of the arrived job with the least time left
+ *              that has not been completed, the first of them on a tie. Returns 'arrived' if every
+ *              arrived job has been completed.
+ * *************************************************************************************************/
+
+static int Shortest_Arrived(const struct Job *queue, const int *ready, int arrived)
+{
+    int best = arrived;
+    int i;
+
+    for(i = 0; i < arrived; i++)
+    {
+        if(queue[ready[i]].status == 1 && (best == arrived || queue[ready[i]].time_left < queue[ready[best]].time_left)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Start_Timers()
+ * Arguments: timers - The timers of a scheduling algorithm.
+ *            queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            policy - Name of the scheduling algorithm, for the snapshots.
+ *            time_slice - Length of the algorithm's time slice, or 0 if it has none.
+ * Description: Function to start the timing wheel at tick 0 with the arrival timer of each job, set
+ *              for the first tick that is not before its arrival time, and the timer of the first
+ *              snapshot if snapshots are written, and to fire the arrivals at tick 0. Called after
+ *              Reset_Jobs().
+ * *************************************************************************************************/
+
+static void Start_Timers(struct Timers *timers, struct Job *queue, int n, const char *policy, int time_slice)
+{
+    int i;
+
+    timers->arrival = malloc((n > 0 ? n : 1) * sizeof(struct Timer));
+
+    // Prints an error message and exits the program if the memory cannot be allocated.
+    if(!timers->arrival)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+
+    timers->queue = queue;
+    timers->n = n;
+    Wheel_Init(&timers->wheel, 0);
+    Timer_Init(&timers->quantum, NULL);
+    Timer_Init(&timers->snapshot, NULL);
+    timers->due = 0;
+    timers->expired = 0;
+    timers->completed = 0;
+    timers->slices = 0;
+
+    if(snapshots)
+    {
+        Snapshots_Start(snapshots, policy, time_slice, n);
+        Wheel_Add(&timers->wheel, &timers->snapshot, snapshots->interval);
+    }
+    if(steady) {
+        Steady_Start(steady, n);
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        uint64_t tick = (queue[i].arrival_time > 0) ? (uint64_t)queue[i].arrival_time : 0;
+
+        // The job arrives at the first tick whose time is not below its arrival time.
+        while((float)tick < queue[i].arrival_time) {
+            tick++;
+        }
+        Timer_Init(&timers->arrival[i], &queue[i]);
+        Wheel_Add(&timers->wheel, &timers->arrival[i], tick);
+    }
+    Wheel_Advance(&timers->wheel, 0, Fire, timers);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Stop_Timers()
+ * Arguments: timers - The timers of a scheduling algorithm.
+ * Description: Function to write the final snapshot, if snapshots are written, at the time the last
+ *              job was completed, set the estimates of the steady state detection, and free the arrival
+ *              timers once the run is over. If the run was stopped early, every job not completed is
+ *              marked with status 3, with NaN for its end, turnaround and, if it never started, its
+ *              start and response time, so it cannot be mistaken for a job that took no time.
+ * *************************************************************************************************/
+
+static void Stop_Timers(struct Timers *timers)
+{
+    int i;
+
+    for(i = 0; timers->completed < timers->n && i < timers->n; i++)
+    {
+        struct Job *job = &timers->queue[i];
+
+        if(job->status == 2) {
+            continue;
+        }
+        if(job->time_left == job->size && job->context_switch == 0)
+        {
+            job->start_time = NAN;
+            job->response_time = NAN;
+        }
+        job->status = 3;
+        job->end_time = NAN;
+        job->turnaround = NAN;
+    }
+
+    if(snapshots) {
+        Snapshots_Write(snapshots, snapshots->end, timers->completed, timers->due - timers->completed,
+                        timers->due + timers->completed + timers->slices, 1);
+    }
+    if(steady) {
+        Steady_Finish(steady);
+    }
+    free(timers->arrival);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Fire()
+ * Arguments: timer - The timer that fired.
+ *            context - The timers of the scheduling algorithm.
+ * Description: Function called by the timing wheel for each timer that fires. An arrival timer marks
+ *              its job as arrived, and the quantum timer marks the time slice as ended. The snapshot
+ *              timer writes a snapshot of the metrics and is set again for the next one, until every
+ *              job is completed.
+ * *************************************************************************************************/
+
+static void Fire(struct Timer *timer, void *context)
+{
+    struct Timers *timers = context;
+
+    if(timer == &timers->quantum)
+    {
+        timers->expired = 1;
+        timers->slices++;
+    }
+    else if(timer == &timers->snapshot)
+    {
+        if(timers->completed == snapshots->jobs) {
+            return;
+        }
+        Snapshots_Write(snapshots, timer->expires, timers->completed, timers->due - timers->completed,
+                        timers->due + timers->completed + timers->slices, 0);
+        Wheel_Add(&timers->wheel, timer, timer->expires + snapshots->interval);
+    }
+    else
+    {
+        ((struct Job *)timer->data)->status = 1;
+        timers->due++;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Next_Tick()
+ * Arguments: timers - The timers of a scheduling algorithm.
+ *            time_clock - The tick that has just been run.
+ *            completed - Number of jobs completed.
+ * Description: Function to move the clock on to the next tick and fire the timers due by then. If
+ *              every job that has arrived is completed, the ticks up to the next arrival have nothing
+ *              to run, so the clock jumps straight to it. Returns the new time.
+ * *************************************************************************************************/
+
+static inline int Next_Tick(struct Timers *timers, int time_clock, int completed)
+{
+    uint64_t next;
+
+    time_clock++;
+    timers->completed = completed;
+    Wheel_Advance(&timers->wheel, time_clock, Fire, timers);
+
+    // If the CPU is idle until the next timer.
+    if(completed == timers->due && (next = Wheel_Next(&timers->wheel)) != WHEEL_NEVER)
+    {
+        time_clock = next;
+        Wheel_Advance(&timers->wheel, time_clock, Fire, timers);
+    }
+    return time_clock;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Switching()
+ * Arguments: job - The job selected to run on the CPU.
+ *            last_run - Job number of the last job that ran on the CPU.
+ *            overhead - 1 if the overhead model is on, else 0.
+ * Description: Function to return 1 if the current tick is spent switching to the job, else 0. There
+ *              is nothing to switch without the overhead model.
+ * *************************************************************************************************/
+
+KERNEL int Switching(struct Job *job, int *last_run, int overhead)
+{
+    return overhead && Context_Switch(job, last_run);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Run_Tick()
+ * Arguments: job - The job running on the CPU.
+ *            overhead - 1 if the overhead model is on, else 0.
+ * Description: Function to run the job for one tick. Without the overhead model the cache is always
+ *              warm, so the job always makes a full tick of progress.
+ * *************************************************************************************************/
+
+KERNEL void Run_Tick(struct Job *job, int overhead)
+{
+    if(overhead) {
+        Progress(job);
+    }
+    else {
+        job->time_left--;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: FIFO_Kernel()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            overhead - 1 to charge the context switch and cache refill overhead, 0 if there is none.
+ * Description: Function to impletement First In First Out (FIFO) scheduling algorithm. 
+ * *************************************************************************************************/
+
+KERNEL void FIFO_Kernel(struct Job *queue, int n, int overhead)
+{
+    int arrived = 0;                // Number of jobs that have arrived.
+    int current;                    // Keeps track of the job being run.
+    int time_clock = 0;             // Time clock variable used to keep track of time.
+    int last_run = -1;              // Job number of the last job that ran on the CPU.
+    struct Timers timers;           // Arrival timers of the jobs.
+
+    Reset_Jobs(queue, n);           // Sets every job back to not arrived.
+    Start_Timers(&timers, queue, n, "FIFO", 0);
+
+    current = 0;
+
+    // Loops until all jobs are completed.
+    while(current < n && !(steady && steady->reached))
+    {   
+        // Loop to take in the jobs that have arrived. The arrival timer of the job in the array at the index 'arrived' has
+        // set its status to 1 once the time clock has reached its arrival time, and the variable 'arrived' is incremented.
+        while (arrived < n && queue[arrived].status == 1) {
+            arrived++;
+        }
+
+        // If the job in the array at the index current has arrived and the CPU is not busy switching to it.
+        if(queue[current].status == 1 && !Switching(&queue[current], &last_run, overhead))
+        {
+            // If the job in the array at the index current has started running for the first time.
+            if(queue[current].time_left == queue[current].size)
+            {
+                queue[current].start_time = time_clock;
+                queue[current].context_switch++;
+                queue[current].response_time =  queue[current].start_time - queue[current].arrival_time;
+            }
+            
+            // If the job in the array at the index current is completed, that is, time left is 0.
+            if(queue[current].time_left <= 0)
+            {
+                queue[current].time_left = 0.00;
+                queue[current].end_time = time_clock;
+                queue[current].status = 2;
+                queue[current].turnaround = queue[current].end_time - queue[current].arrival_time;
+
+                // Adds the job to the metrics of the snapshots and the steady state detection.
+                if(snapshots) {
+                    Snapshots_Record(snapshots, &queue[current]);
+                }
+                if(steady) {
+                    Steady_Record(steady, &queue[current]);
+                }
+
+                current++;    // Next job
+            }
+
+            // If the job is running.
+            else {
+                Run_Tick(&queue[current], overhead);    // Decrements current job's time left.
+            }
+        }
+        time_clock = Next_Tick(&timers, time_clock, current);   // Increments time.
+    }
+    Stop_Timers(&timers);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: SJF_Kernel()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            overhead - 1 to charge the context switch and cache refill overhead, 0 if there is none.
+ * Description: Function to impletement Shortest Job First (SJF) scheduling algorithm. 
+ * *************************************************************************************************/
+
+KERNEL void SJF_Kernel(struct Job *queue, int n, int overhead)
+{
+    int arrived = 0;                // Number of jobs that have arrived.
+    int completed = 0;              // Keeps track of the number of jobs completed.
+    int current;                    // Keeps track of the job being run.
+    int pending_start = 0;          // Keeps track of which index of the 'ready' array to start sorting from. 
+    int time_clock = 0;             // Time clock variable used to keep track of time.
+    int last_run = -1;              // Job number of the last job that ran on the CPU.
+
+    // Loop variables.
+    int i = 0;
+    int j = 0;
+
+    int *ready = Ready_Array(n);    // Array to store the job number of the jobs that have arrived.
+    struct Timers timers;           // Arrival timers of the jobs.
+
+    Reset_Jobs(queue, n);           // Sets every job back to not arrived.
+    Start_Timers(&timers, queue, n, "SJF", 0);
+
+    current = 0;
+
+    // Loops until all jobs are completed.
+    while(completed < n && !(steady && steady->reached))
+    {   
+        // Loop to take in the jobs that have arrived. The arrival timer of the job in the array at the index 'arrived' has
+        // set its status to 1 once the time clock has reached its arrival time. The program then sorts the 'ready' array
+        // in increasing order of job sizes and places the currently arrived job at the appropriate index.
+        // The variable 'arrived' is then incremented.
+        while (arrived < n && queue[arrived].status == 1)
+        {
+            // If no other jobs have arrived.
+            if(arrived == 0) {
+                ready[0] = arrived;
+            }
+
+            else{
+                // Finds the appropriate index and shifts the 'ready' array by one to the right and places the arrived job
+                // at the appropriate index. 
+                for(i = pending_start; i < arrived; i++)
+                {
+                    if(queue[arrived].size < queue[ready[i]].size) {
+                        for(j = arrived; j > i; j--) {
+                            ready[j] = ready[j-1];
+                        }
+                        break;
+                    }
+                }
+            }    
+            ready[i] = arrived;        
+            arrived++;
+        }
+
+        // If the job is running and the CPU is not busy switching to it.
+        if(ready[current] >= 0 && queue[ready[current]].status == 1 && !Switching(&queue[ready[current]], &last_run, overhead))
+        {
+            // If the job has started running for the first time.
+            if(queue[ready[current]].time_left == queue[ready[current]].size)
+            {
+                queue[ready[current]].start_time = time_clock;
+                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
+                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
+                pending_start++;    // Increments so the program does not sort the currently running job.
+            }
+            
+            // If the job has ended.
+            if(queue[ready[current]].time_left <= 0)
+            {
+                queue[ready[current]].time_left = 0.0;
+                queue[ready[current]].end_time = time_clock;
+                queue[ready[current]].status = 2;
+                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
+
+                // Adds the job to the metrics of the snapshots and the steady state detection.
+                if(snapshots) {
+                    Snapshots_Record(snapshots, &queue[ready[current]]);
+                }
+                if(steady) {
+                    Steady_Record(steady, &queue[ready[current]]);
+                }
+
+                completed++;
+                current++;    // Next job.
+            }
+
+            // If the job is running.
+            else {
+                Run_Tick(&queue[ready[current]], overhead);  // Decrements current job's time left.
+            }
+        }
+        time_clock = Next_Tick(&timers, time_clock, completed);     // Increments time.
+    }
+    Stop_Timers(&timers);
+    free(ready);
+}
+
+
+
+/****************************************************************************************************
+ * Function Name: STCF_Kernel()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+*             pre_emption_size - Integer variable that specifies the length of the time slice.
+ *            overhead - 1 to charge the context switch and cache refill overhead, 0 if there is none.
+ * Description: Function to impletement Shortest Time-to-Completion First (STCF) scheduling algorithm. 
+ * **************************************************************************************************/
+
+KERNEL void STCF_Kernel(struct Job *queue, int n, int pre_emption_size, int overhead)
+{
+    int arrived = 0;                        // Number of jobs that have arrived.
+    int completed = 0;                      // Keeps track of the number of jobs completed.
+    int current;                            // Keeps track of the job being run.
+    int currently_over = 0;                 // Keeps track of the job whose time slice currently ended.
+    int temp = 0;                           // Used for swap.
+    int time_clock = 0;                     // Time clock variable used to keep track of time.
+    int last_run = -1;                      // Job number of the last job that ran on the CPU.
+    struct Timers timers;                   // Arrival timers of the jobs and the time slice timer.
+
+    // Loop variables.
+    int i = 0;
+    int j = 0;
+
+    int *ready = Ready_Array(n);            // Array to store the job number of the jobs that have arrived.
+
+    Reset_Jobs(queue, n);           // Sets every job back to not arrived.
+    Start_Timers(&timers, queue, n, "STCF", pre_emption_size);
+
+    current = 0;
+
+    // Loops until all jobs are completed.
+    while(completed < n && !(steady && steady->reached))
+    {   
+        // Loop to take in the jobs that have arrived. The arrival timer of the job in the array at the index 'arrived' has
+        // set its status to 1 once the time clock has reached its arrival time. The program then sorts the 'ready' array
+        // in increasing order of job sizes and places the currently arrived job at the appropriate index.
+        // The variable 'arrived' is then incremented.
+        while (arrived < n && queue[arrived].status == 1)
+        {
+            // If no other jobs have arrived.
+            if(arrived == 0) {
+                ready[0] = arrived;
+            }
+
+            else
+            {
+                // Finds the appropriate index and shifts the 'ready' array by one to the right and places the arrived job
+                // at the appropriate index.
+                for(i = 0; i < arrived; i++)
+                {
+                    if(queue[arrived].size < queue[ready[i]].size) {
+                        for(j = arrived; j > i; j--) {
+                            ready[j] = ready[j-1];
+                        }
+
+                        // Updates current to account for the shift if current was affected.
+                        if(current >= i) {
+                            current++;
+                        }
+                        break;
+                    }
+                }
+            }
+            ready[i] = arrived;
+            arrived++;
+        }
+
+        // A completion moves 'current' on by one, and past the last arrived job picks the arrived job with the least time
+        // left instead. When there is none, 'current' stays past the arrived jobs, and a job that arrives before it moves
+        // it on again, so it is picked here.
+        if(current >= arrived) {
+            current = Shortest_Arrived(queue, ready, arrived);
+        }
+
+        // If the job is running and the CPU is not busy switching to it.
+        if(current < arrived && queue[ready[current]].status == 1 && !Switching(&queue[ready[current]], &last_run, overhead))
+        {
+            // If the job has started running for the first time.
+            if(queue[ready[current]].time_left == queue[ready[current]].size)
+            {
+                queue[ready[current]].start_time = time_clock;
+                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
+                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
+            }
+            
+            // If the job has ended.
+            if(queue[ready[current]].time_left <= 0)
+            {
+                queue[ready[current]].time_left = 0;
+                queue[ready[current]].end_time = time_clock;
+                queue[ready[current]].status = 2;
+                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
+
+                // Adds the job to the metrics of the snapshots and the steady state detection.
+                if(snapshots) {
+                    Snapshots_Record(snapshots, &queue[ready[current]]);
+                }
+                if(steady) {
+                    Steady_Record(steady, &queue[ready[current]]);
+                }
+
+                completed++;
+                current++;                                      // Next job
+                if(current >= arrived) {
+                    current = Shortest_Arrived(queue, ready, arrived);
+                }
+                Wheel_Cancel(&timers.wheel, &timers.quantum);   // Resets time slice.
+            }
+
+            // If the job is running.
+            else
+            {
+                Run_Tick(&queue[ready[current]], overhead);  // Decrements current job's time left.
+
+                // Starts the time slice on its first tick of progress. It ends after pre_emption_size ticks of progress.
+                if(!Timer_Pending(&timers.quantum)) {
+                    Wheel_Add(&timers.wheel, &timers.quantum, time_clock + pre_emption_size);
+                }
+            }
+        }
+
+        // If the current job has already been completed, finds the next arrived that job that has not been completed.
+        else if(current < arrived && queue[ready[current]].status == 2)
+        {
+
+            // Loop to find the next job that has arrived and has not been completed.
+            while(queue[ready[current]].status != 1)
+            {
+                current++;
+
+                if(current >= arrived)  // Exits loop if none could be found.
+                {
+                    current = 0;
+                    break;
+                }
+            }
+        }  
+        time_clock = Next_Tick(&timers, time_clock, completed);     // Increments time.
+
+        // If the time slice ended with the last tick.
+        if(timers.expired)
+        {
+            timers.expired = 0;
+            currently_over = current;       // Stores 'current' value in 'currently_over'.
+
+            // Loop to sort 'ready' array in increasing order of each of the arrived job's time left.
+            for(i = 0; i < arrived; i++)
+            {   
+                // Swaps indices if the time left of the current job is greater than the time left of the other arrived job.
+                if(queue[ready[i]].status != 2 && queue[ready[currently_over]].time_left > queue[ready[i]].time_left) 
+                {
+                    temp = i;
+                    i = current;
+                    current = temp;
+                }
+            }
+            current = 0;    // Sets 'current' to the beginning of the array.
+
+            // Loop to find the next job that has arrived and has not been completed.
+            while(queue[ready[current]].status != 1)
+            {
+                current++;
+                if(current >= arrived)  // Exits loop if none could be found.
+                {
+                    current = 0;
+                    break;
+                }
+            }
+
+            // If a context switch happens.
+            if(queue[ready[currently_over]].job_no != queue[ready[current]].job_no)
+            {
+                queue[ready[currently_over]].context_switch++;
+                queue[ready[current]].context_switch++;
+            }
+        }
+    }
+    Stop_Timers(&timers);
+    free(ready);
+}
+
+
+
+/****************************************************************************************************
+ * Function Name: RR_Kernel()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            quantum_size - Integer variable that specifies the length of the time slice.
+ *            overhead - 1 to charge the context switch and cache refill overhead, 0 if there is none.
+ * Description: Function to impletement Round Robin (RR) scheduling algorithm. 
+ * **************************************************************************************************/
+
+KERNEL void RR_Kernel(struct Job *queue, int n, int quantum_size, int overhead)
+{
+    int arrived = 0;                    // Number of jobs that have arrived.
+    int completed = 0;                  // Keeps track of the number of jobs completed.
+    int current;                        // Keeps track of the job being run.
+    int currently_over = 0;             // Keeps track of the job whose time slice currently ended.
+    int time_clock = 0;                 // Time clock variable used to keep track of time.
+    int last_run = -1;                  // Job number of the last job that ran on the CPU.
+    struct Timers timers;               // Arrival timers of the jobs and the time slice timer.
+
+
+    int *ready = Ready_Array(n);        // Array to store the job number of the jobs that have arrived.
+
+    Reset_Jobs(queue, n);           // Sets every job back to not arrived.
+    Start_Timers(&timers, queue, n, "RR", quantum_size);
+
+    current = 0;
+
+    // Loops until all jobs are completed.
+    while(completed < n && !(steady && steady->reached))
+    {   
+        // Loop to take in the jobs that have arrived. The arrival timer of the job in the array at the index 'arrived' has
+        // set its status to 1 once the time clock has reached its arrival time, and the value at the index 'arrived' of
+        // the 'ready' array is set to 'arrived'. The variable 'arrived' is then incremented.
+        while (arrived < n && queue[arrived].status == 1)
+        {
+            ready[arrived] = arrived;        
+            arrived++;
+        }
+
+        // If the job is running and the CPU is not busy switching to it.
+        if(ready[current] >= 0 && queue[ready[current]].status == 1 && !Switching(&queue[ready[current]], &last_run, overhead))
+        {
+            // If the job has started running for the first time.
+            if(queue[ready[current]].time_left == queue[ready[current]].size)
+            {
+                queue[ready[current]].start_time = time_clock;
+                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
+                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
+            }
+            
+            // If the job has ended.
+            if(queue[ready[current]].time_left <= 0)
+            {
+                queue[ready[current]].time_left = 0.0;
+                queue[ready[current]].end_time = time_clock;
+                queue[ready[current]].status = 2;
+                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
+
+                // Adds the job to the metrics of the snapshots and the steady state detection.
+                if(snapshots) {
+                    Snapshots_Record(snapshots, &queue[ready[current]]);
+                }
+                if(steady) {
+                    Steady_Record(steady, &queue[ready[current]]);
+                }
+                
+                completed++;
+                current++;                                      // Next job.
+                Wheel_Cancel(&timers.wheel, &timers.quantum);   // Resets time slice.
+
+                // Wraps around to the beginning of the array once the last slot has been run.
+                if(current >= n) {
+                    current = 0;
+                }
+
+            }
+
+            // If the job is running.
+            else
+            {
+                Run_Tick(&queue[ready[current]], overhead);  // Decrements current job's time left.
+
+                // Starts the time slice on its first tick of progress. It ends after quantum_size ticks of progress.
+                if(!Timer_Pending(&timers.quantum)) {
+                    Wheel_Add(&timers.wheel, &timers.quantum, time_clock + quantum_size);
+                }
+            }
+        }
+
+        // If the current job has already been completed, finds the next arrived that job that has not been completed.
+        else if(ready[current] >= 0 && queue[ready[current]].status == 2)
+        {
+            current++;
+
+            // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
+            if(current >= arrived) {
+                current = 0;
+            }
+            currently_over = current;
+
+            // Loop to find the next job that has arrived and has not been completed.
+            while(queue[ready[current]].status != 1)
+            {
+                current++;
+
+                // Exits loop if none could be found.
+                if(current == currently_over) {
+                    break;
+                }
+                // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.           
+                if(current >= arrived) {
+                    current = 0;
+                }
+            }
+        }     
+        time_clock = Next_Tick(&timers, time_clock, completed);     // Increments time.
+
+        // If the time slice ended with the last tick.
+        if(timers.expired)
+        {
+            timers.expired = 0;
+            currently_over = current;   // Stores 'current' value in 'currently_over'.
+            current++;
+
+            // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
+            if(current >= arrived) {
+                current = 0;
+            }
+
+            // Loop to find the next job that has arrived and has not been completed.
+            while(queue[ready[current]].status != 1)
+            {
+                current++;
+                
+                // Exits loop if none could be found.
+                if(current == currently_over) {
+                    break;
+                }
+                // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
+                if(current >= arrived) {
+                    current = 0;
+                }
+            }
+
+            // If a context switch happens.
+            if(current != currently_over)
+            {
+                queue[ready[currently_over]].context_switch++;
+                queue[ready[current]].context_switch++;
+            }
+        }
+    }
+    Stop_Timers(&timers);
+    free(ready);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Overhead_Model()
+ * Description: Function to return 1 if a context switch or a cache refill can cost any time, else 0.
+ * *************************************************************************************************/
+
+static int Overhead_Model(void)
+{
+    return switch_cost > 0 || cache_warmup > 0;
+}
+
+
+
+/***************************************************************************************************
+ * Specializations of the scheduling algorithms, see KERNEL. 'Plain' copies have no overhead model,
+ * and a number is the length of the time slice they are built for.
+ * *************************************************************************************************/
+
+static void FIFO_Plain(struct Job *queue, int n) { FIFO_Kernel(queue, n, 0); }
+static void SJF_Plain(struct Job *queue, int n) { SJF_Kernel(queue, n, 0); }
+static void STCF_Plain(struct Job *queue, int n, int pre_emption_size) { STCF_Kernel(queue, n, pre_emption_size, 0); }
+static void STCF_Plain_30(struct Job *queue, int n) { STCF_Kernel(queue, n, 30, 0); }
+static void STCF_Plain_75(struct Job *queue, int n) { STCF_Kernel(queue, n, 75, 0); }
+static void STCF_30(struct Job *queue, int n) { STCF_Kernel(queue, n, 30, 1); }
+static void STCF_75(struct Job *queue, int n) { STCF_Kernel(queue, n, 75, 1); }
+static void RR_Plain(struct Job *queue, int n, int quantum_size) { RR_Kernel(queue, n, quantum_size, 0); }
+static void RR_Plain_30(struct Job *queue, int n) { RR_Kernel(queue, n, 30, 0); }
+static void RR_Plain_75(struct Job *queue, int n) { RR_Kernel(queue, n, 75, 0); }
+static void RR_30(struct Job *queue, int n) { RR_Kernel(queue, n, 30, 1); }
+static void RR_75(struct Job *queue, int n) { RR_Kernel(queue, n, 75, 1); }
+
+
+
+/***************************************************************************************************
+ * Function Name: FIFO()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ * Description: Function to run the First In First Out (FIFO) scheduling algorithm, without the
+ *              overhead model if it is off.
+ * *************************************************************************************************/
+
+void FIFO(struct Job *queue, int n)
+{
+    if(specialized && !Overhead_Model()) {
+        FIFO_Plain(queue, n);
+    }
+    else {
+        FIFO_Kernel(queue, n, 1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: SJF()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ * Description: Function to run the Shortest Job First (SJF) scheduling algorithm, without the
+ *              overhead model if it is off.
+ * *************************************************************************************************/
+
+void SJF(struct Job *queue, int n)
+{
+    if(specialized && !Overhead_Model()) {
+        SJF_Plain(queue, n);
+    }
+    else {
+        SJF_Kernel(queue, n, 1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: STCF()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            pre_emption_size - Integer variable that specifies the length of the time slice.
+ * Description: Function to run the Shortest Time-to-Completion First (STCF) scheduling algorithm with
+ *              the copy built for the time slice and overhead model, if there is one.
+ * *************************************************************************************************/
+
+void STCF(struct Job *queue, int n, int pre_emption_size)
+{
+    int overhead = Overhead_Model();
+
+    if(!specialized) {
+        STCF_Kernel(queue, n, pre_emption_size, 1);
+    }
+    else if(pre_emption_size == 30) {
+        overhead ? STCF_30(queue, n) : STCF_Plain_30(queue, n);
+    }
+    else if(pre_emption_size == 75) {
+        overhead ? STCF_75(queue, n) : STCF_Plain_75(queue, n);
+    }
+    else if(!overhead) {
+        STCF_Plain(queue, n, pre_emption_size);
+    }
+    else {
+        STCF_Kernel(queue, n, pre_emption_size, 1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: RR()
+ * Arguments: queue - An array of type structure Job used to contains job details.
+ *            n - Number of jobs in the array.
+ *            quantum_size - Integer variable that specifies the length of the time slice.
+ * Description: Function to run the Round Robin (RR) scheduling algorithm with the copy built for the
+ *              time slice and overhead model, if there is one.
+ * *************************************************************************************************/
+
+void RR(struct Job *queue, int n, int quantum_size)
+{
+    int overhead = Overhead_Model();
+
+    if(!specialized) {
+        RR_Kernel(queue, n, quantum_size, 1);
+    }
+    else if(quantum_size == 30) {
+        overhead ? RR_30(queue, n) : RR_Plain_30(queue, n);
+    }
+    else if(quantum_size == 75) {
+        overhead ? RR_75(queue, n) : RR_Plain_75(queue, n);
+    }
+    else if(!overhead) {
+        RR_Plain(queue, n, quantum_size);
+    }
+    else {
+        RR_Kernel(queue, n, quantum_size, 1);
+    }
+}
+
+
+
+/****************************************************************************************************
+ * Function Name: Context_Switch()
+ * Arguments: job - The job selected to run on the CPU.
+ *            last_run - Job number of the last job that ran on the CPU.
+ * Description: Function to charge the context switch overhead. When the selected job is not the last job
+ *              that ran, the switch cost is started and a resumed job is marked as having a cold cache.
+ *              Returns 1 if the current tick is spent switching, else 0.
+ * **************************************************************************************************/
+
+int Context_Switch(struct Job *job, int *last_run)
+{
+    // If the CPU switches to a different job.
+    if(job->job_no != *last_run)
+    {
+        *last_run = job->job_no;
+        job->switch_left = switch_cost;
+
+        // If the job has run before, its cache has to be refilled.
+        if(job->time_left < job->size) {
+            job->warm_left = cache_warmup;
+        }
+    }
+
+    // If the switch is still in progress.
+    if(job->switch_left > 0)
+    {
+        job->switch_left--;
+        job->overhead++;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+/****************************************************************************************************
+ * Function Name: Progress()
+ * Arguments: job - The job running on the CPU.
+ * Description: Function to run the job for one tick. A job with a cold cache only makes partial progress
+ *              and the lost part of the tick is added to its overhead.
+ * **************************************************************************************************/
+
+void Progress(struct Job *job)
+{
+    // If the job is still refilling its cache.
+    if(job->warm_left > 0)
+    {
+        job->time_left -= 1 - cache_penalty;
+        job->overhead += cache_penalty;
+        job->warm_left--;
+    }
+    else {
+        job->time_left--;
+    }
+}
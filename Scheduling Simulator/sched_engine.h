@@ -0,0 +1,78 @@
+/*******************************************************************************************************************************
+ * Scheduler Engine
+ *
+ * Name: sched_engine.h
+ *
+ * Purpose: The scheduling algorithms of the scheduler, FIFO, SJF, STCF and RR, run on an array of jobs held in memory. The
+ *          array can be read from a job runtime file with Read_Jobs() or filled in directly by a program that generates the
+ *          jobs itself, so a workload can be simulated without writing it to a file first.
+ *          Each line of a job runtime file holds a job's size and arrival time, and may hold a third column, the number
+ *          of cores the job needs at the same time (see cores.h). The algorithms here run every job on the one CPU.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile sched_engine.c, timer_wheel.c, snapshot.c and steady_state.c together with the program, with the -lm option.
+ * 	The scheduler also needs results.c and queueing.c.
+ * 	(gcc -O2 -o scheduler scheduler.c sched_engine.c timer_wheel.c snapshot.c steady_state.c results.c queueing.c -lm)
+ *
+*******************************************************************************************************************************/
+#ifndef SCHED_ENGINE_H
+#define SCHED_ENGINE_H
+
+#include <stdio.h>
+
+#define NO_OF_POLICIES 5    // Number of scheduling algorithms run by Run_Policy().
+
+struct Snapshots;
+struct Steady_State;
+
+// Structure contains each job's details.
+struct Job
+{
+    int job_no;
+    float arrival_time;
+    int status;     // 0: Not arrived, 1: Arrived, 2: Completed & 3: Not completed when the run was stopped early.
+    float size;
+    int width;              // Number of cores the job needs at the same time, 1 unless the file gives it.
+    float time_left;
+    float start_time;
+    int context_switch;
+    float end_time;
+    float response_time;
+    float turnaround;
+    float overhead;         // Ticks lost to context switches and cache refills.
+    int switch_left;        // Ticks left in the context switch to this job.
+    int warm_left;          // Ticks left before the job's cache is warm again.
+};
+
+// Structure contains the totals and averages of one scheduling algorithm over all jobs.
+struct Summary
+{
+    float avg_response;
+    float avg_turnaround;
+    int total_context_switches;
+    float overhead;         // Ticks lost to context switches and cache refills.
+    float cpu_time;         // Ticks of CPU time used, including the overhead.
+};
+
+extern int switch_cost;
+extern float cache_penalty;
+extern int cache_warmup;
+extern int specialized;
+extern struct Snapshots *snapshots;     // See snapshot.h.
+extern struct Steady_State *steady;     // See steady_state.h.
+extern const char *policy_names[NO_OF_POLICIES];
+
+int Count_Jobs(FILE *fin);
+int Read_Jobs(FILE *fin, struct Job *queue, int n);
+void Reset_Jobs(struct Job *queue, int n);
+void Run_Policy(int policy, struct Job *queue, int n);
+void Summarize(const struct Job *queue, int n, struct Summary *summary);
+void FIFO(struct Job *queue, int n);
+void SJF(struct Job *queue, int n);
+void STCF(struct Job *queue, int n, int pre_emption_size);
+void RR(struct Job *queue, int n, int quantum_size);
+int Context_Switch(struct Job *job, int *last_run);
+void Progress(struct Job *job);
+
+#endif
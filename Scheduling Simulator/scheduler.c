@@ -11,45 +11,161 @@
  *          switches, end time, response time and turn around time for each job along with the the total number of context 
  *          switches and average response and turnaround time for each algorithm to three files corresponding to the three
  *          input files. 
+ *          Each context switch can be charged a fixed number of ticks of switch overhead, and a job that is resumed can
+ *          be made to progress slower for a number of ticks while its cache is refilled. The overhead is reported as a
+ *          share of the CPU time for each algorithm.
+ *          With -b the results are written to binary results files, scheduling_<n>.res, instead of the csv files. Any job's
+ *          details or any algorithm's column can be read from them without reading the rest of the file (see results.h
+ *          and results_query.c).
+ *          With -m, each algorithm writes snapshots of its metrics so far, one line of JSON every 'interval' ticks of
+ *          simulated time, to a file or named pipe while it runs, so that a long simulation can be followed as it goes
+ *          (see snapshot.h).
+ *          With -a, nothing is simulated: the average response and turnaround time of FIFO and the average turnaround
+ *          time of processor sharing, as a stand-in for RR, are estimated for each input file from the moments of its
+ *          job sizes and times between arrivals (see queueing.h) and printed.
+ *          With -p, each algorithm stops as soon as its average turnaround time is known to the given relative precision,
+ *          and the jobs of its warm-up from an empty system are left out of the averages written to the output files (see
+ *          steady_state.h). The jobs left out, the jobs measured and the precision reached are printed for each algorithm.
+ *          The jobs an algorithm had not completed when it stopped have status 3, with nan for the times they never
+ *          reached. The three input files are overloaded, so their times keep growing and no algorithm stops early on
+ *          them; -p pays off on input files of a stable load.
  * 
- * Usage: ./scheduler
+ * Usage: ./scheduler [-a] [-b] [-m snapshot_file [-i interval]] [-p precision] [switch_cost] [cache_penalty] [cache_warmup]
+ *  -a - Print the analytic estimates of each input file instead of simulating.
+ *  -b - Write the results to binary results files.
+ *  -m - Write metrics snapshots to the file or named pipe while the algorithms run.
+ *  -i - Ticks of simulated time between snapshots. Default = 100000.
+ *  -p - Relative half-width of the 95% confidence interval of the average turnaround time at which each algorithm
+ *       stops, such as 0.05.
+ *  switch_cost - Number of ticks spent on each context switch. Default = 0.
+ *  cache_penalty - Fraction (0 to 1) of progress lost per tick while a resumed job refills its cache. Default = 0.
+ *  cache_warmup - Number of ticks a resumed job runs at the reduced speed. Default = 0.
+ *  (./scheduler 2 0.5 10)
+ *  (./scheduler -b)
+ *  (./scheduler -m snapshots.jsonl -i 50000)
+ *  (./scheduler -a)
+ *  (./scheduler -p 0.05)
  * 
  * Subroutines/libraries required: 
  * 	See include statements.
+ * 	The scheduling algorithms are implemented in sched_engine.c, which is compiled together with the program and with
+ * 	timer_wheel.c, snapshot.c, steady_state.c, results.c and queueing.c, with the -lm option.
+ * 	(gcc -O2 -o scheduler scheduler.c sched_engine.c timer_wheel.c snapshot.c steady_state.c results.c queueing.c -lm)
  * 
 *******************************************************************************************************************************/
 #include<stdio.h>
 #include <stdlib.h>
 #include<string.h>
 #include <sys/stat.h>
+#include "sched_engine.h"
+#include "results.h"
+#include "snapshot.h"
+#include "steady_state.h"
+#include "queueing.h"
 
 #define NO_OF_JOBS 5000     // Sets value for the number of jobs to be generated.
 
-// Structure contains each job's details.
-struct Job
-{
-    int job_no;
-    float arrival_time;
-    int status;     // 0: Not arrived, 1: Arrived & 2: Completed. 
-    float size;
-    float time_left;
-    float start_time;
-    int context_switch;
-    float end_time;
-    float response_time;
-    float turnaround;
-};
-
-void Scheduler(FILE *fin, FILE *fout);
-void FIFO(struct Job *queue, FILE *fin);                                                                
-void SJF(struct Job *queue, FILE *fin);
-void STCF(struct Job *queue, FILE *fin, int pre_emption_size);
-void RR(struct Job *queue, FILE *fin, int quantum_size);
-
-
-int main()
+void Scheduler(FILE *fin, FILE *fout, const char *results_path);
+void Run_Label(const char *input);
+void Estimate_File(const char *path);
+void Summarize_Run(const char *name, const struct Job *queue, struct Summary *summary);
+
+
+int main(int argc, char *argv[])
 {
     FILE *fi1, *fi2, *fi3, *fo1, *fo2, *fo3;
+    int binary = 0;         // 1 if the results are written to binary results files, else 0.
+    int analytic = 0;       // 1 if the analytic estimates are printed instead of simulating, else 0.
+    const char *snapshot_path = NULL;           // File or named pipe the snapshots are written to, if any.
+    long long interval = SNAPSHOT_INTERVAL;     // Ticks of simulated time between snapshots.
+    double precision = 0;   // Relative precision at which each algorithm stops. 0 if the algorithms run every job.
+    static struct Snapshots stream;
+    static struct Steady_State detection;
+
+    // Reads the options and skips over them.
+    while(argc > 1 && (strcmp(argv[1], "-b") == 0 || strcmp(argv[1], "-m") == 0 || strcmp(argv[1], "-i") == 0 ||
+                       strcmp(argv[1], "-a") == 0 || strcmp(argv[1], "-p") == 0))
+    {
+        if(strcmp(argv[1], "-b") == 0) {
+            binary = 1;
+        }
+        else if(strcmp(argv[1], "-a") == 0) {
+            analytic = 1;
+        }
+        else
+        {
+            // Prints an error message and exits the program if the option has no value.
+            if(argc < 3)
+            {
+                fprintf(stderr, "Error! %s needs a value.\n", argv[1]);
+                exit(-1);
+            }
+            if(strcmp(argv[1], "-m") == 0) {
+                snapshot_path = argv[2];
+            }
+            else if(strcmp(argv[1], "-p") == 0)
+            {
+                if((precision = atof(argv[2])) <= 0)
+                {
+                    fprintf(stderr, "Error! The precision must be above 0.\n");
+                    exit(-1);
+                }
+            }
+            else if((interval = atoll(argv[2])) < 1)
+            {
+                fprintf(stderr, "Error! The snapshot interval must be at least 1 tick.\n");
+                exit(-1);
+            }
+            argv[2] = argv[0];
+            argc--;
+            argv++;
+        }
+        argv[1] = argv[0];
+        argc--;
+        argv++;
+    }
+
+    // Reads the overhead model from the command line.
+    if(argc > 1) {
+        switch_cost = atoi(argv[1]);
+    }
+    if(argc > 2) {
+        cache_penalty = atof(argv[2]);
+    }
+    if(argc > 3) {
+        cache_warmup = atoi(argv[3]);
+    }
+
+    // Prints an error message and exits the program if the overhead model is invalid.
+    if(switch_cost < 0 || cache_penalty < 0 || cache_penalty >= 1 || cache_warmup < 0)
+    {
+        fprintf(stderr, "Usage: %s [-a] [-b] [-m snapshot_file [-i interval]] [-p precision] [switch_cost >= 0] "
+                "[0 <= cache_penalty < 1] [cache_warmup >= 0]\n", argv[0]);
+        exit(-1);
+    }
+
+    // Estimates each input file from its moments instead of simulating it.
+    if(analytic)
+    {
+        Estimate_File("job_runtime_1.csv");
+        Estimate_File("job_runtime_2.csv");
+        Estimate_File("job_runtime_3.csv");
+        exit(0);
+    }
+
+    // Opens the stream of snapshots, which the scheduling algorithms write to while they run.
+    if(snapshot_path)
+    {
+        Snapshots_Open(&stream, snapshot_path, interval);
+        snapshots = &stream;
+    }
+
+    // Turns on the steady state detection, which stops each scheduling algorithm once its averages are precise enough.
+    if(precision > 0)
+    {
+        Steady_Open(&detection, precision);
+        steady = &detection;
+    }
 
     // Opens the input files containing the job arrival time and job size for reading.
     fi1 = fopen("job_runtime_1.csv", "r");
@@ -63,6 +179,28 @@ int main()
         exit(-1);
     }
 
+    // Writes the results of each input file to a binary results file.
+    if(binary)
+    {
+        Run_Label("job_runtime_1.csv");
+        Scheduler(fi1, NULL, "scheduling_1.res");
+        Run_Label("job_runtime_2.csv");
+        Scheduler(fi2, NULL, "scheduling_2.res");
+        Run_Label("job_runtime_3.csv");
+        Scheduler(fi3, NULL, "scheduling_3.res");
+
+        fclose(fi1);
+        fclose(fi2);
+        fclose(fi3);
+        if(snapshots) {
+            Snapshots_Close(snapshots);
+        }
+        if(steady) {
+            Steady_Close(steady);
+        }
+        exit(0);
+    }
+
     // Opens output files for writing.
     fo1 = fopen("scheduling_1.csv", "w");
     fo2 = fopen("scheduling_2.csv", "w");
@@ -82,9 +220,12 @@ int main()
         exit(-1);
     }
 
-    Scheduler(fi1, fo1);
-    Scheduler(fi2, fo2);
-    Scheduler(fi3, fo3);
+    Run_Label("job_runtime_1.csv");
+    Scheduler(fi1, fo1, NULL);
+    Run_Label("job_runtime_2.csv");
+    Scheduler(fi2, fo2, NULL);
+    Run_Label("job_runtime_3.csv");
+    Scheduler(fi3, fo3, NULL);
 
     // Closes all the files.
     fclose(fi1);
@@ -93,6 +234,12 @@ int main()
     fclose(fo1);
     fclose(fo2);
     fclose(fo3);
+    if(snapshots) {
+        Snapshots_Close(snapshots);
+    }
+    if(steady) {
+        Steady_Close(steady);
+    }
 
     exit(0);
 }
@@ -100,620 +247,176 @@ int main()
 
 
 /***************************************************************************************************
- * Function Name: Scheduler()
- * Arguments: fin - File containing job arrival time and job size.
- *            fout - File used to write job details.
- * Description: Function to call the scheduling alogrithms, compute the average response and turnaround
- *              time and the total number of context switches, and write the the job details to a csv file.
+ * Function Name: Run_Label()
+ * Arguments: input - Name of the input file about to be simulated.
+ * Description: Function to name the runs of the scheduling algorithms in the snapshots, if they are
+ *              written, after their input file, and to head the steady state lines of the input file.
  * *************************************************************************************************/
-void Scheduler(FILE *fin, FILE *fout)
-{   
-    // Creates array of type structure Job to contains the job details for each scheduling algorithm.
-    struct Job FIFO_queue[NO_OF_JOBS];
-    struct Job SJF_queue[NO_OF_JOBS];
-    struct Job STCF_queue[NO_OF_JOBS];
-    struct Job RR1_queue[NO_OF_JOBS];
-    struct Job RR2_queue[NO_OF_JOBS];
-
-    // Calls the scheduling algorithms.
-    FIFO(FIFO_queue, fin);
-    SJF(SJF_queue, fin);
-    STCF(STCF_queue, fin, 30);
-    RR(RR1_queue, fin, 30);
-    RR(RR2_queue, fin, 75);
-
-    int i;
-
-    // Variables to store the the average response and turnaround time ,and the total number of context switches
-    // for each scheduling algorithm.
-    float avg_response_FIFO = 0;
-    float avg_turnaround_FIFO = 0;
-    int total_context_switches_FIFO = 0;
-
-    float avg_response_SJF = 0;
-    float avg_turnaround_SJF = 0;
-    int total_context_switches_SJF = 0;
-
-    float avg_response_STCF = 0;
-    float avg_turnaround_STCF = 0;
-    int total_context_switches_STCF = 0;
-
-    float avg_response_RR1 = 0;
-    float avg_turnaround_RR1 = 0;
-    int total_context_switches_RR1 = 0;
-
-    float avg_response_RR2 = 0;
-    float avg_turnaround_RR2 = 0;
-    int total_context_switches_RR2 = 0;
-
-    // Computes the average response and turnaround time ,and the total number of context switches for each scheduling algorithm.
-    for(i = 0; i<NO_OF_JOBS; i++)
-    {
-        avg_response_FIFO += FIFO_queue[i].response_time;
-        avg_turnaround_FIFO += FIFO_queue[i].turnaround;
-        total_context_switches_FIFO += FIFO_queue[i].context_switch;
-
-        avg_response_SJF += SJF_queue[i].response_time;
-        avg_turnaround_SJF += SJF_queue[i].turnaround;
-        total_context_switches_SJF += SJF_queue[i].context_switch;
-
-        avg_response_STCF += STCF_queue[i].response_time;
-        avg_turnaround_STCF += STCF_queue[i].turnaround;
-        total_context_switches_STCF += STCF_queue[i].context_switch;
-
-        avg_response_RR1 += RR1_queue[i].response_time;
-        avg_turnaround_RR1 += RR1_queue[i].turnaround;
-        total_context_switches_RR1 += RR1_queue[i].context_switch;
-
-        avg_response_RR2 += RR2_queue[i].response_time;
-        avg_turnaround_RR2 += RR2_queue[i].turnaround;
-        total_context_switches_RR2 += RR2_queue[i].context_switch;
+void Run_Label(const char *input)
+{
+    if(snapshots) {
+        snapshots->run = input;
     }
-
-    avg_response_FIFO = avg_response_FIFO / NO_OF_JOBS;
-    avg_turnaround_FIFO = avg_turnaround_FIFO / NO_OF_JOBS;
-
-    avg_response_SJF = avg_response_SJF / NO_OF_JOBS;
-    avg_turnaround_SJF = avg_turnaround_SJF / NO_OF_JOBS;
-
-    avg_response_STCF = avg_response_STCF / NO_OF_JOBS;
-    avg_turnaround_STCF = avg_turnaround_STCF / NO_OF_JOBS;
-
-    avg_response_RR1 = avg_response_RR1 / NO_OF_JOBS;
-    avg_turnaround_RR1 = avg_turnaround_RR1 / NO_OF_JOBS;
-
-    avg_response_RR2 = avg_response_RR2 / NO_OF_JOBS;
-    avg_turnaround_RR2 = avg_turnaround_RR2 / NO_OF_JOBS;
-
-    // Writes job details to the output file in csv format.
-    fprintf(fout, ",Job Details,,,,,,FIFO,,,,,,,,SJF,,,,,,,,STCF(30),,,,,,,,RR(30),,,,,,,,RR(75)\n");
-    fprintf(fout, ",,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d\n",
-    avg_response_FIFO, avg_turnaround_FIFO, total_context_switches_FIFO, avg_response_SJF,avg_turnaround_SJF, total_context_switches_SJF,
-    avg_response_STCF, avg_turnaround_STCF, total_context_switches_STCF, avg_response_RR1,avg_turnaround_RR1, total_context_switches_RR1,
-    avg_response_RR2, avg_turnaround_RR2, total_context_switches_RR2);
-    fprintf(fout,"Job No,Arrival Time,Job Size, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time\n");
-
-    for(i = 0; i < NO_OF_JOBS; i++)
-    {
-        fprintf(fout,"%d,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f\n",
-        FIFO_queue[i].job_no, FIFO_queue[i].arrival_time, FIFO_queue[i].size,
-        FIFO_queue[i].start_time, FIFO_queue[i].time_left, FIFO_queue[i].status, FIFO_queue[i].context_switch, FIFO_queue[i].end_time, FIFO_queue[i].response_time, FIFO_queue[i].turnaround,
-        SJF_queue[i].start_time, SJF_queue[i].time_left, FIFO_queue[i].status, SJF_queue[i].context_switch, SJF_queue[i].end_time, SJF_queue[i].response_time, SJF_queue[i].turnaround,
-        STCF_queue[i].start_time, STCF_queue[i].time_left, FIFO_queue[i].status, STCF_queue[i].context_switch, STCF_queue[i].end_time, STCF_queue[i].response_time, STCF_queue[i].turnaround,
-        RR1_queue[i].start_time, RR1_queue[i].time_left, FIFO_queue[i].status, RR1_queue[i].context_switch, RR1_queue[i].end_time, RR1_queue[i].response_time, RR1_queue[i].turnaround,
-        RR2_queue[i].start_time, RR2_queue[i].time_left, FIFO_queue[i].status, RR2_queue[i].context_switch, RR2_queue[i].end_time, RR2_queue[i].response_time, RR2_queue[i].turnaround);
+    if(steady) {
+        printf("%s\n", input);
     }
-
-    // Resets the arrays.
-    memset(FIFO_queue, 0, sizeof(FIFO_queue));
-    memset(SJF_queue, 0, sizeof(SJF_queue));
-    memset(STCF_queue, 0, sizeof(STCF_queue));
-    memset(RR1_queue, 0, sizeof(RR1_queue));
-    memset(RR2_queue, 0, sizeof(RR2_queue));
 }
 
 
 
 /***************************************************************************************************
- * Function Name: FIFO()
- * Arguments: queue - An array of type structure Job used to contains job details.
- *            fin - File containing job arrival time and job size.
- * Description: Function to impletement First In First Out (FIFO) scheduling algorithm. 
+ * Function Name: Summarize_Run()
+ * Arguments: name - Name of the scheduling algorithm that has just run.
+ *            queue - An array of type structure Job that contains the job details of the run.
+ *            summary - Structure to return the summary of the run in.
+ * Description: Function to compute the summary of a run. With steady state detection, the averages
+ *              are those of the jobs after the warm-up, and the jobs left out, the jobs measured and
+ *              the precision reached are printed.
  * *************************************************************************************************/
-
-void FIFO(struct Job *queue, FILE *fin)
+void Summarize_Run(const char *name, const struct Job *queue, struct Summary *summary)
 {
-    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
-
-    int arrived = 0;                // Number of jobs that have arrived.
-    int current;                    // Keeps track of the job being run.
-    int time_clock = 0;             // Time clock variable used to keep track of time.
-
-    // Loop to read the job runtime and arrival time and populates the array.
-    for(current = 0; current < NO_OF_JOBS; current++)
-    {
-        fscanf(fin, "%f,%f", &queue[current].size, &queue[current].arrival_time);
-        queue[current].job_no = current;
-        queue[current].status = 0;
-        queue[current].context_switch = 0;
-        queue[current].time_left = queue[current].size;
+    Summarize(queue, NO_OF_JOBS, summary);
+    if(!steady) {
+        return;
     }
 
-    current = 0;
-
-    // Loops until all jobs are completed.
-    while(current < NO_OF_JOBS)
-    {   
-        // Loop to check which jobs have arrived. If the arrival time of the job in the array at the index 'arrived' is less
-        // than or equal to the time clock, then the status of the job is set to 1 and the variable 'arrived' is incremented.
-        while (arrived < NO_OF_JOBS && queue[arrived].status == 0 && queue[arrived].arrival_time <= time_clock)
-        {
-            queue[arrived].status = 1;
-            arrived++;
-        }
-
-        // If the job in the array at the index current has arrived.
-        if(queue[current].status == 1)
-        {
-            // If the job in the array at the index current has started running for the first time.
-            if(queue[current].time_left == queue[current].size)
-            {
-                queue[current].start_time = time_clock;
-                queue[current].context_switch++;
-                queue[current].response_time =  queue[current].start_time - queue[current].arrival_time;
-            }
-            
-            // If the job in the array at the index current is completed, that is, time left is 0.
-            if(queue[current].time_left <= 0)
-            {
-                queue[current].time_left = 0.00;
-                queue[current].end_time = time_clock;
-                queue[current].status = 2;
-                queue[current].turnaround = queue[current].end_time - queue[current].arrival_time;
-
-                current++;    // Next job
-            }
-
-            // If the job is running.
-            else {
-                queue[current].time_left--;     // Decrements current job's time left.
-            }
-        }
-        time_clock++;   // Increments time.
+    summary->avg_response = steady->mean_response;
+    summary->avg_turnaround = steady->mean_turnaround;
+    printf("%-10s warm-up %d, measured %d", name, steady->warmup, steady->measured);
+    if(steady->half_width >= 0) {
+        printf(", +/- %.2f%%", 100 * steady->half_width);
     }
+    printf("%s\n", steady->reached ? "" : " (precision not reached)");
 }
 
 
 
 /***************************************************************************************************
- * Function Name: SJF()
- * Arguments: queue - An array of type structure Job used to contains job details.
- *            fin - File containing job arrival time and job size.
- * Description: Function to impletement Shortest Job First (SJF) scheduling algorithm. 
+ * Function Name: Estimate_File()
+ * Arguments: path - Name of the input file.
+ * Description: Function to print the analytic estimates of FIFO and processor sharing for the jobs of
+ *              an input file.
  * *************************************************************************************************/
-
-void SJF(struct Job *queue, FILE *fin)
+void Estimate_File(const char *path)
 {
-    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
-
-    int arrived = 0;                // Number of jobs that have arrived.
-    int completed = 0;              // Keeps track of the number of jobs completed.
-    int current;                    // Keeps track of the job being run.
-    int pending_start = 0;          // Keeps track of which index of the 'ready' array to start sorting from. 
-    int time_clock = 0;             // Time clock variable used to keep track of time.
-
-    // Loop variables.
-    int i = 0;
-    int j = 0;
-
-    int ready[NO_OF_JOBS];          // Array to store the job number of the jobs that have arrived.
+    FILE *fin = fopen(path, "r");
+    struct Job *queue;
+    struct Moments moments;
+    int n;
 
-    // Initializes the 'ready' array with -1.
-    for(current = 0; current < NO_OF_JOBS; current++) {
-        ready[current] = -1;
+    // Prints and error message and exits the program if the input file cannot be openned.
+    if(!fin)
+    {
+        perror("Error! Cannot open input file(s)!");
+        exit(-1);
     }
 
-    // Loop to read the job runtime and arrival time and populate the array.
-    for(current = 0; current < NO_OF_JOBS; current++)
+    n = Count_Jobs(fin);
+    if(!(queue = malloc((n > 0 ? n : 1) * sizeof(struct Job))))
     {
-        fscanf(fin, "%f,%f", &queue[current].size, &queue[current].arrival_time);
-        queue[current].job_no = current;
-        queue[current].status = 0;
-        queue[current].context_switch = 0;
-        queue[current].time_left = queue[current].size;
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
     }
+    n = Read_Jobs(fin, queue, n);
+    fclose(fin);
 
-    current = 0;
-
-    // Loops until all jobs are completed.
-    while(completed < NO_OF_JOBS)
-    {   
-        // Loop to check which jobs have arrived. If the arrival time of the job in the array at the index 'arrived' is less
-        // than or equal to the time clock, then the status of the job is set to 1 and then the program sorts the 'ready'
-        // array in increasing order of job sizes and places the currently arrived job at the appropriate index.
-        // The variable 'arrived' is then incremented.
-        while (arrived < NO_OF_JOBS && queue[arrived].status == 0 && queue[arrived].arrival_time <= time_clock)
-        {
-            queue[arrived].status = 1;
-
-            // If no other jobs have arrived.
-            if(arrived == 0) {
-                ready[0] = arrived;
-            }
+    Trace_Moments(queue, n, &moments);
+    printf("%s (%d jobs)\n", path, n);
+    Print_Estimates(stdout, &moments);
+    printf("\n");
 
-            else{
-                // Finds the appropriate index and shifts the 'ready' array by one to the right and places the arrived job
-                // at the appropriate index. 
-                for(i = pending_start; i < arrived; i++)
-                {
-                    if(queue[arrived].size < queue[ready[i]].size) {
-                        for(j = arrived; j > i; j--) {
-                            ready[j] = ready[j-1];
-                        }
-                        break;
-                    }
-                }
-            }    
-            ready[i] = arrived;        
-            arrived++;
-        }
-
-        // If the job is running.
-        if(ready[current] >= 0 && queue[ready[current]].status == 1)
-        {
-            // If the job has started running for the first time.
-            if(queue[ready[current]].time_left == queue[ready[current]].size)
-            {
-                queue[ready[current]].start_time = time_clock;
-                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
-                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
-                pending_start++;    // Increments so the program does not sort the currently running job.
-            }
-            
-            // If the job has ended.
-            if(queue[ready[current]].time_left <= 0)
-            {
-                queue[ready[current]].time_left = 0.0;
-                queue[ready[current]].end_time = time_clock;
-                queue[ready[current]].status = 2;
-                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
-
-                completed++;
-                current++;    // Next job.
-            }
-
-            // If the job is running.
-            else {
-                queue[ready[current]].time_left--;  // Decrements current job's time left.
-            }
-        }
-        time_clock++;   // Increments time.
-    }
+    free(queue);
 }
 
 
 
-/****************************************************************************************************
- * Function Name: STCF()
- * Arguments: queue - An array of type structure Job used to contains job details.
- *            fin - File containing job arrival time and job size.
-*             pre_emption_size - Integer variable that specifies the length of the time slice.
- * Description: Function to impletement Shortest Time-to-Completion First (STCF) scheduling algorithm. 
- * **************************************************************************************************/
-
-void STCF(struct Job *queue, FILE *fin, int pre_emption_size)
-{
-    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
-
-    int arrived = 0;                        // Number of jobs that have arrived.
-    int completed = 0;                      // Keeps track of the number of jobs completed.
-    int current;                            // Keeps track of the job being run.
-    int currently_over = 0;                 // Keeps track of the job whose time slice currently ended.
-    int temp = 0;                           // Used for swap.
-    int time_clock = 0;                     // Time clock variable used to keep track of time.
-    int time_slice = pre_emption_size;      // Time variable use to keep track of time left in the time slice.
-
-    // Loop variables.
-    int i = 0;
-    int j = 0;
+/***************************************************************************************************
+ * Function Name: Scheduler()
+ * Arguments: fin - File containing job arrival time and job size.
+ *            fout - File used to write job details.
+ *            results_path - Name of the binary results file to write instead of fout, or NULL.
+ * Description: Function to call the scheduling alogrithms, compute the average response and turnaround
+ *              time and the total number of context switches, and write the the job details to a csv file
+ *              or a binary results file.
+ * *************************************************************************************************/
+void Scheduler(FILE *fin, FILE *fout, const char *results_path)
+{   
+    // Creates array of type structure Job to contains the job details for each scheduling algorithm.
+    struct Job FIFO_queue[NO_OF_JOBS];
+    struct Job SJF_queue[NO_OF_JOBS];
+    struct Job STCF_queue[NO_OF_JOBS];
+    struct Job RR1_queue[NO_OF_JOBS];
+    struct Job RR2_queue[NO_OF_JOBS];
 
-    int ready[NO_OF_JOBS];                  // Array to store the job number of the jobs that have arrived.
+    // Reads the jobs once and copies them for each scheduling algorithm.
+    Read_Jobs(fin, FIFO_queue, NO_OF_JOBS);
+    memcpy(SJF_queue, FIFO_queue, sizeof(FIFO_queue));
+    memcpy(STCF_queue, FIFO_queue, sizeof(FIFO_queue));
+    memcpy(RR1_queue, FIFO_queue, sizeof(FIFO_queue));
+    memcpy(RR2_queue, FIFO_queue, sizeof(FIFO_queue));
+
+    // Calls the scheduling algorithms, and computes the average response and turnaround time, the total number of
+    // context switches and the overhead for each one as soon as it has run, while its steady state detection is kept.
+    struct Summary FIFO_summary, SJF_summary, STCF_summary, RR1_summary, RR2_summary;
+
+    FIFO(FIFO_queue, NO_OF_JOBS);
+    Summarize_Run(policy_names[0], FIFO_queue, &FIFO_summary);
+    SJF(SJF_queue, NO_OF_JOBS);
+    Summarize_Run(policy_names[1], SJF_queue, &SJF_summary);
+    STCF(STCF_queue, NO_OF_JOBS, 30);
+    Summarize_Run(policy_names[2], STCF_queue, &STCF_summary);
+    RR(RR1_queue, NO_OF_JOBS, 30);
+    Summarize_Run(policy_names[3], RR1_queue, &RR1_summary);
+    RR(RR2_queue, NO_OF_JOBS, 75);
+    Summarize_Run(policy_names[4], RR2_queue, &RR2_summary);
 
-    // Initializes the 'ready' array with -1.
-    for(current = 0; current < NO_OF_JOBS; current++) {
-        ready[current] = -1;
-    }
+    int i;
 
-    // Loop to read the job runtime and arrival time and populate the array.
-    for(current = 0; current < NO_OF_JOBS; current++)
+    // Writes the columns of each scheduling algorithm to the results file, in the order of policy_names[].
+    if(results_path)
     {
-        fscanf(fin, "%f,%f", &queue[current].size, &queue[current].arrival_time);
-        queue[current].job_no = current;
-        queue[current].status = 0;
-        queue[current].context_switch = 0;
-        queue[current].time_left = queue[current].size;
-    }
-
-    current = 0;
-
-    // Loops until all jobs are completed.
-    while(completed < NO_OF_JOBS)
-    {   
-        // Loop to check which jobs have arrived. If the arrival time of the job in the array at the index 'arrived' is less
-        // than or equal to the time clock, then the status of the job is set to 1 and then the program sorts the 'ready'
-        // array in increasing order of job sizes and places the currently arrived job at the appropriate index.
-        // The variable 'arrived' is then incremented.
-        while (arrived < NO_OF_JOBS && queue[arrived].status == 0 && queue[arrived].arrival_time <= time_clock)
-        {
-            queue[arrived].status = 1;
-
-            // If no other jobs have arrived.
-            if(arrived == 0) {
-                ready[0] = arrived;
-            }
-
-            else
-            {
-                // Finds the appropriate index and shifts the 'ready' array by one to the right and places the arrived job
-                // at the appropriate index.
-                for(i = 0; i < arrived; i++)
-                {
-                    if(queue[arrived].size < queue[ready[i]].size) {
-                        for(j = arrived; j > i; j--) {
-                            ready[j] = ready[j-1];
-                        }
-
-                        // Updates current to account for the shift if current was affected.
-                        if(current >= i) {
-                            current++;
-                        }
-                        break;
-                    }
-                }
-            }    
-            ready[i] = arrived;        
-            arrived++;
-        }
-
-        // If the job is running.
-        if(ready[current] >= 0 && queue[ready[current]].status == 1)
-        {
-            // If the job has started running for the first time.
-            if(queue[ready[current]].time_left == queue[ready[current]].size)
-            {
-                queue[ready[current]].start_time = time_clock;
-                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
-                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
-            }
-            
-            // If the job has ended.
-            if(queue[ready[current]].time_left <= 0)
-            {
-                queue[ready[current]].time_left = 0;
-                queue[ready[current]].end_time = time_clock;
-                queue[ready[current]].status = 2;
-                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
-
-                completed++;
-                current++;                      // Next job
-                time_slice = pre_emption_size;  // Resets time slice.
-            }
-
-            // If the job is running.
-            else
-            {
-                queue[ready[current]].time_left--;  // Decrements current job's time left.
-                time_slice--;                       // Decrements time slice.
-            }
-
-             // If the time slice is over.
-            if(time_slice == 0)
-            {
-                time_slice = pre_emption_size;  // Resets time slice.
-                currently_over = current;       // Stores 'current' value in 'currently_over'.
-
-                // Loop to sort 'ready' array in increasing order of each of the arrived job's time left.
-                for(i = 0; i < arrived; i++)
-                {   
-                    // Swaps indices if the time left of the current job is greater than the time left of the other arrived job.
-                    if(queue[ready[i]].status != 2 && queue[ready[currently_over]].time_left > queue[ready[i]].time_left) 
-                    {
-                        temp = i;
-                        i = current;
-                        current = temp;
-                    }
-                }
-                current = 0;    // Sets 'current' to the beginning of the array.
-
-                // Loop to find the next job that has arrived and has not been completed.
-                while(queue[ready[current]].status != 1)
-                {
-                    current++;
-                    if(current >= arrived)  // Exits loop if none could be found.
-                    {
-                        current = 0;
-                        break;
-                    }
-                }
-
-                // If a context switch happens.
-                if(queue[ready[currently_over]].job_no != queue[ready[current]].job_no)
-                {
-                    queue[ready[currently_over]].context_switch++;
-                    queue[ready[current]].context_switch++;
-                }
-            }
-        }
-
-        // If the current job has already been completed, finds the next arrived that job that has not been completed.
-        else if(queue[ready[current]].status == 2)
-        {
-
-            // Loop to find the next job that has arrived and has not been completed.
-            while(queue[ready[current]].status != 1)
-            {
-                current++;
-
-                if(current >= arrived)  // Exits loop if none could be found.
-                {
-                    current = 0;
-                    break;
-                }
-            }
-        }  
-        time_clock++;   // Increments time.
+        struct Results_Writer writer;
+
+        Results_Create(&writer, results_path, FIFO_queue, NO_OF_JOBS);
+        Results_Add(&writer, policy_names[0], FIFO_queue, &FIFO_summary);
+        Results_Add(&writer, policy_names[1], SJF_queue, &SJF_summary);
+        Results_Add(&writer, policy_names[2], STCF_queue, &STCF_summary);
+        Results_Add(&writer, policy_names[3], RR1_queue, &RR1_summary);
+        Results_Add(&writer, policy_names[4], RR2_queue, &RR2_summary);
+        Results_Close(&writer);
+        return;
     }
 
-}
-
-
-
-/****************************************************************************************************
- * Function Name: RR()
- * Arguments: queue - An array of type structure Job used to contains job details.
- *            fin - File containing job arrival time and job size.
- *            quantum_size - Integer variable that specifies the length of the time slice.
- * Description: Function to impletement Round Robin (RR) scheduling algorithm. 
- * **************************************************************************************************/
-
-void RR(struct Job *queue, FILE *fin, int quantum_size)
-{
-    fseek(fin, 0, SEEK_SET);        // Sets the cursor to the beginning of the file.
-
-    int arrived = 0;                    // Number of jobs that have arrived.
-    int completed = 0;                  // Keeps track of the number of jobs completed.
-    int current;                        // Keeps track of the job being run.
-    int currently_over = 0;             // Keeps track of the job whose time slice currently ended.
-    int time_clock = 0;                 // Time clock variable used to keep track of time.
-    int time_slice = quantum_size;      // Time variable use to keep track of time left in the time slice.
-
-
-    int ready[NO_OF_JOBS];              // Array to store the job number of the jobs that have arrived.
-
-    // Initializes the 'ready' array with -1.
-    for(current = 0; current < NO_OF_JOBS; current++) {
-        ready[current] = -1;
-    }
+    // Writes job details to the output file in csv format.
+    fprintf(fout, ",Job Details,,,,,,FIFO,,,,,,,,SJF,,,,,,,,STCF(30),,,,,,,,RR(30),,,,,,,,RR(75)\n");
+    fprintf(fout, ",,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d,, ,Avg Repsonse:,%.2f,Avg Turnaround:,%.2f,Total Context Switches:,%d\n",
+    FIFO_summary.avg_response, FIFO_summary.avg_turnaround, FIFO_summary.total_context_switches,
+    SJF_summary.avg_response, SJF_summary.avg_turnaround, SJF_summary.total_context_switches,
+    STCF_summary.avg_response, STCF_summary.avg_turnaround, STCF_summary.total_context_switches,
+    RR1_summary.avg_response, RR1_summary.avg_turnaround, RR1_summary.total_context_switches,
+    RR2_summary.avg_response, RR2_summary.avg_turnaround, RR2_summary.total_context_switches);
+    fprintf(fout, ",,, ,Switch Overhead:,%.2f%%,CPU Time:,%.2f,,,, ,Switch Overhead:,%.2f%%,CPU Time:,%.2f,,,, ,Switch Overhead:,%.2f%%,CPU Time:,%.2f,,,,, ,Switch Overhead:,%.2f%%,CPU Time:,%.2f,,,, ,Switch Overhead:,%.2f%%,CPU Time:,%.2f\n",
+    100 * FIFO_summary.overhead / FIFO_summary.cpu_time, FIFO_summary.cpu_time, 100 * SJF_summary.overhead / SJF_summary.cpu_time,
+    SJF_summary.cpu_time, 100 * STCF_summary.overhead / STCF_summary.cpu_time, STCF_summary.cpu_time,
+    100 * RR1_summary.overhead / RR1_summary.cpu_time, RR1_summary.cpu_time, 100 * RR2_summary.overhead / RR2_summary.cpu_time,
+    RR2_summary.cpu_time);
+    fprintf(fout,"Job No,Arrival Time,Job Size, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time, ,Start Time,Time Left,Status,Context Switches,End Time,Response Time,Turnaround Time\n");
 
-    // Loop to read the job runtime and arrival time and populate the array.
-    for(current = 0; current < NO_OF_JOBS; current++)
+    for(i = 0; i < NO_OF_JOBS; i++)
     {
-        fscanf(fin, "%f,%f", &queue[current].size, &queue[current].arrival_time);
-        queue[current].job_no = current;
-        queue[current].status = 0;
-        queue[current].context_switch = 0;
-        queue[current].time_left = queue[current].size;
+        fprintf(fout,"%d,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f,,%.2f,%.2f,%d,%d,%.2f,%.2f,%.2f\n",
+        FIFO_queue[i].job_no, FIFO_queue[i].arrival_time, FIFO_queue[i].size,
+        FIFO_queue[i].start_time, FIFO_queue[i].time_left, FIFO_queue[i].status, FIFO_queue[i].context_switch, FIFO_queue[i].end_time, FIFO_queue[i].response_time, FIFO_queue[i].turnaround,
+        SJF_queue[i].start_time, SJF_queue[i].time_left, SJF_queue[i].status, SJF_queue[i].context_switch, SJF_queue[i].end_time, SJF_queue[i].response_time, SJF_queue[i].turnaround,
+        STCF_queue[i].start_time, STCF_queue[i].time_left, STCF_queue[i].status, STCF_queue[i].context_switch, STCF_queue[i].end_time, STCF_queue[i].response_time, STCF_queue[i].turnaround,
+        RR1_queue[i].start_time, RR1_queue[i].time_left, RR1_queue[i].status, RR1_queue[i].context_switch, RR1_queue[i].end_time, RR1_queue[i].response_time, RR1_queue[i].turnaround,
+        RR2_queue[i].start_time, RR2_queue[i].time_left, RR2_queue[i].status, RR2_queue[i].context_switch, RR2_queue[i].end_time, RR2_queue[i].response_time, RR2_queue[i].turnaround);
     }
 
-    current = 0;
-
-    // Loops until all jobs are completed.
-    while(completed < NO_OF_JOBS)
-    {   
-        // Loop to check which jobs have arrived. If the arrival time of the job in the array at the index 'arrived' is less
-        // than or equal to the time clock, then the status of the job is set to 1 and the value at the index 'arrived' of 
-        // the 'ready' array is set to 'arrived'. The variable 'arrived' is then incremented.
-        while (arrived < NO_OF_JOBS && queue[arrived].status == 0 && queue[arrived].arrival_time <= time_clock)
-        {
-            queue[arrived].status = 1;
-            ready[arrived] = arrived;        
-            arrived++;
-        }
-
-        // If the job is running.
-        if(ready[current] >= 0 && queue[ready[current]].status == 1)
-        {
-            // If the job has started running for the first time.
-            if(queue[ready[current]].time_left == queue[ready[current]].size)
-            {
-                queue[ready[current]].start_time = time_clock;
-                queue[ready[current]].context_switch = queue[ready[current]].context_switch + 1;
-                queue[ready[current]].response_time =  queue[ready[current]].start_time - queue[ready[current]].arrival_time;
-            }
-            
-            // If the job has ended.
-            if(queue[ready[current]].time_left <= 0)
-            {
-                queue[ready[current]].time_left = 0.0;
-                queue[ready[current]].end_time = time_clock;
-                queue[ready[current]].status = 2;
-                queue[ready[current]].turnaround = queue[ready[current]].end_time - queue[ready[current]].arrival_time;
-                
-                completed++;
-                current++;                  // Next job.
-                time_slice = quantum_size;  // Resets time slice.
-
-            }
-
-            // If the job is running.
-            else
-            {
-                queue[ready[current]].time_left--;  // Decrements current job's time left.
-                time_slice--;                       // Decrements time slice.
-            }
-
-            // If the time slice is over.
-            if(time_slice == 0)
-            {
-                currently_over = current;   // Stores 'current' value in 'currently_over'.
-                time_slice = quantum_size;  // Resets time slice.
-                current++;
-
-                // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
-                if(current >= arrived) {
-                    current = 0;
-                }
-
-                // Loop to find the next job that has arrived and has not been completed.
-                while(queue[ready[current]].status != 1)
-                {
-                    current++;
-                    
-                    // Exits loop if none could be found.
-                    if(current == currently_over) {
-                        break;
-                    }
-                    // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
-                    if(current >= arrived) {
-                        current = 0;
-                    }
-                }
-
-                // If a context switch happens.
-                if(current != currently_over)
-                {
-                    queue[ready[currently_over]].context_switch++;
-                    queue[ready[current]].context_switch++;
-                }
-            }
-        }
-
-        // If the current job has already been completed, finds the next arrived that job that has not been completed.
-        else if(queue[ready[current]].status == 2)
-        {
-            current++;
-
-            // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.
-            if(current >= arrived) {
-                current = 0;
-            }
-            currently_over = current;
-
-            // Loop to find the next job that has arrived and has not been completed.
-            while(queue[ready[current]].status != 1)
-            {
-                current++;
-
-                // Exits loop if none could be found.
-                if(current == currently_over) {
-                    break;
-                }
-                // If 'current' exceeds the number of arrived jobs, then sets 'current' to the beginning of the array.           
-                if(current >= arrived) {
-                    current = 0;
-                }
-            }
-        }     
-        time_clock++;   // Increments time.
-    }
+    // Resets the arrays.
+    memset(FIFO_queue, 0, sizeof(FIFO_queue));
+    memset(SJF_queue, 0, sizeof(SJF_queue));
+    memset(STCF_queue, 0, sizeof(STCF_queue));
+    memset(RR1_queue, 0, sizeof(RR1_queue));
+    memset(RR2_queue, 0, sizeof(RR2_queue));
 }
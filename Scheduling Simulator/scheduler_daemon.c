@@ -0,0 +1,510 @@
+/*******************************************************************************************************************************
+ * Scheduler Daemon
+ *
+ * Name: scheduler_daemon.c
+ *
+ * Purpose: Runs one of the scheduling algorithms, FIFO, SJF, STCF or RR, as a dispatch component. The daemon listens on a Unix
+ *          domain socket for job arrival, job completion and quantum expiry messages and replies to each one with the job
+ *          that should run on the CPU next. The time taken to make every decision is recorded, and the median (p50) and 99th
+ *          percentile (p99) decision latency are sent to clients that ask for them and printed when the daemon is stopped.
+ *          As in scheduler.c, STCF only re-evaluates the job to run when its pre-emption time slice expires.
+ *
+ * Usage: ./scheduler_daemon <FIFO|SJF|STCF|RR> [quantum_size] [socket_path]
+ *  quantum_size - Length of the time slice for STCF and RR. Default = 30.
+ *  socket_path - Path of the Unix domain socket. Default = /tmp/scheduler_daemon.sock.
+ *  (./scheduler_daemon RR 75)
+ *  The daemon serves one client at a time and runs until it receives SIGINT or SIGTERM.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	The message formats are defined in scheduler_daemon.h.
+ * 	(gcc -O2 scheduler_daemon.c -o scheduler_daemon)
+ *
+*******************************************************************************************************************************/
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "scheduler_daemon.h"
+
+#define FIFO_POLICY 0
+#define SJF_POLICY 1
+#define STCF_POLICY 2
+#define RR_POLICY 3
+
+#define LATENCY_BUCKETS 1024    // Number of buckets in the decision latency histogram.
+
+// Structure contains the details of a job waiting for or running on the CPU.
+struct Entry
+{
+    long long job_no;
+    double remaining;       // Time the job still needs on the CPU.
+    long long seq;          // Order in which the job entered the ready queue. Breaks ties between equal jobs.
+};
+
+int policy = FIFO_POLICY;       // Scheduling algorithm used by the daemon. Global variable.
+float quantum_size = 30;        // Length of the time slice for STCF and RR. Global variable.
+
+// Ready queue. Used as a ring buffer by FIFO and RR, and as a binary min-heap on the remaining time by SJF and STCF.
+struct Entry *ready = NULL;
+int ready_capacity = 0;
+int ready_head = 0;
+int ready_count = 0;
+long long next_seq = 0;
+
+struct Entry running;           // Job on the CPU.
+int cpu_busy = 0;               // 1 if a job is on the CPU, else 0.
+double dispatch_time = 0;       // Time at which the running job was put on the CPU.
+
+// Log-linear histogram of decision latencies in nanoseconds, with 16 sub-buckets per power of two.
+unsigned long long latency[LATENCY_BUCKETS];
+long long decisions = 0;
+unsigned long long max_latency = 0;
+
+volatile sig_atomic_t stop = 0;     // Set by the signal handler to stop the daemon.
+
+void Push(struct Entry entry);
+int Pop(struct Entry *entry);
+void Decide(const struct Request *request, struct Decision *decision);
+void Record_Latency(unsigned long long ns);
+double Latency_Percentile(double p);
+void Get_Stats(struct Stats *stats);
+int Read_Full(int fd, void *buf, size_t len);
+int Write_Full(int fd, const void *buf, size_t len);
+void Stop_Handler(int sig);
+
+
+int main(int argc, char *argv[])
+{
+    const char *path = DAEMON_SOCKET;
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    struct Stats stats;
+    int server, client;
+
+    // Reads the scheduling algorithm, quantum size and socket path from the command line.
+    if(argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <FIFO|SJF|STCF|RR> [quantum_size] [socket_path]\n", argv[0]);
+        exit(-1);
+    }
+    if(strcmp(argv[1], "FIFO") == 0) {
+        policy = FIFO_POLICY;
+    }
+    else if(strcmp(argv[1], "SJF") == 0) {
+        policy = SJF_POLICY;
+    }
+    else if(strcmp(argv[1], "STCF") == 0) {
+        policy = STCF_POLICY;
+    }
+    else if(strcmp(argv[1], "RR") == 0) {
+        policy = RR_POLICY;
+    }
+    else
+    {
+        fprintf(stderr, "Error! Unknown scheduling algorithm: %s\n", argv[1]);
+        exit(-1);
+    }
+    if(argc > 2) {
+        quantum_size = atof(argv[2]);
+    }
+    if(argc > 3) {
+        path = argv[3];
+    }
+    if(quantum_size <= 0)
+    {
+        fprintf(stderr, "Error! The quantum size must be positive.\n");
+        exit(-1);
+    }
+
+    // Stops the daemon on SIGINT and SIGTERM. SA_RESTART is not set so that blocking calls return with EINTR.
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = Stop_Handler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Creates the socket and binds it to the path.
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server < 0)
+    {
+        perror("Error! Cannot create socket!");
+        exit(-1);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    unlink(path);
+    if(bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(server, 1) < 0)
+    {
+        perror("Error! Cannot listen on socket!");
+        exit(-1);
+    }
+    printf("Scheduler daemon (%s) listening on %s\n", argv[1], path);
+    fflush(stdout);
+
+    // Serves one client at a time until the daemon is stopped.
+    while(!stop)
+    {
+        client = accept(server, NULL, NULL);
+        if(client < 0) {
+            continue;
+        }
+
+        // Each client starts with an empty ready queue and an idle CPU.
+        ready_head = 0;
+        ready_count = 0;
+        cpu_busy = 0;
+
+        // Loop to answer the client's requests until it disconnects.
+        while(!stop)
+        {
+            struct Request request;
+            struct Decision decision;
+            struct timespec t0, t1;
+
+            if(!Read_Full(client, &request, sizeof(request))) {
+                break;
+            }
+
+            if(request.type == MSG_STATS)
+            {
+                Get_Stats(&stats);
+                if(!Write_Full(client, &stats, sizeof(stats))) {
+                    break;
+                }
+                continue;
+            }
+
+            // Times the decision and records its latency.
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            Decide(&request, &decision);
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            Record_Latency((unsigned long long)((t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec)));
+
+            if(!Write_Full(client, &decision, sizeof(decision))) {
+                break;
+            }
+        }
+        close(client);
+    }
+
+    close(server);
+    unlink(path);
+
+    // Prints the decision latency statistics.
+    Get_Stats(&stats);
+    printf("Decisions: %lld\nLatency p50: %.0f ns\nLatency p99: %.0f ns\nLatency max: %.0f ns\n", stats.decisions, stats.p50,
+    stats.p99, stats.max);
+
+    free(ready);
+    exit(0);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Push()
+ * Arguments: entry - Job to add to the ready queue.
+ * Description: Function to add a job to the ready queue. FIFO and RR append it to the tail of the ring
+ *              buffer, while SJF and STCF sift it up the heap ordered on the remaining time.
+ * *************************************************************************************************/
+void Push(struct Entry entry)
+{
+    int i, parent;
+
+    // Doubles the capacity of the ready queue when it is full.
+    if(ready_count == ready_capacity)
+    {
+        int capacity = ready_capacity ? 2 * ready_capacity : 1024;
+        struct Entry *grown = malloc(capacity * sizeof(struct Entry));
+
+        if(!grown)
+        {
+            perror("Error! Cannot grow the ready queue!");
+            exit(-1);
+        }
+
+        // Copies the entries in queue order so that the ring buffer starts at index 0.
+        for(i = 0; i < ready_count; i++) {
+            grown[i] = ready[(ready_head + i) % ready_capacity];
+        }
+        free(ready);
+        ready = grown;
+        ready_capacity = capacity;
+        ready_head = 0;
+    }
+
+    if(policy == FIFO_POLICY || policy == RR_POLICY)
+    {
+        ready[(ready_head + ready_count) % ready_capacity] = entry;
+        ready_count++;
+        return;
+    }
+
+    // Sifts the entry up the heap.
+    i = ready_count++;
+    while(i > 0)
+    {
+        parent = (i - 1) / 2;
+        if(ready[parent].remaining < entry.remaining ||
+           (ready[parent].remaining == entry.remaining && ready[parent].seq < entry.seq)) {
+            break;
+        }
+        ready[i] = ready[parent];
+        i = parent;
+    }
+    ready[i] = entry;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Pop()
+ * Arguments: entry - Used to return the job taken off the ready queue.
+ * Description: Function to take the next job off the ready queue. Returns 0 if the queue is empty, else 1.
+ * *************************************************************************************************/
+int Pop(struct Entry *entry)
+{
+    int i, child;
+    struct Entry last;
+
+    if(ready_count == 0) {
+        return 0;
+    }
+
+    if(policy == FIFO_POLICY || policy == RR_POLICY)
+    {
+        *entry = ready[ready_head];
+        ready_head = (ready_head + 1) % ready_capacity;
+        ready_count--;
+        return 1;
+    }
+
+    // Takes the root of the heap and sifts the last entry down from the root.
+    *entry = ready[0];
+    last = ready[--ready_count];
+    i = 0;
+    while((child = 2 * i + 1) < ready_count)
+    {
+        if(child + 1 < ready_count && (ready[child + 1].remaining < ready[child].remaining ||
+           (ready[child + 1].remaining == ready[child].remaining && ready[child + 1].seq < ready[child].seq))) {
+            child++;
+        }
+        if(last.remaining < ready[child].remaining || (last.remaining == ready[child].remaining && last.seq < ready[child].seq)) {
+            break;
+        }
+        ready[i] = ready[child];
+        i = child;
+    }
+    ready[i] = last;
+    return 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Decide()
+ * Arguments: request - Event received from the client.
+ *            decision - Used to return the job that should run on the CPU.
+ * Description: Function to apply an event to the ready queue and decide which job runs next. An
+ *              expired job goes back to the ready queue with the time it has left, so RR puts it at
+ *              the tail and STCF picks the job with the least time left.
+ * *************************************************************************************************/
+void Decide(const struct Request *request, struct Decision *decision)
+{
+    struct Entry entry;
+    long long expired = -1;     // Job whose quantum expired, -1 if none.
+
+    switch(request->type)
+    {
+        case MSG_ARRIVAL:
+            entry.job_no = request->job_no;
+            entry.remaining = request->size;
+            entry.seq = next_seq++;
+            Push(entry);
+            break;
+
+        case MSG_COMPLETE:
+            if(cpu_busy && running.job_no == request->job_no) {
+                cpu_busy = 0;
+            }
+            break;
+
+        case MSG_EXPIRE:
+            if(cpu_busy && running.job_no == request->job_no && policy != FIFO_POLICY && policy != SJF_POLICY)
+            {
+                running.remaining -= request->time - dispatch_time;
+                running.seq = next_seq++;
+                expired = running.job_no;
+                Push(running);
+                cpu_busy = 0;
+            }
+            break;
+
+        case MSG_RESET:
+            ready_head = 0;
+            ready_count = 0;
+            cpu_busy = 0;
+            break;
+    }
+
+    // Puts the next job on the CPU if it is idle.
+    if(!cpu_busy && Pop(&running))
+    {
+        cpu_busy = 1;
+        dispatch_time = request->time;
+    }
+
+    decision->job_no = cpu_busy ? running.job_no : -1;
+    decision->preempted = (expired != decision->job_no) ? expired : -1;
+    decision->quantum = (policy == STCF_POLICY || policy == RR_POLICY) ? quantum_size : 0;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Record_Latency()
+ * Arguments: ns - Time taken by a decision in nanoseconds.
+ * Description: Function to add a decision latency to the histogram. Values below 16 ns get a bucket
+ *              each, and larger values are split into 16 buckets per power of two.
+ * *************************************************************************************************/
+void Record_Latency(unsigned long long ns)
+{
+    int bucket = (int)ns;
+
+    if(ns >= 16)
+    {
+        int e = 63 - __builtin_clzll(ns);
+        bucket = (e - 3) * 16 + (int)((ns >> (e - 4)) & 15);
+    }
+    latency[bucket]++;
+    decisions++;
+    if(ns > max_latency) {
+        max_latency = ns;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Latency_Percentile()
+ * Arguments: p - Percentile between 0 and 1.
+ * Description: Function to find the decision latency at the given percentile. Returns the middle of
+ *              the histogram bucket containing the percentile in nanoseconds.
+ * *************************************************************************************************/
+double Latency_Percentile(double p)
+{
+    long long target = (long long)(p * decisions);
+    long long seen = 0;
+    int bucket;
+
+    for(bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+    {
+        seen += latency[bucket];
+        if(seen > target) {
+            break;
+        }
+    }
+    if(bucket >= LATENCY_BUCKETS) {
+        return (double)max_latency;
+    }
+    if(bucket < 16) {
+        return bucket;
+    }
+
+    // Converts the bucket back to the range of latencies it holds.
+    int e = bucket / 16 + 3;
+    double low = (double)(1ULL << e) + (double)(bucket % 16) * (double)(1ULL << (e - 4));
+    return low + (double)(1ULL << (e - 4)) / 2;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Get_Stats()
+ * Arguments: stats - Used to return the decision latency statistics.
+ * Description: Function to collect the number of decisions and the p50, p99 and maximum latency.
+ * *************************************************************************************************/
+void Get_Stats(struct Stats *stats)
+{
+    stats->decisions = decisions;
+    stats->p50 = Latency_Percentile(0.50);
+    stats->p99 = Latency_Percentile(0.99);
+    stats->max = (double)max_latency;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Read_Full()
+ * Arguments: fd - Socket to read from.
+ *            buf - Buffer to read into.
+ *            len - Number of bytes to read.
+ * Description: Function to read exactly len bytes. Returns 0 if the client disconnected or the daemon
+ *              was stopped, else 1.
+ * *************************************************************************************************/
+int Read_Full(int fd, void *buf, size_t len)
+{
+    char *p = buf;
+
+    while(len > 0)
+    {
+        ssize_t n = read(fd, p, len);
+        if(n < 0 && errno == EINTR && !stop) {
+            continue;
+        }
+        if(n <= 0) {
+            return 0;
+        }
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Write_Full()
+ * Arguments: fd - Socket to write to.
+ *            buf - Buffer to write from.
+ *            len - Number of bytes to write.
+ * Description: Function to write exactly len bytes. Returns 0 on error, else 1.
+ * *************************************************************************************************/
+int Write_Full(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+
+    while(len > 0)
+    {
+        ssize_t n = write(fd, p, len);
+        if(n < 0 && errno == EINTR && !stop) {
+            continue;
+        }
+        if(n <= 0) {
+            return 0;
+        }
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Stop_Handler()
+ * Arguments: sig - Signal received.
+ * Description: Signal handler to stop the daemon.
+ * *************************************************************************************************/
+void Stop_Handler(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************************************************************
+ * Scheduler Daemon Protocol
+ *
+ * Name: scheduler_daemon.h
+ *
+ * Purpose: Message formats shared by the scheduler daemon and the load generator. Every request is answered with exactly
+ *          one reply on the same Unix domain stream socket: a Decision for job messages and a Stats for statistics requests.
+ *
+*******************************************************************************************************************************/
+#ifndef SCHEDULER_DAEMON_H
+#define SCHEDULER_DAEMON_H
+
+#define DAEMON_SOCKET "/tmp/scheduler_daemon.sock"     // Default path of the daemon's socket.
+
+// Request types.
+#define MSG_ARRIVAL 1       // A job has arrived.
+#define MSG_COMPLETE 2      // The running job has completed.
+#define MSG_EXPIRE 3        // The running job's quantum has expired.
+#define MSG_STATS 4         // Asks for the decision latency statistics.
+#define MSG_RESET 5         // Empties the ready queue.
+
+// Request sent to the daemon.
+struct Request
+{
+    int type;
+    long long job_no;       // Job the event belongs to. 64 bits, so a trace can be replayed for as long as needed.
+    float size;             // Job size. Only used by MSG_ARRIVAL.
+    double time;            // Time at which the event happened.
+};
+
+// Dispatch decision sent back for MSG_ARRIVAL, MSG_COMPLETE, MSG_EXPIRE and MSG_RESET.
+struct Decision
+{
+    long long job_no;       // Job to run on the CPU, -1 if the CPU is idle.
+    long long preempted;    // Job taken off the CPU by this decision, -1 if none.
+    float quantum;          // Time the job may run before it has to be expired, 0 if it runs to completion.
+};
+
+// Decision latency statistics sent back for MSG_STATS. Latencies are in nanoseconds.
+struct Stats
+{
+    long long decisions;
+    double p50;
+    double p99;
+    double max;
+};
+
+#endif
@@ -0,0 +1,277 @@
+/*******************************************************************************************************************************
+ * Metrics Snapshots
+ *
+ * Name: snapshot.c
+ *
+ * Purpose: Implements the stream of metrics snapshots declared in snapshot.h. The snapshots are written to a file or named
+ *          pipe opened by Snapshots_Open(), one line at a time, so a reader sees each snapshot as soon as it is written.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+
+static int Bucket(float time);
+static double Bucket_Time(int bucket);
+static double Percentile(const uint32_t *count, long long total, double q);
+static void Write_Times(FILE *fout, const char *name, const uint32_t *count, long long total, double sum);
+static void Write_String(FILE *fout, const char *s);
+
+
+
+/***************************************************************************************************
+ * Function Name: Snapshots_Open()
+ * Arguments: snapshots - The stream of snapshots.
+ *            path - Name of the file or named pipe to write the snapshots to. Opening a named pipe
+ *                   waits until a reader has opened it.
+ *            interval - Ticks of simulated time between snapshots.
+ * Description: Function to open a stream of snapshots. The program exits with an error message if the
+ *              file cannot be opened.
+ * *************************************************************************************************/
+
+void Snapshots_Open(struct Snapshots *snapshots, const char *path, uint64_t interval)
+{
+    memset(snapshots, 0, sizeof(*snapshots));
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!(snapshots->fout = fopen(path, "w")))
+    {
+        perror("Error! Cannot open the snapshot file");
+        exit(-1);
+    }
+
+    // Each snapshot is written out as soon as its line is complete.
+    setvbuf(snapshots->fout, NULL, _IOLBF, 0);
+    snapshots->interval = (interval > 0) ? interval : 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Snapshots_Close()
+ * Arguments: snapshots - The stream of snapshots.
+ * Description: Function to close a stream of snapshots.
+ * *************************************************************************************************/
+
+void Snapshots_Close(struct Snapshots *snapshots)
+{
+    fclose(snapshots->fout);
+    snapshots->fout = NULL;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Snapshots_Start()
+ * Arguments: snapshots - The stream of snapshots.
+ *            policy - Name of the scheduling algorithm.
+ *            time_slice - Length of the algorithm's time slice, or 0 if it has none.
+ *            n - Number of jobs in the run.
+ * Description: Function to clear the metrics at the start of a scheduling algorithm's run.
+ * *************************************************************************************************/
+
+void Snapshots_Start(struct Snapshots *snapshots, const char *policy, int time_slice, int n)
+{
+    if(time_slice > 0) {
+        snprintf(snapshots->policy, sizeof(snapshots->policy), "%s(%d)", policy, time_slice);
+    }
+    else {
+        snprintf(snapshots->policy, sizeof(snapshots->policy), "%s", policy);
+    }
+
+    snapshots->jobs = n;
+    snapshots->recorded = 0;
+    snapshots->response_sum = 0;
+    snapshots->turnaround_sum = 0;
+    snapshots->end = 0;
+    memset(snapshots->response, 0, sizeof(snapshots->response));
+    memset(snapshots->turnaround, 0, sizeof(snapshots->turnaround));
+    snapshots->events = 0;
+    clock_gettime(CLOCK_MONOTONIC, &snapshots->last);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Snapshots_Record()
+ * Arguments: snapshots - The stream of snapshots.
+ *            job - A job that has just been completed.
+ * Description: Function to add a completed job's response and turnaround time to the metrics.
+ * *************************************************************************************************/
+
+void Snapshots_Record(struct Snapshots *snapshots, const struct Job *job)
+{
+    snapshots->recorded++;
+    snapshots->response_sum += job->response_time;
+    snapshots->turnaround_sum += job->turnaround;
+    if(job->end_time > snapshots->end) {
+        snapshots->end = job->end_time;
+    }
+    snapshots->response[Bucket(job->response_time)]++;
+    snapshots->turnaround[Bucket(job->turnaround)]++;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Snapshots_Write()
+ * Arguments: snapshots - The stream of snapshots.
+ *            clock - The simulated time.
+ *            completed - Number of jobs completed.
+ *            queue - Number of jobs that have arrived and are not completed.
+ *            events - Number of events simulated since the start of the run.
+ *            final - 1 for the last snapshot of the run, else 0.
+ * Description: Function to write one snapshot of the metrics as a line of JSON. The events per second
+ *              are counted from the previous snapshot.
+ * *************************************************************************************************/
+
+void Snapshots_Write(struct Snapshots *snapshots, uint64_t clock, int completed, int queue, long long events, int final)
+{
+    FILE *fout = snapshots->fout;
+    struct timespec now;
+    double elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed = (now.tv_sec - snapshots->last.tv_sec) + (now.tv_nsec - snapshots->last.tv_nsec) / 1e9;
+
+    fprintf(fout, "{\"run\":");
+    Write_String(fout, snapshots->run);
+    fprintf(fout, ",\"policy\":");
+    Write_String(fout, snapshots->policy);
+    fprintf(fout, ",\"final\":%s,\"clock\":%llu,\"jobs\":%d,\"completed\":%d,\"queue\":%d", final ? "true" : "false",
+            (unsigned long long)clock, snapshots->jobs, completed, queue);
+    Write_Times(fout, "response", snapshots->response, snapshots->recorded, snapshots->response_sum);
+    Write_Times(fout, "turnaround", snapshots->turnaround, snapshots->recorded, snapshots->turnaround_sum);
+    fprintf(fout, ",\"events\":%lld,\"events_per_sec\":%.0f}\n", events,
+            (elapsed > 0) ? (events - snapshots->events) / elapsed : 0);
+
+    snapshots->events = events;
+    snapshots->last = now;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Bucket()
+ * Arguments: time - A response or turnaround time, not negative.
+ * Description: Function to return the histogram bucket of a time. The buckets split the range of
+ *              time + 1 between each power of 2 and the next into SNAPSHOT_SUB_BUCKETS equal parts,
+ *              which are the top bits of its mantissa.
+ * *************************************************************************************************/
+
+static int Bucket(float time)
+{
+    float x = (time > 0) ? time + 1 : 1;
+    uint32_t bits;
+    int bucket;
+
+    memcpy(&bits, &x, sizeof(bits));
+    bucket = (int)(bits >> (23 - SNAPSHOT_SUB_BITS)) - (127 << SNAPSHOT_SUB_BITS);
+    return (bucket < SNAPSHOT_BUCKETS) ? bucket : SNAPSHOT_BUCKETS - 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Bucket_Time()
+ * Arguments: bucket - A histogram bucket.
+ * Description: Function to return the time in the middle of a bucket.
+ * *************************************************************************************************/
+
+static double Bucket_Time(int bucket)
+{
+    uint32_t bits = (uint32_t)(bucket + (127 << SNAPSHOT_SUB_BITS)) << (23 - SNAPSHOT_SUB_BITS);
+    float low;
+
+    memcpy(&low, &bits, sizeof(low));
+    return low * (1 + 0.5 / SNAPSHOT_SUB_BUCKETS) - 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Percentile()
+ * Arguments: count - A histogram of times.
+ *            total - Number of times in the histogram.
+ *            q - The quantile, from 0 to 1.
+ * Description: Function to return the time below which a fraction q of the times fall, or 0 if the
+ *              histogram is empty.
+ * *************************************************************************************************/
+
+static double Percentile(const uint32_t *count, long long total, double q)
+{
+    long long rank = (long long)(q * total);    // Number of times before the one returned.
+    long long seen = 0;
+    int bucket;
+
+    if(total == 0) {
+        return 0;
+    }
+    if(rank >= total) {
+        rank = total - 1;
+    }
+
+    for(bucket = 0; bucket < SNAPSHOT_BUCKETS - 1; bucket++)
+    {
+        seen += count[bucket];
+        if(seen > rank) {
+            break;
+        }
+    }
+    return Bucket_Time(bucket);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Write_Times()
+ * Arguments: fout - File the snapshot is written to.
+ *            name - Name of the metric.
+ *            count - Histogram of the metric.
+ *            total - Number of times in the histogram.
+ *            sum - Sum of the times.
+ * Description: Function to write the mean and percentiles of a metric as a JSON object.
+ * *************************************************************************************************/
+
+static void Write_Times(FILE *fout, const char *name, const uint32_t *count, long long total, double sum)
+{
+    fprintf(fout, ",\"%s\":{\"mean\":%.2f,\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f}", name, (total > 0) ? sum / total : 0,
+            Percentile(count, total, 0.5), Percentile(count, total, 0.9), Percentile(count, total, 0.99));
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Write_String()
+ * Arguments: fout - File the snapshot is written to.
+ *            s - The string, or NULL.
+ * Description: Function to write a string as a JSON string, or null.
+ * *************************************************************************************************/
+
+static void Write_String(FILE *fout, const char *s)
+{
+    if(!s)
+    {
+        fputs("null", fout);
+        return;
+    }
+
+    fputc('"', fout);
+    for(; *s; s++)
+    {
+        if(*s == '"' || *s == '\\') {
+            fprintf(fout, "\\%c", *s);
+        }
+        else if((unsigned char)*s < 0x20) {
+            fprintf(fout, "\\u%04x", (unsigned char)*s);
+        }
+        else {
+            fputc(*s, fout);
+        }
+    }
+    fputc('"', fout);
+}
@@ -0,0 +1,64 @@
+/*******************************************************************************************************************************
+ * Metrics Snapshots
+ *
+ * Name: snapshot.h
+ *
+ * Purpose: A stream of metrics snapshots written while the scheduling algorithms run, one JSON object per line, so a long
+ *          simulation can be followed with tail -f or read from a named pipe (FIFO) by a dashboard. The scheduler engine
+ *          writes a snapshot of the running algorithm every 'interval' ticks of simulated time, and a last one, marked final,
+ *          when every job is completed. Each line holds the run and algorithm, the simulated clock, the number of jobs
+ *          completed and waiting, the mean and 50th, 90th and 99th percentiles of the response and turnaround time of the
+ *          completed jobs, and the number of simulator events (arrivals, ends of time slices and completions) per second.
+ *          The percentiles come from fixed histograms of logarithmically spaced buckets, SNAPSHOT_SUB_BUCKETS to each power
+ *          of 2, so each is within 1/(2 * SNAPSHOT_SUB_BUCKETS) of its value plus one tick. Recording a completed job
+ *          costs a few instructions and a snapshot costs one pass over the buckets, and nothing is allocated once the
+ *          stream is open, however many jobs are simulated.
+ *          A snapshot looks like this (on one line):
+ *              {"run":"job_runtime_1.csv","policy":"FIFO","final":false,"clock":100000,"jobs":5000,"completed":658,
+ *               "queue":666,"response":{"mean":25066.65,"p50":25025.00,"p90":45407.00,"p99":49535.00},
+ *               "turnaround":{"mean":25217.33,"p50":25025.00,"p90":45407.00,"p99":49535.00},"events":1982,
+ *               "events_per_sec":2349527}
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile snapshot.c together with the program and the scheduler engine.
+ *
+*******************************************************************************************************************************/
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "sched_engine.h"
+
+#define SNAPSHOT_SUB_BITS 6                                 // Each power of 2 is split into 2^SNAPSHOT_SUB_BITS buckets.
+#define SNAPSHOT_SUB_BUCKETS (1 << SNAPSHOT_SUB_BITS)
+#define SNAPSHOT_BUCKETS (40 * SNAPSHOT_SUB_BUCKETS)         // Times up to 2^40 ticks, larger ones in the last bucket.
+#define SNAPSHOT_INTERVAL 100000                            // Default ticks of simulated time between snapshots.
+
+// Structure contains a stream of metrics snapshots.
+struct Snapshots
+{
+    FILE *fout;
+    uint64_t interval;                      // Ticks of simulated time between snapshots.
+    const char *run;                        // Name of the run, such as the input file, set by the caller. May be NULL.
+    char policy[16];                        // Name of the scheduling algorithm running.
+    int jobs;                               // Number of jobs in the run.
+    long long recorded;                     // Number of completed jobs recorded.
+    double response_sum;
+    double turnaround_sum;
+    float end;                              // Time the last recorded job was completed.
+    uint32_t response[SNAPSHOT_BUCKETS];    // Histograms of the response and turnaround time of the completed jobs.
+    uint32_t turnaround[SNAPSHOT_BUCKETS];
+    long long events;                       // Number of events at the last snapshot.
+    struct timespec last;                   // Time of the last snapshot, or of the start of the run.
+};
+
+void Snapshots_Open(struct Snapshots *snapshots, const char *path, uint64_t interval);
+void Snapshots_Close(struct Snapshots *snapshots);
+void Snapshots_Start(struct Snapshots *snapshots, const char *policy, int time_slice, int n);
+void Snapshots_Record(struct Snapshots *snapshots, const struct Job *job);
+void Snapshots_Write(struct Snapshots *snapshots, uint64_t clock, int completed, int queue, long long events, int final);
+
+#endif
@@ -0,0 +1,248 @@
+/*******************************************************************************************************************************
+ * Steady State Detection
+ *
+ * Name: steady_state.c
+ *
+ * Purpose: Implements the MSER-5 warm-up truncation and the batch means stopping rule declared in steady_state.h.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Include the -lm option at compile time.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "steady_state.h"
+
+static void Steady_Test(struct Steady_State *steady, int final);
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Open()
+ * Arguments: steady - The steady state detection.
+ *            precision - Relative half-width of the confidence interval of the mean turnaround time
+ *                        at which a run stops, such as 0.05.
+ * Description: Function to set up steady state detection for the runs that follow.
+ * *************************************************************************************************/
+
+void Steady_Open(struct Steady_State *steady, double precision)
+{
+    memset(steady, 0, sizeof(*steady));
+    steady->precision = precision;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Close()
+ * Arguments: steady - The steady state detection.
+ * Description: Function to free the memory of the steady state detection.
+ * *************************************************************************************************/
+
+void Steady_Close(struct Steady_State *steady)
+{
+    free(steady->response);
+    free(steady->turnaround);
+    free(steady->end);
+    steady->response = NULL;
+    steady->turnaround = NULL;
+    steady->end = NULL;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Start()
+ * Arguments: steady - The steady state detection.
+ *            n - Number of jobs in the run.
+ * Description: Function to clear the detection at the start of a scheduling algorithm's run, making
+ *              room for the group means of n jobs.
+ * *************************************************************************************************/
+
+void Steady_Start(struct Steady_State *steady, int n)
+{
+    if(n > steady->jobs || !steady->response)
+    {
+        free(steady->response);
+        free(steady->turnaround);
+        free(steady->end);
+        steady->response = malloc((n / MSER_BATCH + 1) * sizeof(double));
+        steady->turnaround = malloc((n / MSER_BATCH + 1) * sizeof(double));
+        steady->end = malloc((n / MSER_BATCH + 1) * sizeof(double));
+
+        // Prints an error message and exits the program if the memory cannot be allocated.
+        if(!(steady->response && steady->turnaround && steady->end))
+        {
+            perror("Error! Cannot allocate memory!");
+            exit(-1);
+        }
+    }
+
+    steady->jobs = n;
+    steady->recorded = 0;
+    steady->clock = 0;
+    steady->next_test = STEADY_MIN_JOBS;
+    steady->response_sum = 0;
+    steady->turnaround_sum = 0;
+    steady->reached = 0;
+    steady->warmup = 0;
+    steady->measured = 0;
+    steady->mean_response = 0;
+    steady->mean_turnaround = 0;
+    steady->half_width = -1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Record()
+ * Arguments: steady - The steady state detection.
+ *            job - A job that has just been completed.
+ * Description: Function to add a completed job to its group, and to test for steady state when the
+ *              number of completions reaches the next test.
+ * *************************************************************************************************/
+
+void Steady_Record(struct Steady_State *steady, const struct Job *job)
+{
+    int gap;
+
+    steady->response_sum += job->response_time;
+    steady->turnaround_sum += job->turnaround;
+    steady->clock = job->end_time;
+    steady->recorded++;
+
+    if(steady->recorded % MSER_BATCH == 0)
+    {
+        steady->response[steady->recorded / MSER_BATCH - 1] = steady->response_sum / MSER_BATCH;
+        steady->turnaround[steady->recorded / MSER_BATCH - 1] = steady->turnaround_sum / MSER_BATCH;
+        steady->end[steady->recorded / MSER_BATCH - 1] = job->end_time;
+        steady->response_sum = 0;
+        steady->turnaround_sum = 0;
+    }
+
+    if(steady->recorded >= steady->next_test)
+    {
+        Steady_Test(steady, 0);
+
+        // Tests again after a tenth more completions, and at least enough for one more job per batch.
+        gap = steady->recorded / 10;
+        if(gap < MSER_BATCH * STEADY_BATCHES) {
+            gap = MSER_BATCH * STEADY_BATCHES;
+        }
+        steady->next_test = steady->recorded + gap;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Finish()
+ * Arguments: steady - The steady state detection.
+ * Description: Function to set the estimates at the end of a run. A run that has stopped keeps the
+ *              estimates of its last test; one that has completed every job is tested once more.
+ * *************************************************************************************************/
+
+void Steady_Finish(struct Steady_State *steady)
+{
+    if(!steady->reached) {
+        Steady_Test(steady, 1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Steady_Test()
+ * Arguments: steady - The steady state detection.
+ *            final - 1 at the end of a run, else 0.
+ * Description: Function to find the warm-up by MSER-5, set the averages of the jobs after it, and
+ *              set 'reached' if the batch means confidence interval of the mean turnaround time is
+ *              within the precision. At the end of a run whose output is still drifting, or is too
+ *              short to test, the averages are taken over every job.
+ * *************************************************************************************************/
+
+static void Steady_Test(struct Steady_State *steady, int final)
+{
+    int k = steady->recorded / MSER_BATCH;      // Number of full groups.
+    int d, best = 0, size, b, j;
+    double sum = 0, square = 0, mser, best_mser = HUGE_VAL;
+    double batch[STEADY_BATCHES], grand = 0, variance = 0, lag = 0;
+    double response = steady->response_sum, turnaround = steady->turnaround_sum, span;
+    int drifting = 0;
+
+    // MSER-5, over the truncation points that leave at least one group per batch.
+    if(k >= 2 * STEADY_BATCHES)
+    {
+        for(d = k - 1; d >= 0; d--)
+        {
+            sum += steady->turnaround[d];
+            square += steady->turnaround[d] * steady->turnaround[d];
+            if(d <= k - STEADY_BATCHES)
+            {
+                mser = (square - sum * sum / (k - d)) / ((double)(k - d) * (k - d));
+                if(mser <= best_mser)
+                {
+                    best_mser = mser;
+                    best = d;
+                }
+            }
+        }
+        drifting = (best > k / 2);
+    }
+    if(k < 2 * STEADY_BATCHES || drifting)
+    {
+        if(!final) {
+            return;
+        }
+        best = 0;
+    }
+
+    // Averages of the jobs after the warm-up, with the group being filled.
+    for(j = best; j < k; j++)
+    {
+        response += steady->response[j] * MSER_BATCH;
+        turnaround += steady->turnaround[j] * MSER_BATCH;
+    }
+    steady->warmup = best * MSER_BATCH;
+    steady->measured = steady->recorded - steady->warmup;
+    steady->mean_response = (steady->measured > 0) ? response / steady->measured : 0;
+    steady->mean_turnaround = (steady->measured > 0) ? turnaround / steady->measured : 0;
+    steady->half_width = -1;
+
+    if(k - best < STEADY_BATCHES) {
+        return;
+    }
+
+    // Batch means of the groups after the warm-up.
+    size = (k - best) / STEADY_BATCHES;
+    for(b = 0; b < STEADY_BATCHES; b++)
+    {
+        batch[b] = 0;
+        for(j = best + b * size; j < best + (b + 1) * size; j++) {
+            batch[b] += steady->turnaround[j];
+        }
+        batch[b] /= size;
+        grand += batch[b];
+    }
+    grand /= STEADY_BATCHES;
+
+    for(b = 0; b < STEADY_BATCHES; b++)
+    {
+        variance += (batch[b] - grand) * (batch[b] - grand);
+        if(b > 0) {
+            lag += (batch[b] - grand) * (batch[b - 1] - grand);
+        }
+    }
+    lag = (variance > 0) ? lag / variance : 0;
+    variance /= STEADY_BATCHES - 1;
+
+    if(steady->mean_turnaround > 0) {
+        steady->half_width = STEADY_T * sqrt(variance / STEADY_BATCHES) / steady->mean_turnaround;
+    }
+    span = steady->clock - (best > 0 ? steady->end[best - 1] : 0);
+    steady->reached = !drifting && steady->measured >= STEADY_MIN_JOBS && span >= STEADY_SPAN * steady->mean_turnaround &&
+                      steady->half_width >= 0 && steady->half_width <= steady->precision && lag < STEADY_MAX_LAG;
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************************************************************
+ * Steady State Detection
+ *
+ * Name: steady_state.h
+ *
+ * Purpose: Stops a run of a scheduling algorithm once its average turnaround time is known to a requested relative
+ *          precision, and leaves the start-up transient out of the averages. Every run starts from an empty system, so the
+ *          first jobs wait less than they would in steady state, and a long run of a stable workload keeps simulating long
+ *          after its averages have settled.
+ *          The turnaround times of the completed jobs, in the order they are completed, are kept as the means of groups of
+ *          MSER_BATCH jobs. The warm-up is found by MSER-5: of the truncation points d (in groups), the one that minimizes
+ *              MSER(d) = sum over j > d of (Z_j - mean of Z after d)^2 / (k - d)^2
+ *          over the k group means Z_j, that is the variance of the mean that is left, traded off against the jobs that are
+ *          kept. If the minimum lies in the second half of the groups, the output is still drifting (as it does while a
+ *          queue grows without bound), and the run goes on. Otherwise the groups after the warm-up are split into
+ *          STEADY_BATCHES batches of equal size, and the 95% confidence interval of the mean turnaround time is
+ *              mean +/- STEADY_T * sd of the batch means / sqrt(STEADY_BATCHES)
+ *          The run stops once its half-width is at most the precision times the mean and the batch means are not strongly
+ *          correlated (lag-1 autocorrelation below STEADY_MAX_LAG, else the batches are too short to be independent), as
+ *          long as at least STEADY_MIN_JOBS jobs are measured after the warm-up and they were completed over at least
+ *          STEADY_SPAN times their mean turnaround time. By Little's law the last keeps the jobs left waiting few next to
+ *          the jobs measured, so an algorithm that completes the short jobs on time while it starves the long ones does
+ *          not look settled. The test is made after STEADY_MIN_JOBS completions and then every tenth more, so it costs
+ *          O(k) at O(log n) points of the run.
+ *          The average response time is taken over the same jobs. Jobs still waiting or running when the run stops are not
+ *          counted, which favours policies that hold back long jobs, such as SJF, a little more than a full run does. If
+ *          the precision is never reached, every job is completed and the averages are those of the jobs after the
+ *          warm-up.
+ *          Like the snapshots, steady state detection is turned on by setting the global 'steady' of the scheduler engine.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile steady_state.c together with the program and the scheduler engine.
+ *
+*******************************************************************************************************************************/
+#ifndef STEADY_STATE_H
+#define STEADY_STATE_H
+
+#include "sched_engine.h"
+
+#define MSER_BATCH 5            // Jobs per group of the MSER-5 warm-up test.
+#define STEADY_BATCHES 20       // Batches of the batch means confidence interval.
+#define STEADY_T 2.093          // t quantile for a 95% interval with STEADY_BATCHES - 1 degrees of freedom.
+#define STEADY_MAX_LAG 0.2      // Largest lag-1 autocorrelation of the batch means taken as independent.
+#define STEADY_MIN_JOBS 1000    // Completions before the first test, and least number of jobs measured.
+#define STEADY_SPAN 10          // Least time the measured jobs are completed over, in mean turnaround times.
+
+// Structure contains the steady state detection of one run of a scheduling algorithm.
+struct Steady_State
+{
+    double precision;           // Relative half-width of the confidence interval to stop at.
+    int jobs;                   // Number of jobs in the run.
+    int recorded;               // Number of completed jobs recorded.
+    double clock;               // Time the last recorded job was completed.
+    int next_test;              // Number of completions at which the next test is made.
+    double *response;           // Mean response and turnaround time of each full group of MSER_BATCH completions.
+    double *turnaround;
+    double *end;                // Time the last job of each full group was completed.
+    double response_sum;        // Sums of the group being filled.
+    double turnaround_sum;
+    int reached;                // 1 once the precision is reached and the run can stop, else 0.
+    // Estimates, set by each test and at the end of the run.
+    int warmup;                 // Completed jobs left out as the warm-up.
+    int measured;               // Completed jobs the averages are taken over.
+    double mean_response;
+    double mean_turnaround;
+    double half_width;          // Relative half-width of the confidence interval of the mean turnaround time.
+};
+
+void Steady_Open(struct Steady_State *steady, double precision);
+void Steady_Close(struct Steady_State *steady);
+void Steady_Start(struct Steady_State *steady, int n);
+void Steady_Record(struct Steady_State *steady, const struct Job *job);
+void Steady_Finish(struct Steady_State *steady);
+
+#endif
@@ -0,0 +1,313 @@
+/*******************************************************************************************************************************
+ * Timer Wheel
+ *
+ * Name: timer_wheel.c
+ *
+ * Purpose: Implements the hierarchical timing wheel declared in timer_wheel.h. A timer waiting in level l agrees with the
+ *          current time in every digit above l and has a digit l no lower than the current time's, so the slots of each
+ *          level that are in use all lie ahead of the current time, in the order of their numbers, and the lowest level in
+ *          use holds the next timers to fire.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <stddef.h>
+#include "timer_wheel.h"
+
+static void Link(struct Timer_Wheel *wheel, struct Timer *timer);
+static void Unlink(struct Timer_Wheel *wheel, struct Timer *timer);
+static uint64_t Slot_Time(const struct Timer_Wheel *wheel, int level, int slot);
+static int Lowest_Level(const struct Timer_Wheel *wheel);
+
+
+
+/***************************************************************************************************
+ * Function Name: Wheel_Init()
+ * Arguments: wheel - The timing wheel.
+ *            start - First tick to be run.
+ * Description: Function to set up an empty timing wheel starting at the given tick.
+ * *************************************************************************************************/
+
+void Wheel_Init(struct Timer_Wheel *wheel, uint64_t start)
+{
+    int level, slot;
+
+    wheel->now = start;
+    wheel->pending = 0;
+    wheel->due = WHEEL_NEVER;
+    wheel->levels = 0;
+    for(level = 0; level < WHEEL_LEVELS; level++)
+    {
+        wheel->used[level] = 0;
+        for(slot = 0; slot < WHEEL_SIZE; slot++)
+        {
+            wheel->slot[level][slot].first = NULL;
+            wheel->slot[level][slot].last = NULL;
+        }
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Timer_Init()
+ * Arguments: timer - The timer.
+ *            data - Caller's data passed back with the timer when it fires.
+ * Description: Function to set up a timer that is not waiting in any wheel.
+ * *************************************************************************************************/
+
+void Timer_Init(struct Timer *timer, void *data)
+{
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->expires = 0;
+    timer->level = -1;
+    timer->slot = 0;
+    timer->data = data;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Wheel_Add()
+ * Arguments: wheel - The timing wheel.
+ *            timer - The timer, set up by Timer_Init().
+ *            expires - Tick at which the timer fires.
+ * Description: Function to start a timer. A timer that is already waiting is moved to the new expiry
+ *              time, and a time that has already been run is taken as the next tick to be run.
+ * *************************************************************************************************/
+
+void Wheel_Add(struct Timer_Wheel *wheel, struct Timer *timer, uint64_t expires)
+{
+    if(Timer_Pending(timer)) {
+        Wheel_Cancel(wheel, timer);
+    }
+    timer->expires = (expires > wheel->now) ? expires : wheel->now;
+    Link(wheel, timer);
+    wheel->pending++;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Wheel_Cancel()
+ * Arguments: wheel - The timing wheel.
+ *            timer - The timer.
+ * Description: Function to stop a timer so that it does not fire. Nothing is done if the timer is not
+ *              waiting.
+ * *************************************************************************************************/
+
+void Wheel_Cancel(struct Timer_Wheel *wheel, struct Timer *timer)
+{
+    if(Timer_Pending(timer))
+    {
+        Unlink(wheel, timer);
+        timer->level = -1;
+        wheel->pending--;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Wheel_Run()
+ * Arguments: wheel - The timing wheel.
+ *            time - Last tick to be run.
+ *            fire - Function called for each timer that fires.
+ *            context - Passed to fire with each timer.
+ * Description: Function to run the wheel up to and including the given tick. Every timer expiring by
+ *              then fires, in order of expiry time, and the slots of the higher levels reached on the
+ *              way are moved down. The time jumps from one slot in use to the next, so idle ticks cost
+ *              nothing. A timer may be added or cancelled by fire, and one added for a tick already
+ *              reached fires in the same call. Called through Wheel_Advance().
+ * *************************************************************************************************/
+
+void Wheel_Run(struct Timer_Wheel *wheel, uint64_t time, Timer_Function fire, void *context)
+{
+    int level, slot;
+    uint64_t next;
+
+    wheel->due = WHEEL_NEVER;
+    while((level = Lowest_Level(wheel)) >= 0)
+    {
+        slot = __builtin_ctzll(wheel->used[level]);
+        next = Slot_Time(wheel, level, slot);
+
+        // A higher level slot starting at the next tick is moved down now, so that the lowest level in use always holds
+        // the next timers to fire.
+        if(next > time && !(level > 0 && next == time + 1))
+        {
+            wheel->due = (level > 0) ? next - 1 : next;
+            break;
+        }
+        wheel->now = next;
+
+        // Fires the timers of a slot of the lowest level, which all expire now, or moves the timers of a slot of a higher
+        // level down to the levels below it.
+        while(wheel->slot[level][slot].first)
+        {
+            struct Timer *timer = wheel->slot[level][slot].first;
+
+            Unlink(wheel, timer);
+            if(level == 0)
+            {
+                timer->level = -1;
+                wheel->pending--;
+                fire(timer, context);
+            }
+            else {
+                Link(wheel, timer);
+            }
+        }
+    }
+
+    if(time >= wheel->now) {
+        wheel->now = time + 1;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Wheel_Next()
+ * Arguments: wheel - The timing wheel.
+ * Description: Function to find the tick at which the next timer fires. Returns WHEEL_NEVER if no
+ *              timer is waiting. The timers of a higher level slot are searched for the earliest
+ *              one, so the cost is at most the number of timers in that slot.
+ * *************************************************************************************************/
+
+uint64_t Wheel_Next(const struct Timer_Wheel *wheel)
+{
+    int level = Lowest_Level(wheel);
+    int slot;
+    const struct Timer *timer;
+    uint64_t next;
+
+    if(level < 0) {
+        return WHEEL_NEVER;
+    }
+    slot = __builtin_ctzll(wheel->used[level]);
+    if(level == 0) {
+        return Slot_Time(wheel, 0, slot);
+    }
+
+    next = WHEEL_NEVER;
+    for(timer = wheel->slot[level][slot].first; timer; timer = timer->next)
+    {
+        if(timer->expires < next) {
+            next = timer->expires;
+        }
+    }
+    return next;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Link()
+ * Arguments: wheel - The timing wheel.
+ *            timer - The timer, with its expiry time set.
+ * Description: Function to append the timer to the slot for its expiry time. The level is the
+ *              highest digit in which the expiry time differs from the current time.
+ * *************************************************************************************************/
+
+static void Link(struct Timer_Wheel *wheel, struct Timer *timer)
+{
+    uint64_t differ = timer->expires ^ wheel->now;
+    int level = differ ? (63 - __builtin_clzll(differ)) / WHEEL_BITS : 0;
+    int slot = (timer->expires >> (level * WHEEL_BITS)) & (WHEEL_SIZE - 1);
+    struct Timer_Slot *list = &wheel->slot[level][slot];
+    uint64_t due;
+
+    timer->level = level;
+    timer->slot = slot;
+    timer->next = NULL;
+    timer->prev = list->last;
+
+    if(list->last) {
+        list->last->next = timer;
+    }
+    else {
+        list->first = timer;
+    }
+    list->last = timer;
+    wheel->used[level] |= 1ULL << slot;
+    wheel->levels |= 1u << level;
+
+    // A higher level slot is moved down when the tick before it is run.
+    due = Slot_Time(wheel, level, slot) - (level > 0);
+    if(due < wheel->due) {
+        wheel->due = due;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Unlink()
+ * Arguments: wheel - The timing wheel.
+ *            timer - A waiting timer.
+ * Description: Function to take the timer out of its slot, marking the slot free if it is left empty.
+ * *************************************************************************************************/
+
+static void Unlink(struct Timer_Wheel *wheel, struct Timer *timer)
+{
+    struct Timer_Slot *list = &wheel->slot[timer->level][timer->slot];
+
+    if(timer->prev) {
+        timer->prev->next = timer->next;
+    }
+    else {
+        list->first = timer->next;
+    }
+    if(timer->next) {
+        timer->next->prev = timer->prev;
+    }
+    else {
+        list->last = timer->prev;
+    }
+
+    // The next tick with a timer due is left as it is, since running the wheel then just finds nothing to do.
+    if(!list->first)
+    {
+        wheel->used[timer->level] &= ~(1ULL << timer->slot);
+        if(!wheel->used[timer->level]) {
+            wheel->levels &= ~(1u << timer->level);
+        }
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Slot_Time()
+ * Arguments: wheel - The timing wheel.
+ *            level - Level of the slot.
+ *            slot - Number of the slot.
+ * Description: Function to return the first tick covered by a slot in use. It is the current time
+ *              with digit 'level' set to the slot and the digits below it cleared.
+ * *************************************************************************************************/
+
+static uint64_t Slot_Time(const struct Timer_Wheel *wheel, int level, int slot)
+{
+    int shift = (level + 1) * WHEEL_BITS;
+    uint64_t above = (shift < 64) ? wheel->now >> shift << shift : 0;
+
+    return above | ((uint64_t)slot << (level * WHEEL_BITS));
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Lowest_Level()
+ * Arguments: wheel - The timing wheel.
+ * Description: Function to return the lowest level with a slot in use, or -1 if no timer is waiting.
+ * *************************************************************************************************/
+
+static int Lowest_Level(const struct Timer_Wheel *wheel)
+{
+    return wheel->levels ? __builtin_ctz(wheel->levels) : -1;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************************************************************
+ * Timer Wheel
+ *
+ * Name: timer_wheel.h
+ *
+ * Purpose: A hierarchical timing wheel holding the timers of the scheduling algorithms: job arrivals, quantum expiries and
+ *          any other event due at a later tick, such as a deadline check. Level l of the wheel has WHEEL_SIZE slots, each
+ *          WHEEL_SIZE^l ticks wide, and a timer is kept in the level of the highest base-WHEEL_SIZE digit in which its
+ *          expiry differs from the current time. When the time reaches a slot of a higher level, its timers are moved down,
+ *          so each timer is moved at most once per level, WHEEL_LEVELS times in all, however many timers are waiting.
+ *          Timers are linked into their slot, so adding and cancelling a timer are O(1), and a bitmap of the slots in use
+ *          at each level finds the next slot to expire in O(WHEEL_LEVELS) steps without stepping through the empty ones.
+ *          The wheel can therefore jump straight over idle time. Timers that expire at the same tick fire in the order
+ *          they were added.
+ *          Source: G. Varghese and T. Lauck, "Hashed and Hierarchical Timing Wheels: Data Structures for the Efficient
+ *          Implementation of a Timer Facility", Proceedings of the 11th ACM Symposium on Operating Systems Principles, 1987.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Compile timer_wheel.c together with the program.
+ *
+*******************************************************************************************************************************/
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+#define WHEEL_BITS 6                    // Each level has 2^WHEEL_BITS slots.
+#define WHEEL_SIZE (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 11                 // Enough levels for every 64-bit expiry time.
+#define WHEEL_NEVER UINT64_MAX          // Returned by Wheel_Next() when no timer is waiting.
+
+// Structure contains a timer. It is owned by the caller and linked into the wheel while it is waiting.
+struct Timer
+{
+    struct Timer *next;
+    struct Timer *prev;
+    uint64_t expires;       // Tick at which the timer fires.
+    int level;              // Level and slot of the wheel the timer is in, level -1 if it is not waiting.
+    int slot;
+    void *data;             // Caller's data, passed to the Timer_Function with the timer.
+};
+
+// Structure contains the list of timers in one slot.
+struct Timer_Slot
+{
+    struct Timer *first;
+    struct Timer *last;
+};
+
+// Structure contains a timing wheel.
+struct Timer_Wheel
+{
+    uint64_t now;                                       // Next tick to be run. Every timer before it has fired.
+    long pending;                                       // Number of timers waiting.
+    uint64_t due;                                       // No timer has to fire or move down before this tick is run.
+    unsigned levels;                                    // Bitmap of the levels holding timers.
+    uint64_t used[WHEEL_LEVELS];                        // Bitmap of the slots holding timers at each level.
+    struct Timer_Slot slot[WHEEL_LEVELS][WHEEL_SIZE];
+};
+
+// Function called for each timer that fires, with the context given to Wheel_Advance().
+typedef void (*Timer_Function)(struct Timer *timer, void *context);
+
+void Wheel_Init(struct Timer_Wheel *wheel, uint64_t start);
+void Timer_Init(struct Timer *timer, void *data);
+void Wheel_Add(struct Timer_Wheel *wheel, struct Timer *timer, uint64_t expires);
+void Wheel_Cancel(struct Timer_Wheel *wheel, struct Timer *timer);
+void Wheel_Run(struct Timer_Wheel *wheel, uint64_t time, Timer_Function fire, void *context);
+uint64_t Wheel_Next(const struct Timer_Wheel *wheel);
+
+// Runs the wheel up to and including the given tick, firing the timers due by then. Returns at once when no timer is due,
+// so it can be called on every tick.
+static inline void Wheel_Advance(struct Timer_Wheel *wheel, uint64_t time, Timer_Function fire, void *context)
+{
+    if(time < wheel->due)
+    {
+        if(time >= wheel->now) {
+            wheel->now = time + 1;
+        }
+        return;
+    }
+    Wheel_Run(wheel, time, fire, context);
+}
+
+// Returns 1 if the timer is waiting in a wheel, else 0.
+static inline int Timer_Pending(const struct Timer *timer)
+{
+    return timer->level >= 0;
+}
+
+#endif
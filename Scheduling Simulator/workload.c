@@ -0,0 +1,751 @@
+/*******************************************************************************************************************************
+ * Workload Specification
+ *
+ * Name: workload.c
+ *
+ * Purpose: Reads the workload files described in workload.h and generates the jobs of a workload. Each job is assigned to a
+ *          component by one uniform number, and the sizes of each component are then drawn in one batch, so the batch
+ *          samplers from sampling.h do the bulk of the work.
+ *          Quasi-random jobs take a point of a three-dimensional Sobol sequence each, for the component, the job size and
+ *          the time between arrivals, which are turned into values by their inverse distribution functions. The points are
+ *          handed to the jobs in a random order, since consecutive points of the sequence are far from independent and
+ *          would make short and long gaps alternate.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ *
+*******************************************************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "workload.h"
+#include "../Number Generators/sampling.h"
+#include "../Number Generators/arrival.h"
+#include "../Number Generators/sobol.h"
+
+// Built-in mixtures of job_generator.c, in the workload file format.
+static const char *default_workloads[NO_OF_MIXTURES] = {
+    "jobs 5000\narrival normal 75 20\ncomponent normal 150 20 1\n",
+    "jobs 5000\narrival normal 75 20\ncomponent normal 250 15 0.2\ncomponent normal 50 10 0.8\n",
+    "jobs 5000\narrival normal 75 20\ncomponent normal 250 15 0.8\ncomponent normal 50 10 0.2\n"
+};
+
+static int Parse_Distribution(const char *text, struct Distribution *dist, int *used);
+static int Parse_Arrival(const char *text, struct Arrival *arrival);
+static void Fill_Distribution(struct Rng *rng, const struct Distribution *dist, double *out, int n);
+static void Generate_Arrivals(struct Rng *rng, const struct Workload *workload, double *arrival);
+static double Invert_Distribution(const struct Distribution *dist, double u);
+static void Distribution_Moments(const struct Distribution *dist, double *mean, double *m2);
+static void *Allocate(size_t size);
+
+
+
+/***************************************************************************************************
+ * Function Name: Read_Workload()
+ * Arguments: fin - The workload file.
+ *            name - Name of the file, only used in error messages.
+ *            workload - Structure to return the workload in.
+ * Description: Function to read a workload from the file, fin. The program exits with an error
+ *              message if the file is not a valid workload.
+ * *************************************************************************************************/
+
+void Read_Workload(FILE *fin, const char *name, struct Workload *workload)
+{
+    char line[256];
+    char key[32];
+    int line_no = 0;
+    int used = 0;
+    int has_arrival = 0;
+    struct Component *component;
+
+    memset(workload, 0, sizeof(*workload));
+
+    while(fgets(line, sizeof(line), fin))
+    {
+        line_no++;
+
+        // Skips blank lines and comments.
+        if(sscanf(line, "%31s%n", key, &used) != 1 || key[0] == '#') {
+            continue;
+        }
+
+        if(strcmp(key, "jobs") == 0)
+        {
+            if(sscanf(line + used, "%d", &workload->jobs) != 1 || workload->jobs < 1)
+            {
+                fprintf(stderr, "Error! %s:%d: The number of jobs must be positive.\n", name, line_no);
+                exit(-1);
+            }
+        }
+        else if(strcmp(key, "arrival") == 0)
+        {
+            if(!Parse_Arrival(line + used, &workload->arrival))
+            {
+                fprintf(stderr, "Error! %s:%d: Invalid arrival process or distribution.\n", name, line_no);
+                exit(-1);
+            }
+            has_arrival = 1;
+        }
+        else if(strcmp(key, "component") == 0)
+        {
+            int length = 0;
+
+            if(workload->components == MAX_COMPONENTS)
+            {
+                fprintf(stderr, "Error! %s:%d: More than %d components.\n", name, line_no, MAX_COMPONENTS);
+                exit(-1);
+            }
+            component = &workload->component[workload->components];
+            if(!Parse_Distribution(line + used, &component->size, &length) ||
+               sscanf(line + used + length, "%lf", &component->weight) != 1 || component->weight <= 0)
+            {
+                fprintf(stderr, "Error! %s:%d: Invalid component. (component <distribution> <parameters> <weight>)\n",
+                        name, line_no);
+                exit(-1);
+            }
+            workload->components++;
+        }
+        else
+        {
+            fprintf(stderr, "Error! %s:%d: Unknown item \"%s\".\n", name, line_no, key);
+            exit(-1);
+        }
+    }
+
+    if(workload->jobs == 0 || workload->components == 0 || !has_arrival)
+    {
+        fprintf(stderr, "Error! %s: A workload needs the number of jobs, an arrival process and a component.\n", name);
+        exit(-1);
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Load_Workload()
+ * Arguments: path - Name of the workload file.
+ *            workload - Structure to return the workload in.
+ * Description: Function to read a workload from the file at path.
+ * *************************************************************************************************/
+
+void Load_Workload(const char *path, struct Workload *workload)
+{
+    FILE *fin = fopen(path, "r");
+
+    // Prints an error message and exits the program if the file cannot be opened.
+    if(!fin)
+    {
+        perror("Error! Cannot open workload file!");
+        exit(-1);
+    }
+    Read_Workload(fin, path, workload);
+    fclose(fin);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Default_Workload()
+ * Arguments: mixture - 0, 1 or 2.
+ *            workload - Structure to return the workload in.
+ * Description: Function to return one of the three mixtures that job_generator.c generates when no
+ *              workload files are given.
+ * *************************************************************************************************/
+
+void Default_Workload(int mixture, struct Workload *workload)
+{
+    const char *text = default_workloads[mixture];
+    FILE *fin = fmemopen((void *)text, strlen(text), "r");
+
+    if(!fin)
+    {
+        perror("Error! Cannot read built-in workload!");
+        exit(-1);
+    }
+    Read_Workload(fin, "built-in workload", workload);
+    fclose(fin);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Describe_Workload()
+ * Arguments: fout - File to write to.
+ *            workload - The workload.
+ * Description: Function to write one line for each component of the workload, in the format:
+ *              weight, distribution.
+ * *************************************************************************************************/
+
+void Describe_Workload(FILE *fout, const struct Workload *workload)
+{
+    static const char *names[] = {"Guassian", "Uniform", "Exponential", "Constant"};
+    double total = 0;
+    int k;
+
+    for(k = 0; k < workload->components; k++) {
+        total += workload->component[k].weight;
+    }
+    for(k = 0; k < workload->components; k++)
+    {
+        const struct Distribution *size = &workload->component[k].size;
+
+        fprintf(fout, "%.0f%%,%s", 100 * workload->component[k].weight / total, names[size->type]);
+        switch(size->type)
+        {
+            case DIST_NORMAL: fprintf(fout, ",Mean: %g, SD: %g\n", size->a, size->b); break;
+            case DIST_UNIFORM: fprintf(fout, ",Low: %g, High: %g\n", size->a, size->b); break;
+            case DIST_EXPONENTIAL: fprintf(fout, ",Mean: %g\n", size->a); break;
+            default: fprintf(fout, ",Value: %g\n", size->a); break;
+        }
+    }
+
+    switch(workload->arrival.process)
+    {
+        case ARRIVAL_POISSON: fprintf(fout, "Arrivals,Poisson,Utilization: %g\n", workload->arrival.utilization); break;
+        case ARRIVAL_MMPP:
+            fprintf(fout, "Arrivals,MMPP,Utilization: %g, States: %d\n", workload->arrival.utilization,
+                    workload->arrival.mmpp.states);
+            break;
+        case ARRIVAL_DIURNAL:
+            fprintf(fout, "Arrivals,Diurnal,Utilization: %g, Amplitude: %g, Period: %g\n", workload->arrival.utilization,
+                    workload->arrival.amplitude, workload->arrival.period);
+            break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Mean_Size()
+ * Arguments: workload - The workload.
+ * Description: Function to return the mean job size of the workload.
+ * *************************************************************************************************/
+
+double Mean_Size(const struct Workload *workload)
+{
+    double total = 0, mean = 0;
+    int k;
+
+    for(k = 0; k < workload->components; k++)
+    {
+        const struct Distribution *size = &workload->component[k].size;
+        double weight = workload->component[k].weight;
+
+        total += weight;
+        mean += weight * ((size->type == DIST_UNIFORM) ? (size->a + size->b) / 2 : size->a);
+    }
+    return mean / total;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Workload_Moments()
+ * Arguments: workload - The workload.
+ *            moments - Structure to return the moments in.
+ * Description: Function to work out the moments of the workload's jobs for the analytic estimates
+ *              of queueing.h. The time between arrivals of an MMPP is given the asymptotic index of
+ *              dispersion of its counts as its SCV. With the uniform moves between states of
+ *              arrival.h, the states are visited in proportion to their durations d[i], and the
+ *              index is 1 + 2 (k - 1) / k * sum over states of p[i] d[i] (rate[i] - mean rate)^2 /
+ *              mean rate, for k states.
+ * *************************************************************************************************/
+
+void Workload_Moments(const struct Workload *workload, struct Moments *moments)
+{
+    const struct Arrival *process = &workload->arrival;
+    const struct Mmpp *mmpp = &process->mmpp;
+    double total = 0, mean, m2, scale, time = 0, spread = 0;
+    int k;
+
+    moments->jobs = workload->jobs;
+    moments->arrival_scv = 1;
+    moments->amplitude = 0;
+    moments->period = 0;
+    moments->mean_size = 0;
+    moments->size_m2 = 0;
+
+    for(k = 0; k < workload->components; k++)
+    {
+        Distribution_Moments(&workload->component[k].size, &mean, &m2);
+        moments->mean_size += workload->component[k].weight * mean;
+        moments->size_m2 += workload->component[k].weight * m2;
+        total += workload->component[k].weight;
+    }
+    moments->mean_size /= total;
+    moments->size_m2 /= total;
+    moments->rate = process->utilization / moments->mean_size;
+
+    switch(process->process)
+    {
+        case ARRIVAL_POISSON:
+            break;
+
+        case ARRIVAL_MMPP:
+            // Scales the relative rates of the states to the required rate.
+            scale = moments->rate / mmpp_mean_rate(mmpp);
+            for(k = 0; k < mmpp->states; k++) {
+                time += mmpp->duration[k];
+            }
+            for(k = 0; k < mmpp->states; k++)
+            {
+                double difference = mmpp->rate[k] * scale - moments->rate;
+                spread += mmpp->duration[k] / time * mmpp->duration[k] * difference * difference;
+            }
+            moments->arrival_scv = 1 + 2.0 * (mmpp->states - 1) / mmpp->states * spread / moments->rate;
+            break;
+
+        case ARRIVAL_DIURNAL:
+            moments->amplitude = process->amplitude;
+            moments->period = process->period;
+            break;
+
+        default:
+            Distribution_Moments(&process->gap, &mean, &m2);
+            moments->rate = (mean > 0) ? 1 / mean : 0;
+            moments->arrival_scv = (mean > 0) ? m2 / (mean * mean) - 1 : 0;
+            break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Generate_Jobs()
+ * Arguments: rng - The random number generator.
+ *            workload - The workload.
+ *            size - Array of workload->jobs elements to return the job sizes in.
+ *            arrival - Array of workload->jobs elements to return the increasing arrival times in.
+ * Description: Function to generate the jobs of the workload. The size of job i is stored in
+ *              size[i] and its arrival time in arrival[i].
+ * *************************************************************************************************/
+
+void Generate_Jobs(struct Rng *rng, const struct Workload *workload, double *size, double *arrival)
+{
+    int n = workload->jobs;
+    int *choice = Allocate(n * sizeof(int));           // Component of each job.
+    double *samples = Allocate(n * sizeof(double));    // Job sizes, grouped by component.
+    double cumulative[MAX_COMPONENTS];                 // Upper end of each component's share of [0, 1).
+    int count[MAX_COMPONENTS] = {0};                   // Number of jobs in each component.
+    int next[MAX_COMPONENTS];                          // Index in samples[] of each component's next job size.
+    double total = 0;
+    int i, k;
+
+    for(k = 0; k < workload->components; k++)
+    {
+        total += workload->component[k].weight;
+        cumulative[k] = total;
+    }
+
+    // Assigns each job to a component. A single component needs no random numbers.
+    for(i = 0; i < n; i++)
+    {
+        double u = (workload->components > 1) ? rng_uniform(rng) * total : 0;
+
+        for(k = 0; k < workload->components - 1 && u >= cumulative[k]; k++);
+        choice[i] = k;
+        count[k]++;
+    }
+
+    // Generates the job sizes of each component in one batch.
+    for(i = 0, k = 0; k < workload->components; k++)
+    {
+        next[k] = i;
+        Fill_Distribution(rng, &workload->component[k].size, samples + i, count[k]);
+        i += count[k];
+    }
+
+    for(i = 0; i < n; i++) {
+        size[i] = samples[next[choice[i]]++];
+    }
+
+    Generate_Arrivals(rng, workload, arrival);
+
+    free(choice);
+    free(samples);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Generate_Quasi_Jobs()
+ * Arguments: rng - The random number generator.
+ *            scrambled - Owen scramble the points if not 0.
+ *            workload - The workload.
+ *            size - Array of workload->jobs elements to return the job sizes in.
+ *            arrival - Array of workload->jobs elements to return the increasing arrival times in.
+ * Description: Function to generate the sizes and arrival times of the workload's jobs like
+ *              Generate_Jobs(), from the points of a Sobol sequence instead of random numbers, so
+ *              the sizes and the times between arrivals follow their distributions much more
+ *              closely. If scrambled is not 0, the points are Owen scrambled with a seed drawn from
+ *              rng. rng also shuffles the points. Arrivals from an MMPP or with a daily cycle
+ *              depend on the state of the process and are still random.
+ * *************************************************************************************************/
+
+void Generate_Quasi_Jobs(struct Rng *rng, int scrambled, const struct Workload *workload, double *size, double *arrival)
+{
+    int n = workload->jobs;
+    double *points = Allocate(3 * (size_t)n * sizeof(double));     // Component, size and gap of each point.
+    int *order = Allocate(n * sizeof(int));                         // Point given to each job.
+    double cumulative[MAX_COMPONENTS];
+    double total = 0, clock = 0;
+    double rate = workload->arrival.utilization / Mean_Size(workload);
+    struct Sobol sobol;
+    struct Sobol_Stream stream;
+    int i, j, k;
+
+    for(k = 0; k < workload->components; k++)
+    {
+        total += workload->component[k].weight;
+        cumulative[k] = total;
+    }
+
+    sobol_setup(&sobol, 3, scrambled, rng_next(rng));
+    sobol_start(&stream, &sobol, 0);
+    sobol_fill_unit(&stream, points, 3 * (size_t)n);
+
+    // Shuffles the points with the Fisher-Yates shuffle.
+    for(i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    for(i = n - 1; i > 0; i--)
+    {
+        j = (int)rng_bounded(rng, i + 1);
+        k = order[i];
+        order[i] = order[j];
+        order[j] = k;
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        const double *u = points + 3 * (size_t)order[i];
+        double gap;
+
+        for(k = 0; k < workload->components - 1 && u[0] * total >= cumulative[k]; k++);
+        size[i] = Invert_Distribution(&workload->component[k].size, u[1]);
+
+        if(workload->arrival.process == ARRIVAL_GAPS) {
+            gap = Invert_Distribution(&workload->arrival.gap, u[2]);
+        }
+        else {
+            gap = -log1p(-u[2]) / rate;     // Exponential gaps of the Poisson process.
+        }
+        clock += (gap > 0) ? gap : 0;
+        arrival[i] = clock;
+    }
+
+    // The arrival times above are replaced for the processes that cannot be inverted.
+    if(workload->arrival.process == ARRIVAL_MMPP || workload->arrival.process == ARRIVAL_DIURNAL) {
+        Generate_Arrivals(rng, workload, arrival);
+    }
+
+    free(points);
+    free(order);
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Generate_Arrivals()
+ * Arguments: rng - The random number generator.
+ *            workload - The workload.
+ *            arrival - Array of workload->jobs elements to return the arrival times in.
+ * Description: Function to generate the arrival times of the workload's jobs. The processes are run
+ *              at the rate that gives the workload's utilization, which is the utilization divided
+ *              by the mean job size. Negative times between arrivals, which a normal distribution
+ *              can give, are taken as 0 so the arrival times never decrease.
+ * *************************************************************************************************/
+
+static void Generate_Arrivals(struct Rng *rng, const struct Workload *workload, double *arrival)
+{
+    const struct Arrival *process = &workload->arrival;
+    double rate = process->utilization / Mean_Size(workload);
+    double clock = 0;
+    struct Mmpp mmpp;
+    int i;
+
+    switch(process->process)
+    {
+        case ARRIVAL_POISSON:
+            fill_poisson_arrivals(rng, arrival, workload->jobs, rate);
+            break;
+
+        case ARRIVAL_MMPP:
+            // Scales the relative rates of the states so the long-run rate is the required rate.
+            mmpp = process->mmpp;
+            rate /= mmpp_mean_rate(&process->mmpp);
+            for(i = 0; i < mmpp.states; i++) {
+                mmpp.rate[i] *= rate;
+            }
+            fill_mmpp_arrivals(rng, arrival, workload->jobs, &mmpp);
+            break;
+
+        case ARRIVAL_DIURNAL:
+            fill_diurnal_arrivals(rng, arrival, workload->jobs, rate, process->amplitude, process->period);
+            break;
+
+        default:
+            // Generates the time between arrivals and adds it up to give the arrival times.
+            Fill_Distribution(rng, &process->gap, arrival, workload->jobs);
+            for(i = 0; i < workload->jobs; i++)
+            {
+                clock += (arrival[i] > 0) ? arrival[i] : 0;
+                arrival[i] = clock;
+            }
+            break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Parse_Arrival()
+ * Arguments: text - The rest of an arrival line.
+ *            arrival - Structure to return the arrival process in.
+ * Description: Function to read an arrival process and its parameters, or a distribution of the
+ *              time between arrivals, from text. Returns 1 if it is valid, else 0.
+ * *************************************************************************************************/
+
+static int Parse_Arrival(const char *text, struct Arrival *arrival)
+{
+    char type[32];
+    int length = 0;
+    int more = 0;
+
+    if(sscanf(text, "%31s%n", type, &length) != 1) {
+        return 0;
+    }
+
+    if(strcmp(type, "poisson") == 0) {
+        arrival->process = ARRIVAL_POISSON;
+    }
+    else if(strcmp(type, "mmpp") == 0) {
+        arrival->process = ARRIVAL_MMPP;
+    }
+    else if(strcmp(type, "diurnal") == 0) {
+        arrival->process = ARRIVAL_DIURNAL;
+    }
+    else
+    {
+        arrival->process = ARRIVAL_GAPS;
+        return Parse_Distribution(text, &arrival->gap, NULL);
+    }
+
+    text += length;
+    if(sscanf(text, "%lf%n", &arrival->utilization, &more) != 1 || arrival->utilization <= 0) {
+        return 0;
+    }
+    text += more;
+
+    if(arrival->process == ARRIVAL_MMPP)
+    {
+        struct Mmpp *mmpp = &arrival->mmpp;
+        double total = 0;
+        char left;
+
+        // Reads pairs of relative rate and mean duration until the end of the line, up to MAX_STATES of them.
+        for(mmpp->states = 0; mmpp->states < MAX_STATES &&
+            sscanf(text, "%lf %lf%n", &mmpp->rate[mmpp->states], &mmpp->duration[mmpp->states], &more) == 2; text += more)
+        {
+            if(mmpp->rate[mmpp->states] < 0 || mmpp->duration[mmpp->states] <= 0) {
+                return 0;
+            }
+            total += mmpp->rate[mmpp->states];
+            mmpp->states++;
+        }
+
+        // Anything left on the line, such as more than MAX_STATES pairs, is an error.
+        if(sscanf(text, " %c", &left) == 1) {
+            return 0;
+        }
+        return mmpp->states > 0 && total > 0;
+    }
+
+    if(arrival->process == ARRIVAL_DIURNAL)
+    {
+        return sscanf(text, "%lf %lf", &arrival->amplitude, &arrival->period) == 2 && arrival->amplitude >= 0 &&
+               arrival->amplitude <= 1 && arrival->period > 0;
+    }
+    return 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Parse_Distribution()
+ * Arguments: text - Text starting with a distribution name.
+ *            dist - Structure to return the distribution in.
+ *            used - Returns the number of characters read, if not NULL.
+ * Description: Function to read a distribution name and its parameters from text. Returns 1 if the
+ *              distribution is valid, else 0.
+ * *************************************************************************************************/
+
+static int Parse_Distribution(const char *text, struct Distribution *dist, int *used)
+{
+    char type[32];
+    int length = 0;
+
+    if(sscanf(text, "%31s%n", type, &length) != 1) {
+        return 0;
+    }
+    text += length;
+    dist->b = 0;
+
+    if(strcmp(type, "normal") == 0 || strcmp(type, "uniform") == 0)
+    {
+        int more = 0;
+
+        dist->type = (type[0] == 'n') ? DIST_NORMAL : DIST_UNIFORM;
+        if(sscanf(text, "%lf %lf%n", &dist->a, &dist->b, &more) != 2) {
+            return 0;
+        }
+        length += more;
+        if((dist->type == DIST_NORMAL && dist->b < 0) || (dist->type == DIST_UNIFORM && dist->b < dist->a)) {
+            return 0;
+        }
+    }
+    else if(strcmp(type, "exponential") == 0 || strcmp(type, "constant") == 0)
+    {
+        int more = 0;
+
+        dist->type = (type[0] == 'e') ? DIST_EXPONENTIAL : DIST_CONSTANT;
+        if(sscanf(text, "%lf%n", &dist->a, &more) != 1) {
+            return 0;
+        }
+        length += more;
+        if(dist->type == DIST_EXPONENTIAL && dist->a <= 0) {
+            return 0;
+        }
+    }
+    else {
+        return 0;
+    }
+
+    if(used) {
+        *used = length;
+    }
+    return 1;
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Fill_Distribution()
+ * Arguments: rng - The random number generator.
+ *            dist - The distribution.
+ *            out - Array to return the numbers in.
+ *            n - Number of elements of out.
+ * Description: Function to fill out[] with n random numbers from the distribution.
+ * *************************************************************************************************/
+
+static void Fill_Distribution(struct Rng *rng, const struct Distribution *dist, double *out, int n)
+{
+    int i;
+
+    switch(dist->type)
+    {
+        case DIST_NORMAL:
+            fill_normal(rng, out, n, dist->a, dist->b);
+            break;
+
+        case DIST_UNIFORM:
+            fill_uniform(rng, out, n, dist->a, dist->b);
+            break;
+
+        case DIST_EXPONENTIAL:
+            fill_exponential(rng, out, n, dist->a);
+            break;
+
+        default:
+            for(i = 0; i < n; i++) {
+                out[i] = dist->a;
+            }
+            break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Invert_Distribution()
+ * Arguments: dist - The distribution.
+ *            u - A number in (0, 1).
+ * Description: Function to return the u quantile of the distribution, dist.
+ * *************************************************************************************************/
+
+static double Invert_Distribution(const struct Distribution *dist, double u)
+{
+    switch(dist->type)
+    {
+        case DIST_NORMAL:
+            return dist->a + dist->b * normal_inverse(u);
+
+        case DIST_UNIFORM:
+            return dist->a + (dist->b - dist->a) * u;
+
+        case DIST_EXPONENTIAL:
+            return -dist->a * log1p(-u);
+
+        default:
+            return dist->a;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Distribution_Moments()
+ * Arguments: dist - The distribution.
+ *            mean - Returns the mean.
+ *            m2 - Returns the second moment.
+ * Description: Function to return the mean and the second moment of a distribution. A normal
+ *              distribution is taken as it is, without the cut at 0 of the generated values.
+ * *************************************************************************************************/
+
+static void Distribution_Moments(const struct Distribution *dist, double *mean, double *m2)
+{
+    switch(dist->type)
+    {
+        case DIST_NORMAL:
+            *mean = dist->a;
+            *m2 = dist->a * dist->a + dist->b * dist->b;
+            break;
+
+        case DIST_UNIFORM:
+            *mean = (dist->a + dist->b) / 2;
+            *m2 = (dist->a * dist->a + dist->a * dist->b + dist->b * dist->b) / 3;
+            break;
+
+        case DIST_EXPONENTIAL:
+            *mean = dist->a;
+            *m2 = 2 * dist->a * dist->a;
+            break;
+
+        default:
+            *mean = dist->a;
+            *m2 = dist->a * dist->a;
+            break;
+    }
+}
+
+
+
+/***************************************************************************************************
+ * Function Name: Allocate()
+ * Arguments: size - Number of bytes to allocate.
+ * Description: Function to allocate memory. The program exits with an error message if it cannot be
+ *              allocated.
+ * *************************************************************************************************/
+
+static void *Allocate(size_t size)
+{
+    void *memory = malloc(size > 0 ? size : 1);
+
+    if(!memory)
+    {
+        perror("Error! Cannot allocate memory!");
+        exit(-1);
+    }
+    return memory;
+}
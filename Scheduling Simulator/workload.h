@@ -0,0 +1,96 @@
+/*******************************************************************************************************************************
+ * Workload Specification
+ *
+ * Name: workload.h
+ *
+ * Purpose: Describes a mixture of jobs as K components, each with a job size distribution and a weight, together with the
+ *          way the jobs arrive. A workload is read from a small text file, one item per line:
+ *              # Comment
+ *              jobs 5000                       Number of jobs.
+ *              arrival normal 75 20            Arrival process or distribution of the time between arrivals.
+ *              component normal 250 15 0.2     Job size distribution and weight of one component.
+ *              component normal 50 10 0.8
+ *          The distributions are "normal mean sd", "uniform low high", "exponential mean" and "constant value". The weights
+ *          are relative and do not have to add up to 1.
+ *          Instead of a distribution of the time between arrivals, the arrivals can come from one of the processes in
+ *          arrival.h, with the rate set so the jobs need the given share (utilization) of the CPU's time:
+ *              arrival poisson 0.9                         Poisson process.
+ *              arrival mmpp 0.9 4 500 0.25 2000            MMPP, with the relative rate and mean duration of each state.
+ *              arrival diurnal 0.9 0.5 86400               Daily cycle, with the amplitude and period of the rate.
+ *          Workload_Moments() gives the moments of a workload's jobs for the analytic estimates of queueing.h, without
+ *          generating them.
+ *
+ * Subroutines/libraries required:
+ * 	See include statements.
+ * 	Link the program with the sampling library, libsampling.a, from the Number Generators directory and include the -lm
+ * 	option.
+ *
+*******************************************************************************************************************************/
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include "../Number Generators/rng.h"
+#include "../Number Generators/arrival.h"
+#include "queueing.h"
+
+#define MAX_COMPONENTS 16       // Largest number of components in a mixture.
+#define NO_OF_MIXTURES 3        // Number of built-in mixtures.
+
+// Distribution types.
+#define DIST_NORMAL 0           // a: mean, b: standard deviation.
+#define DIST_UNIFORM 1          // a: low, b: high.
+#define DIST_EXPONENTIAL 2      // a: mean.
+#define DIST_CONSTANT 3         // a: value.
+
+// Arrival processes.
+#define ARRIVAL_GAPS 0          // Time between arrivals drawn from a distribution.
+#define ARRIVAL_POISSON 1       // Poisson process.
+#define ARRIVAL_MMPP 2          // Markov-modulated Poisson process.
+#define ARRIVAL_DIURNAL 3       // Poisson process with a daily cycle.
+
+// Structure contains a distribution and its parameters.
+struct Distribution
+{
+    int type;
+    double a;
+    double b;
+};
+
+// Structure contains one component of a mixture of jobs.
+struct Component
+{
+    struct Distribution size;   // Job size distribution.
+    double weight;              // Relative share of the jobs.
+};
+
+// Structure contains the way jobs arrive.
+struct Arrival
+{
+    int process;
+    struct Distribution gap;    // Distribution of the time between arrivals, for ARRIVAL_GAPS.
+    double utilization;         // Share of the CPU's time needed by the jobs, for the other processes.
+    struct Mmpp mmpp;           // States of the MMPP. The rates are relative and are scaled to the utilization.
+    double amplitude;           // Relative change of the rate over the daily cycle, between 0 and 1.
+    double period;              // Length of the daily cycle.
+};
+
+// Structure contains a mixture of jobs and their arrivals.
+struct Workload
+{
+    int jobs;                   // Number of jobs.
+    int components;             // Number of components in the mixture.
+    struct Component component[MAX_COMPONENTS];
+    struct Arrival arrival;
+};
+
+void Read_Workload(FILE *fin, const char *name, struct Workload *workload);
+void Load_Workload(const char *path, struct Workload *workload);
+void Default_Workload(int mixture, struct Workload *workload);
+void Describe_Workload(FILE *fout, const struct Workload *workload);
+double Mean_Size(const struct Workload *workload);
+void Workload_Moments(const struct Workload *workload, struct Moments *moments);
+void Generate_Jobs(struct Rng *rng, const struct Workload *workload, double *size, double *arrival);
+void Generate_Quasi_Jobs(struct Rng *rng, int scrambled, const struct Workload *workload, double *size, double *arrival);
+
+#endif